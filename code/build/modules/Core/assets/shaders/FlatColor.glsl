@@ -4,8 +4,12 @@
 
 layout(location = 0)in vec3 a_Position;
 
-uniform mat4 u_P;
-uniform mat4 u_V;
+// The beginning of the scene uniform block, whose layout must match Renderer::PackSceneUniforms
+layout(std140) uniform SceneData{
+    mat4 u_P;
+    mat4 u_V;
+};
+
 uniform mat4 u_M;
 
 void main(){
@@ -2,26 +2,81 @@
 
 #version 330 core
 
-layout(location = 0)in vec3 a_Position;
-in vec3 a_Normal;
-in vec2 a_UV;
+layout(location = 0) in vec3 a_Position;
+// Only the first two components are used by octahedral normals of the compact vertex format
+layout(location = 1) in vec3 a_Normal;
+layout(location = 2) in vec2 a_UV;
+
+// Per instance attributes, a matrix occupies one location per column
+layout(location = 3) in mat4 a_M;
+layout(location = 7) in mat4 a_N;
+// Tints the diffuse color, so instances of a material can differ in their color
+layout(location = 11) in vec4 a_Color;
+// The indices of the closest lights reaching the instance in u_Lights, unused entries are -1
+// MAX_LIGHTS and MAX_LIGHTS_PER_OBJECT are defined by the renderer when the shader is compiled
+layout(location = 12) in vec4 a_LightIndices;
 
-uniform mat4 u_P;
-uniform mat4 u_V;
-uniform mat4 u_M;
-uniform mat4 u_N;
+struct PointLight{
+    vec3 Position;
+
+    vec3 Color;
+    float AmbientFactor;
+
+    float Constant;
+    float Linear;
+    float Quadratic;
+};
+
+struct DirectionalLight{
+    bool Exists;
+
+    vec3 Direction;
+
+    vec3 Color;
+    float AmbientFactor;
+};
+
+// Uploaded once per scene by the renderer, the layout must match Renderer::PackSceneUniforms
+layout(std140) uniform SceneData{
+    mat4 u_P;
+    mat4 u_V;
+
+    vec3 u_CameraPosition;
+    int u_LightCount;
+
+    DirectionalLight u_DirectionalLight;
+    PointLight u_Lights[MAX_LIGHTS];
+};
+
+// Set per mesh by the renderer, the positions of compact meshes are already dequantized by a_M
+uniform bool u_OctahedralNormals;
+uniform vec4 u_TexCoordTransform;
 
 out vec3 v_Position;
 out vec3 v_Normal;
 out vec2 v_UV;
+out vec4 v_Color;
+flat out ivec4 v_LightIndices;
+
+// Reverts CompactVertex::EncodeNormal
+vec3 decodeOctahedral(vec2 encoded){
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-normal.z, 0.0);
+    normal.x += normal.x >= 0.0 ? -fold : fold;
+    normal.y += normal.y >= 0.0 ? -fold : fold;
+    return normalize(normal);
+}
 
 void main(){
+    vec3 normal = u_OctahedralNormals ? decodeOctahedral(a_Normal.xy) : a_Normal;
 
-    gl_Position = u_P * u_V * u_M * vec4(a_Position, 1.0);
+    gl_Position = u_P * u_V * a_M * vec4(a_Position, 1.0);
 
-    v_Position = (u_V * u_M * vec4(a_Position, 1.0)).xyz;
-    v_Normal = (u_N * vec4(a_Normal, 1.0)).xyz;
-    v_UV = a_UV;
+    v_Position = (u_V * a_M * vec4(a_Position, 1.0)).xyz;
+    v_Normal = (a_N * vec4(normal, 1.0)).xyz;
+    v_UV = a_UV * u_TexCoordTransform.xy + u_TexCoordTransform.zw;
+    v_Color = a_Color;
+    v_LightIndices = ivec4(a_LightIndices);
 }
 
 
@@ -49,6 +104,18 @@ struct DirectionalLight{
     float AmbientFactor;
 };
 
+// Uploaded once per scene by the renderer, the layout must match Renderer::PackSceneUniforms
+layout(std140) uniform SceneData{
+    mat4 u_P;
+    mat4 u_V;
+
+    vec3 u_CameraPosition;
+    int u_LightCount;
+
+    DirectionalLight u_DirectionalLight;
+    PointLight u_Lights[MAX_LIGHTS];
+};
+
 struct Material{
     bool HasDiffuseTex;
     sampler2D DiffuseTex;
@@ -66,15 +133,11 @@ layout(location = 0) out vec4 color;
 in vec3 v_Position;
 in vec3 v_Normal;
 in vec2 v_UV;
+in vec4 v_Color;
+flat in ivec4 v_LightIndices;
 
 uniform Material u_Material;
 
-uniform vec3 u_CameraPosition;
-
-uniform DirectionalLight u_DirectionalLight;
-uniform PointLight u_Lights[4];
-uniform int u_LightCount;
-
 const vec3 c_AmbientLightColor = vec3(1.0, 1.0, 1.0);
 
 vec3 calcDirectionalLight(DirectionalLight light, vec3 fragNormal, vec3 fragToCamera, vec3 diffuseTexValue, vec3 specularTexValue){
@@ -116,7 +179,7 @@ void main(){
     vec3 fragNormal = normalize(v_Normal);
     vec3 fragToCamera = normalize(u_CameraPosition - v_Position);
 
-    vec3 diffuseTexValue = (u_Material.HasDiffuseTex ? vec3(texture(u_Material.DiffuseTex, v_UV)) : vec3(1.0));
+    vec3 diffuseTexValue = (u_Material.HasDiffuseTex ? vec3(texture(u_Material.DiffuseTex, v_UV)) : vec3(1.0)) * v_Color.rgb;
     vec3 specularTexValue =  (u_Material.HasSpecularTex ? vec3(texture(u_Material.SpecularTex, v_UV)) : vec3(1.0));
 
     // In case a texture has negative values, which cause undefined behaviour and differes per graphics card
@@ -130,8 +193,11 @@ void main(){
 
     vec3 res = u_DirectionalLight.Exists ? calcDirectionalLight(u_DirectionalLight , fragNormal, fragToCamera, diffuseTexValue, specularTexValue) : vec3(0);
 
-    for (int i = 0; i < u_LightCount; ++i){
-        res += calcPointLight(u_Lights[i], fragNormal, fragToCamera, diffuseTexValue, specularTexValue);
+    // Only the lights assigned to this object are evaluated, the renderer sorts them and fills unused entries with -1
+    for (int i = 0; i < MAX_LIGHTS_PER_OBJECT; ++i){
+        if (v_LightIndices[i] < 0)
+            break;
+        res += calcPointLight(u_Lights[v_LightIndices[i]], fragNormal, fragToCamera, diffuseTexValue, specularTexValue);
     }
 
     float gamma = 2.2;
@@ -0,0 +1,109 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include "ECSTestUtils.h"
+#include <ecs/ECSContext.h>
+
+using namespace modulith;
+
+namespace {
+
+    /**
+     * Counts the entities whose NumberData changed since the system's last update
+     */
+    class ChangedCountingSystem : public System {
+    public:
+        explicit ChangedCountingSystem(ref<EntityManager> ecs) : System("Changed Counting System"), _ecs(std::move(ecs)) {}
+
+        void OnUpdate(float deltaTime) override {
+            ChangedCount = 0;
+            _ecs->QueryAll(Each<const NumberData>(), Changed<NumberData>(), [this](auto entity, auto& number) { ++ChangedCount; });
+        }
+
+        int ChangedCount = 0;
+
+    private:
+        ref<EntityManager> _ecs;
+    };
+
+    /**
+     * Increments the NumberData of every entity
+     */
+    class IncrementingSystem : public System {
+    public:
+        explicit IncrementingSystem(ref<EntityManager> ecs) : System("Incrementing System"), _ecs(std::move(ecs)) {}
+
+        void OnUpdate(float deltaTime) override {
+            _ecs->QueryAll(Each<NumberData>(), [](auto entity, auto& number) { number.Number += 1; });
+        }
+
+    private:
+        ref<EntityManager> _ecs;
+    };
+}
+
+SCENARIO("Systems see every write done since their last update as changed", "[ECS]") {
+    GIVEN("An ECS context with entities and a system counting the changed entities, which was updated once") {
+        auto ecsContext = ECSContext();
+        ecsContext.GetComponentManager()->RegisterComponents(ComponentInfo::Create<NumberData>("Tests", "Number"));
+        auto ecs = ecsContext.GetEntityManager();
+        for (int i = 0; i < 3; ++i)
+            ecs->CreateEntityWith(NumberData(i));
+
+        auto counting = ChangedCountingSystem(ecs);
+        ecsContext.UpdateSystem(counting, 0.0f);
+        REQUIRE(counting.ChangedCount == 3);
+
+        WHEN("It is updated again without any writes") {
+            ecsContext.UpdateSystem(counting, 0.0f);
+
+            THEN("nothing has changed") {
+                REQUIRE(counting.ChangedCount == 0);
+            }
+        }
+
+        WHEN("A later system writes to the entities") {
+            auto incrementing = IncrementingSystem(ecs);
+            ecsContext.UpdateSystem(incrementing, 0.0f);
+            ecsContext.UpdateSystem(counting, 0.0f);
+
+            THEN("the writes are seen in the next update") {
+                REQUIRE(counting.ChangedCount == 3);
+            }
+        }
+
+        WHEN("The entities are written to after the last system's update, e.g. by a subcontext") {
+            ecs->QueryAll(Each<NumberData>(), [](auto entity, auto& number) { number.Number += 1; });
+            ecsContext.OnPostUpdate();
+            ecsContext.UpdateSystem(counting, 0.0f);
+
+            THEN("the writes are seen in the next update") {
+                REQUIRE(counting.ChangedCount == 3);
+            }
+
+            AND_WHEN("It is updated once more") {
+                ecsContext.UpdateSystem(counting, 0.0f);
+
+                THEN("the writes are not seen twice") {
+                    REQUIRE(counting.ChangedCount == 0);
+                }
+            }
+        }
+
+        WHEN("An entity is added by a deferred operation after the last system's update") {
+            ecs->QueryAll(Each<const NumberData>(), [&ecs](auto entity, auto& number) {
+                if (number.Number == 0)
+                    ecs->Defer([](auto manager) { manager->CreateEntityWith(NumberData(10)); });
+            });
+            ecsContext.UpdateSystem(counting, 0.0f);
+
+            THEN("the chunk it was added to is seen as changed") {
+                REQUIRE(counting.ChangedCount == 4);
+            }
+        }
+    }
+}
@@ -80,9 +80,13 @@ inline void registerTestingComponentsOn(ComponentManager* componentManager){
     componentManager->RegisterComponents(
         ComponentInfo::Create<SecondSharedResourceData>("Tests", "SecondSharedResource"));
 
-    // Needed because EntityManager.DestroyEntity checks for it
+    // Needed because EntityManager.DestroyEntity checks for them
     componentManager->RegisterComponents(
         ComponentInfo::Create<WithChildrenData>("Tests", "WithChildrenData"));
+    componentManager->RegisterComponents(
+        ComponentInfo::Create<WithParentData>("Tests", "WithParentData"));
+    componentManager->RegisterComponents(
+        ComponentInfo::Create<HierarchyNodeData>("Tests", "HierarchyNodeData"));
 }
 
 inline ComponentManager* CreateComponentManagerPtr(){
@@ -104,3 +108,25 @@ inline EntityManager* CreateEntityManagerPtr(){
 inline ref<EntityManager> CreateEntityManager(){
     return ref(CreateEntityManagerPtr()); // this leaks, but that is fine because these are tests
 }
+
+/**
+ * Creates an entity manager that also knows all components used by the transform systems
+ */
+inline ref<EntityManager> CreateTransformEntityManager(){
+    auto componentManager = CreateComponentManagerPtr();
+    componentManager->RegisterComponents(ComponentInfo::Create<PositionData>("Tests", "Position"));
+    componentManager->RegisterComponents(ComponentInfo::Create<RotationData>("Tests", "Rotation"));
+    componentManager->RegisterComponents(ComponentInfo::Create<ScaleData>("Tests", "Scale"));
+    componentManager->RegisterComponents(ComponentInfo::Create<LocalTransformData>("Tests", "LocalTransform"));
+    componentManager->RegisterComponents(ComponentInfo::Create<GlobalTransformData>("Tests", "GlobalTransform"));
+    componentManager->RegisterComponents(
+        ComponentInfo::Create<InverseGlobalTransformData>("Tests", "InverseGlobalTransform"));
+    componentManager->RegisterComponents(
+        ComponentInfo::Create<DecomposedGlobalTransformData>("Tests", "DecomposedGlobalTransform"));
+    componentManager->RegisterComponents(ComponentInfo::Create<LocalBoundsData>("Tests", "LocalBounds"));
+    componentManager->RegisterComponents(ComponentInfo::Create<WorldBoundsData>("Tests", "WorldBounds"));
+    componentManager->RegisterComponents(ComponentInfo::Create<TransformDirtyData>("Tests", "TransformDirty"));
+    componentManager->RegisterComponents(ComponentInfo::Create<DisabledTag>("Tests", "Disabled"));
+    componentManager->RegisterComponents(ComponentInfo::Create<IndirectlyDisabledTag>("Tests", "IndirectlyDisabled"));
+    return ref(new EntityManager(ref(componentManager))); // this leaks, but that is fine because these are tests
+}
@@ -0,0 +1,121 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include "../ECSTestUtils.h"
+#include <ECS/EntityManager.h>
+
+SCENARIO("The CHANGED constraint only includes chunks that were written to since the system's last update", "[ECS]") {
+    auto manager = CreateEntityManager();
+
+    GIVEN("Entities with NumberData and a system that has never been updated") {
+        const int entityCount = 5;
+        for (auto i = 0; i < entityCount; ++i) {
+            auto e = manager->CreateEntity();
+            manager->AddComponent<NumberData>(e);
+            manager->AddComponent<TestTag>(e);
+        }
+
+        auto lastVersion = manager->BeginSystemUpdate(0);
+
+        WHEN("The changed NumberData is queried") {
+            int calls = 0;
+            manager->QueryAll(
+                Each<NumberData>(), Changed<NumberData>(), [&calls](auto entity, auto& number) { ++calls; }
+            );
+
+            THEN("all entities are included, because their chunk is new") {
+                REQUIRE(calls == entityCount);
+            }
+        }
+
+        WHEN("The system is updated again without any writes in between") {
+            lastVersion = manager->BeginSystemUpdate(lastVersion);
+            auto nextVersion = manager->BeginSystemUpdate(lastVersion);
+
+            int calls = 0;
+            manager->QueryAll(
+                Each<NumberData>(), Changed<NumberData>(), [&calls](auto entity, auto& number) { ++calls; }
+            );
+
+            THEN("no entity is included") {
+                REQUIRE(calls == 0);
+                REQUIRE(nextVersion > lastVersion);
+            }
+        }
+
+        WHEN("Another system writes to the NumberData after the system's last update") {
+            lastVersion = manager->BeginSystemUpdate(lastVersion);
+
+            manager->BeginSystemUpdate(0);
+            manager->QueryAll(Each<NumberData>(), [](auto entity, auto& number) { number.Number = 42; });
+
+            manager->BeginSystemUpdate(lastVersion);
+            int calls = 0;
+            manager->QueryAll(
+                Each<NumberData>(), Changed<NumberData>(), [&calls](auto entity, auto& number) {
+                    REQUIRE(number.Number == 42);
+                    ++calls;
+                }
+            );
+
+            THEN("all entities in the written chunk are included") {
+                REQUIRE(calls == entityCount);
+            }
+        }
+
+        WHEN("Another system only writes to a different component") {
+            lastVersion = manager->BeginSystemUpdate(lastVersion);
+
+            manager->BeginSystemUpdate(0);
+            manager->QueryAll(Each<TestTag>(), [](auto entity, auto& tag) {});
+
+            manager->BeginSystemUpdate(lastVersion);
+            int calls = 0;
+            manager->QueryAll(
+                Each<NumberData>(), Changed<NumberData>(), [&calls](auto entity, auto& number) { ++calls; }
+            );
+
+            THEN("no entity is included") {
+                REQUIRE(calls == 0);
+            }
+        }
+
+        WHEN("A single component is retrieved by another system through GetComponent") {
+            lastVersion = manager->BeginSystemUpdate(lastVersion);
+
+            manager->BeginSystemUpdate(0);
+            manager->GetComponent<NumberData>(Entity(1));
+
+            manager->BeginSystemUpdate(lastVersion);
+            int calls = 0;
+            manager->QueryAll(
+                Each<NumberData>(), Changed<NumberData>(), [&calls](auto entity, auto& number) { ++calls; }
+            );
+
+            THEN("all entities sharing its chunk are included") {
+                REQUIRE(calls == entityCount);
+            }
+        }
+
+        WHEN("A new entity is created in the chunk by another system") {
+            lastVersion = manager->BeginSystemUpdate(lastVersion);
+
+            manager->BeginSystemUpdate(0);
+            manager->CreateEntityWith(NumberData(3), TestTag());
+
+            manager->BeginSystemUpdate(lastVersion);
+            int calls = 0;
+            manager->QueryAll(
+                Each<NumberData>(), Changed<NumberData>(), [&calls](auto entity, auto& number) { ++calls; }
+            );
+
+            THEN("the chunk is considered changed") {
+                REQUIRE(calls == entityCount + 1);
+            }
+        }
+    }
+}
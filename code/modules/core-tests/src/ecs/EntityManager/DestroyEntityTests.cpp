@@ -86,4 +86,39 @@ SCENARIO("Entities can be destroyed") {
             }
         }
     }
-}
\ No newline at end of file
+
+    GIVEN("A parent entity with two children") {
+        auto parent = manager->CreateEntity();
+        auto firstChild = manager->CreateEntityWith(WithParentData(parent));
+        auto secondChild = manager->CreateEntityWith(WithParentData(parent));
+        manager->AddComponent(parent, WithChildrenData{{firstChild, secondChild}});
+
+        WHEN("A child is destroyed") {
+            manager->DestroyEntity(firstChild);
+
+            THEN("it is removed from the children of its parent") {
+                auto* children = manager->GetComponent<const WithChildrenData>(parent);
+                REQUIRE(children->Values.size() == 1);
+                REQUIRE(children->Values[0] == secondChild);
+            }
+
+            AND_WHEN("The other child is destroyed") {
+                manager->DestroyEntity(secondChild);
+
+                THEN("the parent no longer has children") {
+                    REQUIRE_FALSE(manager->HasComponents<WithChildrenData>(parent));
+                }
+            }
+        }
+
+        WHEN("The parent is destroyed and cleanup is performed") {
+            manager->DestroyEntity(parent);
+            manager->OnEndOfFrame();
+
+            THEN("its children are destroyed as well") {
+                REQUIRE_FALSE(manager->IsAlive(firstChild));
+                REQUIRE_FALSE(manager->IsAlive(secondChild));
+            }
+        }
+    }
+}
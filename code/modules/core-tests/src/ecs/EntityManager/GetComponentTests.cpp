@@ -56,3 +56,25 @@ SCENARIO("Modifications made to components using GetComponent are persistent") {
     }
 }
 
+
+SCENARIO("Multiple components can be retrieved at once using GetComponents", "[ECS]") {
+    GIVEN("An entity manager and an entity with two components") {
+        auto manager = CreateEntityManager();
+        manager->CreateEntityWith(NumberData(1), StringData());
+        auto entity = manager->CreateEntityWith(NumberData(50), StringData());
+
+        WHEN("GetComponents is called for attached and non-attached components") {
+            auto[number, tag, name] = manager->GetComponents<NumberData, TestTag, const StringData>(entity);
+
+            THEN("the attached components are the same as retrieved by GetComponent") {
+                REQUIRE(number == manager->GetComponent<NumberData>(entity));
+                REQUIRE(number->Number == 50);
+                REQUIRE(name == manager->GetComponent<const StringData>(entity));
+            }
+
+            THEN("the non-attached component is null") {
+                REQUIRE(tag == nullptr);
+            }
+        }
+    }
+}
@@ -7,6 +7,7 @@
 #include "../ECSTestUtils.h"
 #include <ecs/EntityManager.h>
 #include "ecs/Prefab.h"
+#include <ecs/transform/ParentSystem.h>
 
 SCENARIO("Prefabs can be created by explicitly passing the components of the prefab") {
 
@@ -107,6 +108,67 @@ SCENARIO("Created prefabs can be instantiated to create entities from them") {
     }
 }
 
+SCENARIO("Instances of prefabs are attached to their parent by the parent system") {
+    GIVEN("A parent with a child and a prefab of each of them") {
+        auto componentManager = ref(CreateComponentManagerPtr());
+        auto manager = ref(new EntityManager(componentManager));
+        auto updateHierarchy = [&manager, lastVersion = uint64_t(0)]() mutable {
+            lastVersion = manager->BeginSystemUpdate(lastVersion);
+            ParentSystem::UpdateHierarchy(manager);
+            manager->EndSystemUpdate();
+        };
+
+        auto parent = manager->CreateEntity();
+        auto otherParent = manager->CreateEntity();
+        auto child = manager->CreateEntityWith(WithParentData(parent));
+        updateHierarchy();
+
+        auto childPrefab = Prefab::CreateFromEntity(componentManager, manager, child);
+        auto parentPrefab = Prefab::CreateFromEntity(componentManager, manager, parent);
+
+        THEN("The prefabs do not contain the hierarchy maintained by the parent system") {
+            REQUIRE(childPrefab->Has<WithParentData>());
+            REQUIRE_FALSE(childPrefab->Has<HierarchyNodeData>());
+            REQUIRE_FALSE(parentPrefab->Has<WithChildrenData>());
+        }
+
+        WHEN("The child prefab is instantiated") {
+            auto instance = childPrefab->InstantiateIn(manager);
+            updateHierarchy();
+
+            THEN("The instance is attached to the same parent") {
+                auto* children = manager->GetComponent<const WithChildrenData>(parent);
+                REQUIRE(children->Contains(instance));
+                REQUIRE(children->Contains(child));
+                REQUIRE(manager->GetComponent<const HierarchyNodeData>(instance)->Parent == parent);
+                REQUIRE(manager->GetComponent<const HierarchyNodeData>(instance)->Depth == 1);
+            }
+        }
+
+        WHEN("The child prefab is instantiated and given a different parent") {
+            auto instance = childPrefab->InstantiateIn(manager);
+            manager->GetComponent<WithParentData>(instance)->Value = otherParent;
+            updateHierarchy();
+
+            THEN("The instance is attached to the new parent only") {
+                REQUIRE(manager->GetComponent<const WithChildrenData>(otherParent)->Contains(instance));
+                REQUIRE_FALSE(manager->GetComponent<const WithChildrenData>(parent)->Contains(instance));
+                REQUIRE(manager->GetComponent<const HierarchyNodeData>(instance)->Parent == otherParent);
+            }
+        }
+
+        WHEN("The parent prefab is instantiated") {
+            auto instance = parentPrefab->InstantiateIn(manager);
+            updateHierarchy();
+
+            THEN("The instance does not claim the children of the original") {
+                REQUIRE(manager->GetComponent<const WithChildrenData>(instance) == nullptr);
+                REQUIRE(manager->GetComponent<const HierarchyNodeData>(child)->Parent == parent);
+            }
+        }
+    }
+}
+
 SCENARIO("Prefabs correctly use RAII when dealing with resources") {
     GIVEN("A component manager") {
         auto componentManager = CreateComponentManagerPtr();
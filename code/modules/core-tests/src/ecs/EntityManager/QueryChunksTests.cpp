@@ -0,0 +1,106 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include "../ECSTestUtils.h"
+#include <ECS/EntityManager.h>
+
+SCENARIO("Chunk queries hand out contiguous columns of components", "[ECS]") {
+    auto manager = CreateEntityManager();
+
+    GIVEN("Entities with NumberData in two different chunks") {
+        const int numberCount = 5;
+        const int taggedCount = 3;
+        for (auto i = 0; i < numberCount; ++i)
+            manager->CreateEntityWith(NumberData(i));
+        for (auto i = 0; i < taggedCount; ++i)
+            manager->CreateEntityWith(NumberData(100 + i), TestTag());
+
+        WHEN("The NumberData is queried by chunk") {
+            int chunks = 0;
+            int entities = 0;
+            manager->QueryAllChunks(
+                Each<NumberData>(), [&](const Entity* entityColumn, NumberData* numbers, size_t count) {
+                    ++chunks;
+                    for (size_t i = 0; i < count; ++i) {
+                        REQUIRE(manager->GetComponent<const NumberData>(entityColumn[i]) == numbers + i);
+                        numbers[i].Number *= 2;
+                        ++entities;
+                    }
+                }
+            );
+
+            THEN("the function is called once per chunk with all of its entities") {
+                REQUIRE(chunks == 2);
+                REQUIRE(entities == numberCount + taggedCount);
+            }
+
+            THEN("the components were written in place") {
+                REQUIRE(manager->GetComponent<NumberData>(Entity(1))->Number == 0);
+                REQUIRE(manager->GetComponent<NumberData>(Entity(5))->Number == 8);
+                REQUIRE(manager->GetComponent<NumberData>(Entity(6))->Number == 200);
+            }
+        }
+
+        WHEN("An optional component is queried by chunk") {
+            int withTag = 0;
+            int withoutTag = 0;
+            manager->QueryAllChunks(
+                Each(), Any<const NumberData, TestTag>(), None(),
+                [&](const Entity* entityColumn, const NumberData* numbers, TestTag* tags, size_t count) {
+                    if (tags == nullptr)
+                        withoutTag += count;
+                    else
+                        withTag += count;
+                }
+            );
+
+            THEN("the column is nullptr for chunks that do not contain it") {
+                REQUIRE(withTag == taggedCount);
+                REQUIRE(withoutTag == numberCount);
+            }
+        }
+
+        WHEN("An entity is destroyed") {
+            manager->DestroyEntity(Entity(3));
+            int entities = 0;
+            manager->QueryAllChunks(
+                Each<NumberData>(), None<TestTag>(), [&](const Entity* entityColumn, NumberData* numbers, size_t count) {
+                    for (size_t i = 0; i < count; ++i)
+                        REQUIRE(entityColumn[i] != Entity(3));
+                    entities += count;
+                }
+            );
+
+            THEN("it is excluded from the columns") {
+                REQUIRE(entities == numberCount - 1);
+            }
+        }
+    }
+
+    GIVEN("Entities of a chunk whose order got changed by removing entities") {
+        for (auto i = 1; i <= 4; ++i)
+            manager->CreateEntityWith(NumberData(i), OwnedResourceData(i));
+        manager->RemoveComponent<OwnedResourceData>(Entity(2));
+
+        WHEN("The chunk is queried") {
+            bool consistent = true;
+            manager->QueryAllChunks(
+                Each<const NumberData, const OwnedResourceData>(),
+                [&](const Entity* entityColumn, const NumberData* numbers, const OwnedResourceData* resources, size_t count) {
+                    for (size_t i = 0; i < count; ++i) {
+                        consistent &= entityColumn[i] == Entity(numbers[i].Number);
+                        consistent &= *resources[i].Resource == numbers[i].Number;
+                    }
+                }
+            );
+
+            THEN("the columns of all components are kept in the same order") {
+                REQUIRE(consistent);
+            }
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include "../ECSTestUtils.h"
+#include <ECS/EntityManager.h>
+
+SCENARIO("Const-qualified components are only read and not considered changed", "[ECS]") {
+    auto manager = CreateEntityManager();
+
+    GIVEN("Entities with NumberData and a system that was updated before") {
+        const int entityCount = 5;
+        for (auto i = 0; i < entityCount; ++i)
+            manager->CreateEntityWith(NumberData(i), TestTag());
+
+        auto lastVersion = manager->BeginSystemUpdate(0);
+        lastVersion = manager->BeginSystemUpdate(lastVersion);
+
+        WHEN("Another system queries the NumberData as const") {
+            manager->BeginSystemUpdate(0);
+            int sum = 0;
+            manager->QueryAll(
+                Each<const NumberData>(), [&sum](auto entity, const NumberData& number) { sum += number.Number; }
+            );
+            manager->QueryAll(
+                Each<TestTag>(), Any<const NumberData>(), None(), [](auto entity, auto& tag, const NumberData* number) {}
+            );
+
+            manager->BeginSystemUpdate(lastVersion);
+            int calls = 0;
+            manager->QueryAll(
+                Each<NumberData>(), Changed<NumberData>(), [&calls](auto entity, auto& number) { ++calls; }
+            );
+
+            THEN("the values were read") {
+                REQUIRE(sum == 0 + 1 + 2 + 3 + 4);
+            }
+
+            THEN("the NumberData is not considered changed") {
+                REQUIRE(calls == 0);
+            }
+        }
+
+        WHEN("Another system gets the NumberData of an entity as const") {
+            manager->BeginSystemUpdate(0);
+            const NumberData* number = manager->GetComponent<const NumberData>(Entity(1));
+
+            manager->BeginSystemUpdate(lastVersion);
+            int calls = 0;
+            manager->QueryAll(
+                Each<NumberData>(), Changed<NumberData>(), [&calls](auto entity, auto& number) { ++calls; }
+            );
+
+            THEN("the component is returned") {
+                REQUIRE(number != nullptr);
+                REQUIRE(number->Number == 0);
+            }
+
+            THEN("the NumberData is not considered changed") {
+                REQUIRE(calls == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("The component access of a query distinguishes reads from writes", "[ECS]") {
+    GIVEN("A query that reads NumberData and writes StringData") {
+        auto access = ComponentAccess::Of(Each<const NumberData, StringData>(), Any<const TestTag>());
+
+        THEN("the access contains the read and written components") {
+            REQUIRE(access.Reads.size() == 2);
+            REQUIRE(access.Reads.count(typeid(NumberData)) == 1);
+            REQUIRE(access.Reads.count(typeid(TestTag)) == 1);
+            REQUIRE(access.Writes.size() == 1);
+            REQUIRE(access.Writes.count(typeid(StringData)) == 1);
+        }
+
+        WHEN("It is compared with another query that only reads the same components") {
+            auto other = ComponentAccess::Of(Each<const NumberData, const TestTag>());
+
+            THEN("they do not conflict") {
+                REQUIRE_FALSE(access.ConflictsWith(other));
+                REQUIRE_FALSE(other.ConflictsWith(access));
+            }
+        }
+
+        WHEN("It is compared with another query that writes a component it reads") {
+            auto other = ComponentAccess::Of(Each<NumberData>());
+
+            THEN("they conflict") {
+                REQUIRE(access.ConflictsWith(other));
+                REQUIRE(other.ConflictsWith(access));
+            }
+        }
+
+        WHEN("It is combined with a query that writes a component it reads") {
+            auto combined = access.CombineWith(ComponentAccess::Of(Each<NumberData>()));
+
+            THEN("the component is only contained in the written components") {
+                REQUIRE(combined.Reads.count(typeid(NumberData)) == 0);
+                REQUIRE(combined.Writes.count(typeid(NumberData)) == 1);
+                REQUIRE(combined.Writes.count(typeid(StringData)) == 1);
+            }
+        }
+    }
+}
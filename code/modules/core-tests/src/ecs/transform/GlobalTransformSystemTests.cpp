@@ -0,0 +1,169 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include "../ECSTestUtils.h"
+#include <ECS/transform/ParentSystem.h>
+#include <ECS/transform/GlobalTransformSystem.h>
+
+using namespace modulith;
+
+namespace {
+    /**
+     * Updates the hierarchy and the global transforms the way the ECSContext updates the transform systems
+     */
+    void updateTransforms(ref<EntityManager>& ecs, uint64_t& lastParentVersion, uint64_t& lastGlobalVersion) {
+        lastParentVersion = ecs->BeginSystemUpdate(lastParentVersion);
+        ParentSystem::UpdateHierarchy(ecs);
+        ecs->EndSystemUpdate();
+
+        lastGlobalVersion = ecs->BeginSystemUpdate(lastGlobalVersion);
+        GlobalTransformSystem::UpdateGlobalTransforms(ecs);
+        ecs->EndSystemUpdate();
+    }
+
+    Entity createTranslated(ref<EntityManager>& ecs, float3 translation) {
+        return ecs->CreateEntityWith(LocalTransformData(glm::translate(float4x4(1.0f), translation)), GlobalTransformData());
+    }
+
+    float3 globalPositionOf(ref<EntityManager>& ecs, Entity entity) {
+        auto* globalTransform = ecs->GetComponent<const GlobalTransformData>(entity);
+        REQUIRE(globalTransform != nullptr);
+        return globalTransform->Position();
+    }
+
+    uint32_t depthOf(ref<EntityManager>& ecs, Entity entity) {
+        auto* node = ecs->GetComponent<const HierarchyNodeData>(entity);
+        REQUIRE(node != nullptr);
+        return node->Depth;
+    }
+
+    void setParent(ref<EntityManager>& ecs, Entity child, Entity parent) {
+        if (auto* withParent = ecs->GetComponent<WithParentData>(child))
+            withParent->Value = parent;
+        else
+            ecs->AddComponent(child, WithParentData(parent));
+    }
+}
+
+SCENARIO("Global transforms are propagated from the parents to their children level by level", "[ECS]") {
+    auto ecs = CreateTransformEntityManager();
+    uint64_t lastParentVersion = 0;
+    uint64_t lastGlobalVersion = 0;
+
+    GIVEN("A hierarchy of four levels, whose deepest entities were created first") {
+        auto leaf = createTranslated(ecs, float3(1, 0, 0));
+        auto grandchild = createTranslated(ecs, float3(0, 0, 1));
+        auto child = createTranslated(ecs, float3(0, 1, 0));
+        auto root = createTranslated(ecs, float3(1, 0, 0));
+        setParent(ecs, leaf, grandchild);
+        setParent(ecs, grandchild, child);
+        setParent(ecs, child, root);
+        updateTransforms(ecs, lastParentVersion, lastGlobalVersion);
+
+        THEN("Every entity has the depth of its level") {
+            REQUIRE(ecs->GetComponent<const HierarchyNodeData>(root) == nullptr);
+            REQUIRE(depthOf(ecs, child) == 1);
+            REQUIRE(depthOf(ecs, grandchild) == 2);
+            REQUIRE(depthOf(ecs, leaf) == 3);
+        }
+
+        THEN("Every parent is updated before its children within a single update") {
+            REQUIRE(globalPositionOf(ecs, root) == float3(1, 0, 0));
+            REQUIRE(globalPositionOf(ecs, child) == float3(1, 1, 0));
+            REQUIRE(globalPositionOf(ecs, grandchild) == float3(1, 1, 1));
+            REQUIRE(globalPositionOf(ecs, leaf) == float3(2, 1, 1));
+        }
+
+        WHEN("The root is moved") {
+            ecs->GetComponent<LocalTransformData>(root)->Value = glm::translate(float4x4(1.0f), float3(5, 0, 0));
+            updateTransforms(ecs, lastParentVersion, lastGlobalVersion);
+
+            THEN("The deepest entity follows within a single update") {
+                REQUIRE(globalPositionOf(ecs, leaf) == float3(6, 1, 1));
+            }
+        }
+
+        WHEN("The grandchild is reparented to the root, which is shallower") {
+            setParent(ecs, grandchild, root);
+            updateTransforms(ecs, lastParentVersion, lastGlobalVersion);
+
+            THEN("The depth of the grandchild and its children is recomputed") {
+                REQUIRE(depthOf(ecs, grandchild) == 1);
+                REQUIRE(depthOf(ecs, leaf) == 2);
+            }
+
+            THEN("Their global transforms no longer include the old parent") {
+                REQUIRE(globalPositionOf(ecs, grandchild) == float3(1, 0, 1));
+                REQUIRE(globalPositionOf(ecs, leaf) == float3(2, 0, 1));
+            }
+        }
+
+        WHEN("The child is reparented to the end of another hierarchy, which is deeper") {
+            auto otherRoot = createTranslated(ecs, float3(10, 0, 0));
+            auto otherChild = createTranslated(ecs, float3(0, 10, 0));
+            auto otherGrandchild = createTranslated(ecs, float3(0, 0, 10));
+            setParent(ecs, otherChild, otherRoot);
+            setParent(ecs, otherGrandchild, otherChild);
+            setParent(ecs, child, otherGrandchild);
+            updateTransforms(ecs, lastParentVersion, lastGlobalVersion);
+
+            THEN("The depth of the child and its children is recomputed") {
+                REQUIRE(depthOf(ecs, child) == 3);
+                REQUIRE(depthOf(ecs, grandchild) == 4);
+                REQUIRE(depthOf(ecs, leaf) == 5);
+            }
+
+            THEN("Their global transforms are calculated from the new parent") {
+                REQUIRE(globalPositionOf(ecs, child) == float3(10, 11, 10));
+                REQUIRE(globalPositionOf(ecs, leaf) == float3(11, 11, 11));
+            }
+        }
+
+        WHEN("The child is disabled") {
+            ecs->AddComponent<DisabledTag>(child);
+            updateTransforms(ecs, lastParentVersion, lastGlobalVersion);
+
+            THEN("The child and its whole subtree are disabled in the hierarchy, but not the root") {
+                REQUIRE(ecs->HasComponents<IndirectlyDisabledTag>(child));
+                REQUIRE(ecs->HasComponents<IndirectlyDisabledTag>(grandchild));
+                REQUIRE(ecs->HasComponents<IndirectlyDisabledTag>(leaf));
+                REQUIRE_FALSE(ecs->HasComponents<IndirectlyDisabledTag>(root));
+            }
+
+            AND_WHEN("The root is moved") {
+                ecs->GetComponent<LocalTransformData>(root)->Value = glm::translate(float4x4(1.0f), float3(5, 0, 0));
+                updateTransforms(ecs, lastParentVersion, lastGlobalVersion);
+
+                THEN("The transforms of the disabled subtree are still updated") {
+                    REQUIRE(globalPositionOf(ecs, leaf) == float3(6, 1, 1));
+                }
+            }
+
+            AND_WHEN("The child is enabled again") {
+                ecs->RemoveComponent<DisabledTag>(child);
+                updateTransforms(ecs, lastParentVersion, lastGlobalVersion);
+
+                THEN("The subtree is no longer disabled in the hierarchy") {
+                    REQUIRE_FALSE(ecs->HasComponents<IndirectlyDisabledTag>(child));
+                    REQUIRE_FALSE(ecs->HasComponents<IndirectlyDisabledTag>(grandchild));
+                    REQUIRE_FALSE(ecs->HasComponents<IndirectlyDisabledTag>(leaf));
+                }
+            }
+
+            AND_WHEN("The grandchild is reparented to the enabled root") {
+                setParent(ecs, grandchild, root);
+                updateTransforms(ecs, lastParentVersion, lastGlobalVersion);
+
+                THEN("Only the disabled child stays disabled in the hierarchy") {
+                    REQUIRE(ecs->HasComponents<IndirectlyDisabledTag>(child));
+                    REQUIRE_FALSE(ecs->HasComponents<IndirectlyDisabledTag>(grandchild));
+                    REQUIRE_FALSE(ecs->HasComponents<IndirectlyDisabledTag>(leaf));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <ECS/transform/LocalTransformSystem.h>
+
+using namespace modulith;
+
+namespace {
+    void requireEqual(const float4x4& actual, const float4x4& expected) {
+        for (int column = 0; column < 4; ++column)
+            for (int row = 0; row < 4; ++row)
+                REQUIRE(actual[column][row] == Approx(expected[column][row]).margin(0.0001f));
+    }
+}
+
+SCENARIO("Local transforms are calculated in batches for every combination of transform components", "[ECS]") {
+    GIVEN("The transform components of more entities than fit into a single batch") {
+        const size_t entityCount = 11;
+        auto positions = std::vector<PositionData>();
+        auto rotations = std::vector<RotationData>();
+        auto scales = std::vector<ScaleData>();
+        for (size_t i = 0; i < entityCount; ++i) {
+            positions.emplace_back(1.0f * i, -2.0f * i, 0.5f);
+            rotations.emplace_back(glm::angleAxis(0.3f * i, glm::normalize(float3(1.0f, 2.0f, 0.5f * i))));
+            scales.emplace_back(1.0f + i, 2.0f, 0.5f * (i + 1));
+        }
+
+        WHEN("The local transforms are calculated with and without each of the components") {
+            auto results = std::vector<std::vector<LocalTransformData>>();
+            for (int archetype = 0; archetype < 8; ++archetype) {
+                auto& localTransforms = results.emplace_back(entityCount);
+                LocalTransformSystem::CalculateLocalTransforms(
+                    (archetype & 1) != 0 ? positions.data() : nullptr,
+                    (archetype & 2) != 0 ? rotations.data() : nullptr,
+                    (archetype & 4) != 0 ? scales.data() : nullptr,
+                    localTransforms.data(), entityCount
+                );
+            }
+
+            THEN("every result is equal to translation * rotation * scale") {
+                for (int archetype = 0; archetype < 8; ++archetype) {
+                    for (size_t i = 0; i < entityCount; ++i) {
+                        auto expected = float4x4(1.0f);
+                        if ((archetype & 1) != 0)
+                            expected = glm::translate(expected, positions[i].Value);
+                        if ((archetype & 2) != 0)
+                            expected = expected * glm::mat4_cast(rotations[i].Value);
+                        if ((archetype & 4) != 0)
+                            expected = glm::scale(expected, scales[i].Value);
+
+                        requireEqual(results[archetype][i].Value, expected);
+                    }
+                }
+            }
+        }
+    }
+}
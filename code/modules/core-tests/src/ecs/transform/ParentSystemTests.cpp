@@ -0,0 +1,165 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include "../ECSTestUtils.h"
+#include <ECS/transform/ParentSystem.h>
+
+using namespace modulith;
+
+namespace {
+    /**
+     * Updates the hierarchy the way the ECSContext updates the ParentSystem.
+     * Afterwards, the version is advanced, so the following writes of the test are seen as changes by the next update.
+     */
+    void updateHierarchy(ref<EntityManager>& ecs, uint64_t& lastVersion) {
+        lastVersion = ecs->BeginSystemUpdate(lastVersion);
+        ParentSystem::UpdateHierarchy(ecs);
+        ecs->EndSystemUpdate();
+    }
+
+    uint32_t depthOf(ref<EntityManager>& ecs, Entity entity) {
+        auto* node = ecs->GetComponent<const HierarchyNodeData>(entity);
+        REQUIRE(node != nullptr);
+        return node->Depth;
+    }
+}
+
+SCENARIO("The parent system maintains the hierarchy based on the WithParentData", "[ECS]") {
+    auto ecs = CreateEntityManager();
+    uint64_t lastVersion = 0;
+
+    GIVEN("Two root entities and a child with a parent") {
+        auto parent = ecs->CreateEntity();
+        auto otherParent = ecs->CreateEntity();
+        auto child = ecs->CreateEntity();
+        ecs->AddComponent(child, WithParentData(parent));
+        updateHierarchy(ecs, lastVersion);
+
+        THEN("The child is one of the children of its parent") {
+            auto* children = ecs->GetComponent<const WithChildrenData>(parent);
+            REQUIRE(children != nullptr);
+            REQUIRE(children->Contains(child));
+            REQUIRE(children->Values.size() == 1);
+        }
+
+        THEN("The child knows its parent and depth") {
+            auto* node = ecs->GetComponent<const HierarchyNodeData>(child);
+            REQUIRE(node != nullptr);
+            REQUIRE(node->Parent == parent);
+            REQUIRE(node->Depth == 1);
+        }
+
+        THEN("The roots are not part of the hierarchy below another entity") {
+            REQUIRE(ecs->GetComponent<const HierarchyNodeData>(parent) == nullptr);
+            REQUIRE(ecs->GetComponent<const WithChildrenData>(otherParent) == nullptr);
+        }
+
+        WHEN("The parent of the child is changed") {
+            ecs->GetComponent<WithParentData>(child)->Value = otherParent;
+            updateHierarchy(ecs, lastVersion);
+
+            THEN("The child is moved to the children of the new parent") {
+                auto* children = ecs->GetComponent<const WithChildrenData>(otherParent);
+                REQUIRE(children != nullptr);
+                REQUIRE(children->Contains(child));
+                REQUIRE(ecs->GetComponent<const HierarchyNodeData>(child)->Parent == otherParent);
+            }
+
+            THEN("The old parent no longer has any children") {
+                REQUIRE(ecs->GetComponent<const WithChildrenData>(parent) == nullptr);
+            }
+        }
+
+        WHEN("The WithParentData of the child is removed") {
+            ecs->RemoveComponent<WithParentData>(child);
+            updateHierarchy(ecs, lastVersion);
+
+            THEN("The child is no longer part of the hierarchy") {
+                REQUIRE(ecs->GetComponent<const HierarchyNodeData>(child) == nullptr);
+                REQUIRE(ecs->GetComponent<const WithChildrenData>(parent) == nullptr);
+            }
+        }
+
+        WHEN("The hierarchy is updated again without any changes") {
+            updateHierarchy(ecs, lastVersion);
+
+            THEN("The child is not added to its parent twice") {
+                REQUIRE(ecs->GetComponent<const WithChildrenData>(parent)->Values.size() == 1);
+                REQUIRE(depthOf(ecs, child) == 1);
+            }
+        }
+    }
+
+    GIVEN("A child whose parent is not alive") {
+        auto parent = ecs->CreateEntity();
+        ecs->DestroyEntity(parent);
+        ecs->OnEndOfFrame();
+        REQUIRE_FALSE(ecs->IsAlive(parent));
+
+        auto child = ecs->CreateEntity();
+        ecs->AddComponent(child, WithParentData(parent));
+        updateHierarchy(ecs, lastVersion);
+
+        THEN("The child is not attached") {
+            REQUIRE(ecs->GetComponent<const HierarchyNodeData>(child) == nullptr);
+        }
+
+        WHEN("The child is moved to a parent that is alive") {
+            auto newParent = ecs->CreateEntity();
+            ecs->GetComponent<WithParentData>(child)->Value = newParent;
+            updateHierarchy(ecs, lastVersion);
+
+            THEN("The child is attached to it") {
+                REQUIRE(ecs->GetComponent<const WithChildrenData>(newParent)->Contains(child));
+                REQUIRE(depthOf(ecs, child) == 1);
+            }
+        }
+    }
+
+    GIVEN("A subtree of three levels and another root") {
+        auto root = ecs->CreateEntity();
+        auto otherRoot = ecs->CreateEntity();
+        auto deepParent = ecs->CreateEntity();
+        auto subtreeRoot = ecs->CreateEntity();
+        auto child = ecs->CreateEntity();
+        auto grandchild = ecs->CreateEntity();
+        ecs->AddComponent(deepParent, WithParentData(otherRoot));
+        ecs->AddComponent(subtreeRoot, WithParentData(root));
+        ecs->AddComponent(child, WithParentData(subtreeRoot));
+        ecs->AddComponent(grandchild, WithParentData(child));
+        updateHierarchy(ecs, lastVersion);
+
+        THEN("Every entity is one level below its parent") {
+            REQUIRE(depthOf(ecs, deepParent) == 1);
+            REQUIRE(depthOf(ecs, subtreeRoot) == 1);
+            REQUIRE(depthOf(ecs, child) == 2);
+            REQUIRE(depthOf(ecs, grandchild) == 3);
+        }
+
+        WHEN("The root of the subtree is moved below an entity that is one level deeper") {
+            ecs->GetComponent<WithParentData>(subtreeRoot)->Value = deepParent;
+            updateHierarchy(ecs, lastVersion);
+
+            THEN("The depths of the whole subtree are increased") {
+                REQUIRE(depthOf(ecs, subtreeRoot) == 2);
+                REQUIRE(depthOf(ecs, child) == 3);
+                REQUIRE(depthOf(ecs, grandchild) == 4);
+            }
+        }
+
+        WHEN("The root of the subtree is detached from its parent") {
+            ecs->RemoveComponent<WithParentData>(subtreeRoot);
+            updateHierarchy(ecs, lastVersion);
+
+            THEN("The subtree becomes a hierarchy of its own") {
+                REQUIRE(ecs->GetComponent<const HierarchyNodeData>(subtreeRoot) == nullptr);
+                REQUIRE(depthOf(ecs, child) == 1);
+                REQUIRE(depthOf(ecs, grandchild) == 2);
+            }
+        }
+    }
+}
@@ -0,0 +1,51 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <ECS/transform/TransformComponents.h>
+
+using namespace modulith;
+
+namespace {
+    void requireEqual(const float3& actual, const float3& expected) {
+        for (int i = 0; i < 3; ++i)
+            REQUIRE(actual[i] == Approx(expected[i]).margin(0.0001f));
+    }
+}
+
+SCENARIO("Transform components provide their basis vectors and decomposition", "[ECS]") {
+    GIVEN("A rotation and a global transform built from a position, the rotation and a non-uniform scale") {
+        auto rotation = RotationData(glm::angleAxis(0.7f, glm::normalize(float3(1.0f, 2.0f, -0.5f))));
+        auto position = float3(3.0f, -1.0f, 2.0f);
+        auto scale = float3(2.0f, 0.5f, 4.0f);
+        auto matrix = glm::scale(glm::translate(float4x4(1.0f), position) * glm::mat4_cast(rotation.Value), scale);
+        auto globalTransform = GlobalTransformData(matrix);
+
+        THEN("the basis vectors of the rotation are the columns of its rotation matrix") {
+            auto rotationMatrix = glm::mat4_cast(rotation.Value);
+            requireEqual(rotation.Right(), rotationMatrix[0]);
+            requireEqual(rotation.Up(), rotationMatrix[1]);
+            requireEqual(rotation.Forward(), rotationMatrix[2]);
+        }
+
+        WHEN("The global transform is decomposed") {
+            auto decomposed = DecomposedGlobalTransformData(globalTransform.Value);
+
+            THEN("the position, rotation and scale are restored") {
+                requireEqual(decomposed.Position, position);
+                requireEqual(decomposed.Scale, scale);
+                REQUIRE(std::abs(glm::dot(decomposed.Rotation, rotation.Value)) == Approx(1.0f).margin(0.0001f));
+            }
+
+            THEN("the basis vectors are equal to the ones of the global transform") {
+                requireEqual(decomposed.Right(), globalTransform.Right());
+                requireEqual(decomposed.Up(), globalTransform.Up());
+                requireEqual(decomposed.Forward(), globalTransform.Forward());
+                requireEqual(decomposed.Position, globalTransform.Position());
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include "../ECSTestUtils.h"
+#include <ECS/transform/ParentSystem.h>
+#include <ECS/transform/TransformUtils.h>
+
+using namespace modulith;
+
+namespace {
+    float3 globalPositionOf(ref<EntityManager>& ecs, Entity entity) {
+        auto* globalTransform = ecs->GetComponent<const GlobalTransformData>(entity);
+        REQUIRE(globalTransform != nullptr);
+        return globalTransform->Position();
+    }
+
+    bool isDirty(ref<EntityManager>& ecs, Entity entity) {
+        auto* dirty = ecs->GetComponent<const TransformDirtyData>(entity);
+        return dirty != nullptr && dirty->IsDirty;
+    }
+}
+
+SCENARIO("Only the transforms of entities marked as dirty are updated", "[ECS]") {
+    auto ecs = CreateTransformEntityManager();
+
+    GIVEN("A parent with a child and an unrelated entity, whose transforms are up to date") {
+        auto parent = ecs->CreateEntityWith(PositionData(1, 0, 0), GlobalTransformData());
+        auto child = ecs->CreateEntityWith(PositionData(0, 1, 0), GlobalTransformData(), WithParentData(parent));
+        auto unrelated = ecs->CreateEntityWith(PositionData(0, 0, 1), GlobalTransformData());
+
+        ecs->BeginSystemUpdate(0);
+        ParentSystem::UpdateHierarchy(ecs);
+        ecs->EndSystemUpdate();
+
+        for (auto entity : {parent, child, unrelated})
+            TransformUtils::UpdateTransformOf(ecs, entity);
+        REQUIRE(globalPositionOf(ecs, child) == float3(1, 1, 0));
+
+        WHEN("Both positions are changed, but only the parent is marked as dirty") {
+            ecs->GetComponent<PositionData>(parent)->Value = float3(5, 0, 0);
+            ecs->GetComponent<PositionData>(unrelated)->Value = float3(0, 0, 7);
+            TransformUtils::MarkTransformDirty(ecs, parent);
+            REQUIRE(isDirty(ecs, parent));
+
+            TransformUtils::UpdateDirtyTransforms(ecs);
+
+            THEN("The parent and its child are recomputed") {
+                REQUIRE(globalPositionOf(ecs, parent) == float3(5, 0, 0));
+                REQUIRE(globalPositionOf(ecs, child) == float3(5, 1, 0));
+            }
+
+            THEN("The clean entity is left untouched") {
+                REQUIRE(globalPositionOf(ecs, unrelated) == float3(0, 0, 1));
+                REQUIRE(ecs->GetComponent<const TransformDirtyData>(unrelated) == nullptr);
+            }
+
+            THEN("The parent is no longer dirty") {
+                REQUIRE_FALSE(isDirty(ecs, parent));
+            }
+
+            AND_WHEN("The parent is marked again, but only the child changed") {
+                auto chunk = ecs->GetChunk(parent);
+                ecs->GetComponent<PositionData>(child)->Value = float3(0, 3, 0);
+                TransformUtils::MarkTransformDirty(ecs, parent);
+
+                THEN("The parent stays in its chunk") {
+                    REQUIRE(ecs->GetChunk(parent) == chunk);
+                    REQUIRE(isDirty(ecs, parent));
+                }
+
+                THEN("The local transform of the child is not recomputed, because it was not marked") {
+                    TransformUtils::UpdateDirtyTransforms(ecs);
+                    REQUIRE(globalPositionOf(ecs, child) == float3(5, 1, 0));
+                }
+            }
+        }
+
+        WHEN("The child is marked as dirty while iterating over the entities") {
+            ecs->GetComponent<PositionData>(child)->Value = float3(0, 2, 0);
+            ecs->QueryAll(
+                Each<const WithParentData>(), [&ecs](auto entity, auto& parentData) {
+                    TransformUtils::MarkTransformDirty(ecs, entity);
+                }
+            );
+            TransformUtils::UpdateDirtyTransforms(ecs);
+
+            THEN("Only the child is recomputed") {
+                REQUIRE(globalPositionOf(ecs, child) == float3(1, 2, 0));
+                REQUIRE(ecs->GetComponent<const TransformDirtyData>(parent) == nullptr);
+            }
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include "../ecs/ECSTestUtils.h"
+#include "RendererTestUtils.h"
+#include <renderer/Renderer.h>
+#include <renderer/RenderCommandList.h>
+#include <spatial/Frustum.h>
+#include <ecs/StandardComponents.h>
+
+using namespace modulith;
+
+namespace {
+
+    ref<EntityManager> createRenderedEntityManager() {
+        auto componentManager = CreateComponentManagerPtr();
+        componentManager->RegisterComponents(ComponentInfo::Create<GlobalTransformData>("Tests", "GlobalTransformData"));
+        componentManager->RegisterComponents(ComponentInfo::Create<WorldBoundsData>("Tests", "WorldBoundsData"));
+        // Needed because active queries exclude it
+        componentManager->RegisterComponents(ComponentInfo::Create<IndirectlyDisabledTag>("Tests", "IndirectlyDisabledTag"));
+        return ref(new EntityManager(ref(componentManager))); // this leaks, but that is fine because these are tests
+    }
+
+    void createQuadAt(ref<EntityManager>& ecs, const shared<Mesh>& quad, float3 position) {
+        auto transform = glm::translate(float4x4(1.0f), position);
+        auto entity = ecs->CreateEntity();
+        ecs->AddComponent(entity, GlobalTransformData(transform));
+        ecs->AddComponent(entity, WorldBoundsData(quad->LocalBounds().TransformedBy(transform)));
+    }
+
+    /**
+     * Builds the command list of a camera like the RenderSystem does,
+     * culling the world bounds of every chunk before the visible objects are submitted
+     * @return Returns the amount of culled objects
+     */
+    uint32_t buildCulledCommandList(
+        ref<EntityManager>& ecs, RenderCommandList& commandList, const float4x4& view,
+        const shared<Material>& material, const shared<Mesh>& mesh
+    ) {
+        auto projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+        commandList.Begin(projection, view, float3(0.0f), std::nullopt, {});
+
+        auto culledObjects = uint32_t(0);
+        auto frustum = Frustum(projection * view);
+        auto visible = std::vector<uint8_t>();
+        ecs->QueryActiveChunks(
+            Each<const GlobalTransformData, const WorldBoundsData>(),
+            [&](const Entity* entities, const GlobalTransformData* transforms, const WorldBoundsData* worldBounds, size_t count) {
+                visible.resize(count);
+                culledObjects += (uint32_t) (count - frustum.Cull(worldBounds, count, visible.data()));
+                for (size_t i = 0; i < count; ++i) {
+                    if (visible[i] != 0)
+                        commandList.SubmitDeferred(material, mesh, transforms[i].Value, glm::affineInverse(transforms[i].Value));
+                }
+            }
+        );
+
+        commandList.Finish();
+        return culledObjects;
+    }
+}
+
+SCENARIO("Objects outside of a camera's frustum are culled before they are drawn", "[Renderer]") {
+    GIVEN("Quads in front of, behind and beyond the far plane of a camera at the origin") {
+        auto api = std::make_shared<NullRendererAPI>();
+        auto renderer = Renderer(api);
+        auto quad = CreateQuad(api);
+        auto material = std::make_shared<Material>(CreateTestShader(api, true));
+
+        auto ecs = createRenderedEntityManager();
+        for (int i = 0; i < 5; ++i) {
+            createQuadAt(ecs, quad, float3((float) i - 2.0f, 0.0f, -10.0f));
+            createQuadAt(ecs, quad, float3((float) i - 2.0f, 0.0f, 10.0f));
+            createQuadAt(ecs, quad, float3((float) i - 2.0f, 0.0f, -200.0f));
+        }
+        api->ResetStats();
+
+        WHEN("The camera looks along -z") {
+            auto view = glm::lookAt(float3(0.0f), float3(0.0f, 0.0f, -1.0f), float3(0.0f, 1.0f, 0.0f));
+            auto commandList = RenderCommandList();
+            auto culledObjects = buildCulledCommandList(ecs, commandList, view, material, quad);
+            auto stats = renderer.Execute(commandList);
+
+            THEN("only the quads in front of it are submitted") {
+                REQUIRE(culledObjects == 10);
+                REQUIRE(stats.DeferredSubmits == 5);
+                REQUIRE(stats.ImmediateSubmits == 0);
+            }
+
+            THEN("they are drawn with a single instanced draw call") {
+                REQUIRE(api->GetStats().DrawCalls == 1);
+                REQUIRE(api->GetStats().DrawnInstances == 5);
+                REQUIRE(api->GetStats().DrawnIndices == 5 * 6);
+            }
+        }
+
+        WHEN("The camera looks along +z") {
+            auto view = glm::lookAt(float3(0.0f), float3(0.0f, 0.0f, 1.0f), float3(0.0f, 1.0f, 0.0f));
+            auto commandList = RenderCommandList();
+            auto culledObjects = buildCulledCommandList(ecs, commandList, view, material, quad);
+            auto stats = renderer.Execute(commandList);
+
+            THEN("only the quads behind the origin are drawn") {
+                REQUIRE(culledObjects == 10);
+                REQUIRE(stats.DeferredSubmits == 5);
+                REQUIRE(api->GetStats().DrawnInstances == 5);
+            }
+        }
+
+        WHEN("The camera looks up, away from every quad") {
+            auto view = glm::lookAt(float3(0.0f), float3(0.0f, 1.0f, 0.0f), float3(0.0f, 0.0f, 1.0f));
+            auto commandList = RenderCommandList();
+            auto culledObjects = buildCulledCommandList(ecs, commandList, view, material, quad);
+            auto stats = renderer.Execute(commandList);
+
+            THEN("nothing is submitted or drawn") {
+                REQUIRE(culledObjects == 15);
+                REQUIRE(stats.DeferredSubmits == 0);
+                REQUIRE(api->GetStats().DrawCalls == 0);
+            }
+        }
+    }
+}
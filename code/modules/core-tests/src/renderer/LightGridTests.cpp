@@ -0,0 +1,87 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/LightGrid.h>
+#include <random>
+
+using namespace modulith;
+
+SCENARIO("The light grid assigns the closest lights reaching an object", "[Renderer]") {
+    GIVEN("A row of lamp posts with a range of 5 every 10 units") {
+        auto lights = std::vector<Renderer::PointLight>();
+        for (int i = 0; i < 100; ++i)
+            lights.emplace_back(float3((float) i * 10.0f, 3.0f, 0.0f), float3(1.0f), 5.0f);
+
+        auto grid = LightGrid();
+        grid.Build(lights.data(), lights.size());
+        uint32_t indices[Renderer::MaxLightsPerObject];
+
+        THEN("an object below a lamp post is only lit by it") {
+            auto count = grid.Assign(Bounds(float3(420.0f, 0.5f, 0.0f), float3(0.5f)), indices, Renderer::MaxLightsPerObject);
+            REQUIRE(count == 1);
+            REQUIRE(indices[0] == 42);
+        }
+
+        THEN("an object between two lamp posts is lit by both, the closer one first") {
+            auto count = grid.Assign(Bounds(float3(425.5f, 3.0f, 0.0f), float3(1.0f)), indices, Renderer::MaxLightsPerObject);
+            REQUIRE(count == 2);
+            REQUIRE(indices[0] == 43);
+            REQUIRE(indices[1] == 42);
+        }
+
+        THEN("an object out of the range of every lamp post is not lit") {
+            REQUIRE(grid.Assign(Bounds(float3(420.0f, 3.0f, 20.0f), float3(1.0f)), indices, Renderer::MaxLightsPerObject) == 0);
+        }
+
+        THEN("a long object is lit by the lamp posts closest to its center") {
+            auto count = grid.Assign(Bounds(float3(500.0f, 0.0f, 0.0f), float3(500.0f, 1.0f, 1.0f)), indices, 3);
+            REQUIRE(count == 3);
+            REQUIRE(indices[0] == 50);
+            REQUIRE(((indices[1] == 49 && indices[2] == 51) || (indices[1] == 51 && indices[2] == 49)));
+        }
+    }
+
+    GIVEN("Many lights at random positions with random ranges, a light without a range and a few huge lights") {
+        auto random = std::mt19937(42);
+        auto position = std::uniform_real_distribution<float>(-100.0f, 100.0f);
+        auto range = std::uniform_real_distribution<float>(1.0f, 20.0f);
+
+        auto lights = std::vector<Renderer::PointLight>();
+        lights.emplace_back(float3(1000.0f), float3(1.0f), 0.0f);
+        lights.emplace_back(float3(300.0f, 0.0f, 0.0f), float3(1.0f), 250.0f);
+        lights.emplace_back(float3(0.0f, -400.0f, 0.0f), float3(1.0f), 500.0f);
+        for (int i = 0; i < 300; ++i)
+            lights.emplace_back(float3(position(random), position(random), position(random)), float3(1.0f), range(random));
+
+        auto grid = LightGrid();
+        grid.Build(lights.data(), lights.size());
+
+        THEN("every object gets the same lights as when testing every light") {
+            for (int i = 0; i < 200; ++i) {
+                // Every fourth object is large enough to cover more cells than are occupied
+                auto extents = float3(i % 4 == 0 ? 10.0f * range(random) : range(random));
+                auto bounds = Bounds(float3(position(random), position(random), position(random)), extents);
+
+                auto expected = std::vector<std::pair<float, uint32_t>>();
+                for (uint32_t light = 0; light < lights.size(); ++light) {
+                    auto offset = glm::max(glm::abs(lights[light].Position - bounds.Center) - bounds.Extents, float3(0.0f));
+                    if (lights[light].Range == 0.0f || glm::dot(offset, offset) <= lights[light].Range * lights[light].Range) {
+                        auto toCenter = lights[light].Position - bounds.Center;
+                        expected.emplace_back(glm::dot(toCenter, toCenter), light);
+                    }
+                }
+                std::sort(expected.begin(), expected.end());
+
+                uint32_t indices[Renderer::MaxLightsPerObject];
+                auto count = grid.Assign(bounds, indices, Renderer::MaxLightsPerObject);
+                REQUIRE(count == std::min<size_t>(expected.size(), Renderer::MaxLightsPerObject));
+                for (size_t j = 0; j < count; ++j)
+                    REQUIRE(indices[j] == expected[j].second);
+            }
+        }
+    }
+}
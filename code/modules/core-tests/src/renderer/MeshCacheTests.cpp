@@ -0,0 +1,150 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/MeshCache.h>
+
+using namespace modulith;
+
+namespace {
+
+    CookedModel createModel() {
+        auto model = CookedModel();
+
+        auto submesh = CookedSubmesh();
+        submesh.Vertices = {
+            {float3(0.0f), float3(0.0f, 1.0f, 0.0f), float2(0.0f)},
+            {float3(1.0f, 0.0f, 0.0f), float3(0.0f, 1.0f, 0.0f), float2(1.0f, 0.0f)},
+            {float3(1.0f, 0.0f, 1.0f), float3(0.0f, 1.0f, 0.0f), float2(1.0f)}
+        };
+        submesh.Indices = {0, 1, 2};
+        submesh.MaterialIndex = 1;
+        model.Submeshes.push_back(submesh);
+        model.Submeshes.push_back(CookedSubmesh());
+
+        model.Materials.push_back(CookedMaterial());
+        auto material = CookedMaterial();
+        material.DiffuseColor = float4(1.0f, 0.5f, 0.25f, 1.0f);
+        material.DiffuseTexture = "textures/diffuse.png";
+        model.Materials.push_back(material);
+
+        return model;
+    }
+}
+
+SCENARIO("Imported models are cooked into a binary cache", "[Renderer]") {
+    GIVEN("A cooked model and a cache file") {
+        auto folder = std::filesystem::temp_directory_path() / "modulith-mesh-cache-tests";
+        std::filesystem::remove_all(folder);
+        auto cachePath = folder / "model.mesh";
+        auto model = createModel();
+
+        WHEN("The model is written and read with the same stamp") {
+            REQUIRE(MeshCache::Write(cachePath, 42, model));
+            auto cooked = MeshCache::Read(cachePath, 42);
+
+            THEN("the same submeshes and materials are read") {
+                REQUIRE(cooked.has_value());
+                REQUIRE(cooked->Submeshes.size() == 2);
+                REQUIRE(cooked->Submeshes[0].Vertices.size() == 3);
+                REQUIRE(cooked->Submeshes[0].Vertices[2].Position == float3(1.0f, 0.0f, 1.0f));
+                REQUIRE(cooked->Submeshes[0].Vertices[1].TexCoords == float2(1.0f, 0.0f));
+                REQUIRE(cooked->Submeshes[0].Indices == std::vector<uint32_t>{0, 1, 2});
+                REQUIRE(cooked->Submeshes[0].MaterialIndex == 1);
+                REQUIRE(cooked->Submeshes[1].Vertices.empty());
+
+                REQUIRE(cooked->Materials.size() == 2);
+                REQUIRE(cooked->Materials[0].DiffuseTexture.empty());
+                REQUIRE(cooked->Materials[1].DiffuseColor == float4(1.0f, 0.5f, 0.25f, 1.0f));
+                REQUIRE(cooked->Materials[1].DiffuseTexture == "textures/diffuse.png");
+                REQUIRE(cooked->Materials[1].SpecularTexture.empty());
+            }
+
+            THEN("reading it with the stamp of a changed source fails") {
+                REQUIRE_FALSE(MeshCache::Read(cachePath, 43).has_value());
+            }
+        }
+
+        WHEN("The model is written with a dependency, e.g. a material library") {
+            std::filesystem::create_directories(folder);
+            auto dependencyPath = folder / "model.mtl";
+            std::ofstream(dependencyPath) << "newmtl Stone\n";
+            model.Dependencies.push_back(dependencyPath);
+            REQUIRE(MeshCache::Write(cachePath, 42, model));
+
+            THEN("it is read with its dependency as long as the dependency is unchanged") {
+                auto cooked = MeshCache::Read(cachePath, 42);
+                REQUIRE(cooked.has_value());
+                REQUIRE(cooked->Dependencies.size() == 1);
+                REQUIRE(cooked->Dependencies[0] == dependencyPath.generic_string());
+            }
+
+            THEN("reading it fails after the dependency changed") {
+                std::ofstream(dependencyPath, std::ios::app) << "Kd 0.5 0.5 0.5\n";
+                REQUIRE_FALSE(MeshCache::Read(cachePath, 42).has_value());
+            }
+
+            THEN("reading it fails after the dependency was deleted") {
+                std::filesystem::remove(dependencyPath);
+                REQUIRE_FALSE(MeshCache::Read(cachePath, 42).has_value());
+            }
+        }
+
+        WHEN("The cache file is damaged") {
+            REQUIRE(MeshCache::Write(cachePath, 42, model));
+            std::filesystem::resize_file(cachePath, std::filesystem::file_size(cachePath) - 4);
+
+            THEN("reading it fails") {
+                REQUIRE_FALSE(MeshCache::Read(cachePath, 42).has_value());
+            }
+        }
+
+        WHEN("The cache file does not exist") {
+            THEN("reading it fails") {
+                REQUIRE_FALSE(MeshCache::Read(cachePath, 42).has_value());
+            }
+        }
+
+        std::filesystem::remove_all(folder);
+    }
+
+    GIVEN("A source file") {
+        auto sourcePath = std::filesystem::temp_directory_path() / "modulith-mesh-cache-source.obj";
+        std::ofstream(sourcePath) << "v 0 0 0\n";
+        auto stamp = MeshCache::SourceStamp(sourcePath, 0);
+
+        THEN("its stamp depends on the import key") {
+            REQUIRE(stamp != 0);
+            REQUIRE(MeshCache::SourceStamp(sourcePath, 0) == stamp);
+            REQUIRE(MeshCache::SourceStamp(sourcePath, 1) != stamp);
+        }
+
+        WHEN("The source file is changed") {
+            std::ofstream(sourcePath, std::ios::app) << "v 1 0 0\n";
+
+            THEN("its stamp changes") {
+                REQUIRE(MeshCache::SourceStamp(sourcePath, 0) != stamp);
+            }
+        }
+
+        WHEN("The source file is deleted") {
+            std::filesystem::remove(sourcePath);
+
+            THEN("it has no stamp") {
+                REQUIRE(MeshCache::SourceStamp(sourcePath, 0) == 0);
+            }
+        }
+
+        THEN("its cached version is stored outside of the assets with the name of the source") {
+            auto cachePath = MeshCache::CachePathFor(sourcePath);
+            REQUIRE(cachePath.parent_path() == std::filesystem::current_path() / "cache" / "meshes");
+            REQUIRE(cachePath.filename().string().rfind("modulith-mesh-cache-source-", 0) == 0);
+            REQUIRE(cachePath.extension() == ".mesh");
+        }
+
+        std::filesystem::remove(sourcePath);
+    }
+}
@@ -0,0 +1,184 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/RenderCommandList.h>
+#include <renderer/MeshSimplifier.h>
+#include <renderer/NullRendererAPI.h>
+#include "RendererTestUtils.h"
+
+using namespace modulith;
+
+namespace {
+
+    /**
+     * Creates a flat grid of quads in the xz plane with a size of 1
+     */
+    shared<Mesh> createGrid(const shared<RendererAPI>& api, int resolution, MeshResidency residency) {
+        auto vertices = std::vector<Vertex>();
+        for (int z = 0; z <= resolution; ++z)
+            for (int x = 0; x <= resolution; ++x)
+                vertices.push_back({float3((float) x / resolution, 0.0f, (float) z / resolution), float3(0.0f, 1.0f, 0.0f)});
+
+        auto indices = std::vector<uint32_t>();
+        for (int z = 0; z < resolution; ++z) {
+            for (int x = 0; x < resolution; ++x) {
+                auto corner = (uint32_t) (z * (resolution + 1) + x);
+                auto below = corner + resolution + 1;
+                indices.insert(indices.end(), {corner, below, corner + 1, corner + 1, below, below + 1});
+            }
+        }
+        return std::make_shared<Mesh>(api, vertices, indices, residency);
+    }
+}
+
+SCENARIO("Meshes are simplified into lods, which are drawn when the object is small on the screen", "[Renderer]") {
+    GIVEN("A detailed grid mesh") {
+        auto api = std::make_shared<NullRendererAPI>();
+        auto grid = createGrid(api, 64, MeshResidency::CpuReadable);
+
+        WHEN("Its lods are generated") {
+            grid->GenerateLods(api, 3);
+            auto& lods = grid->GetLods();
+
+            THEN("every lod has fewer triangles and a smaller screen size than the previous one") {
+                REQUIRE(lods.size() == 3);
+                auto previousIndexCount = grid->IndexCount();
+                auto previousScreenSize = 1.0f;
+                for (auto& lod : lods) {
+                    REQUIRE(lod.LodMesh->IndexCount() < previousIndexCount);
+                    REQUIRE(lod.ScreenSize < previousScreenSize);
+                    previousIndexCount = lod.LodMesh->IndexCount();
+                    previousScreenSize = lod.ScreenSize;
+                }
+            }
+
+            THEN("the lods cover the same area as the mesh") {
+                for (auto& lod : lods) {
+                    REQUIRE(lod.LodMesh->LocalBounds().Extents.x == Approx(grid->LocalBounds().Extents.x).epsilon(0.1f));
+                    REQUIRE(lod.LodMesh->LocalBounds().Extents.z == Approx(grid->LocalBounds().Extents.z).epsilon(0.1f));
+                }
+            }
+
+            THEN("the least detailed lod that is still larger than the screen size is selected") {
+                REQUIRE(&grid->SelectLod(1.0f) == grid.get());
+                REQUIRE(&grid->SelectLod(lods[0].ScreenSize * 0.9f) == lods[0].LodMesh.get());
+                REQUIRE(&grid->SelectLod(0.0001f) == lods.back().LodMesh.get());
+            }
+
+            THEN("objects far away from the camera are drawn with a lod") {
+                auto material = std::make_shared<Material>(CreateTestShader(api, true));
+                auto projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 1000.0f);
+                auto commandList = RenderCommandList();
+                commandList.Begin(projection, float4x4(1.0f), float3(0.0f), std::nullopt, {});
+                auto close = glm::translate(float4x4(1.0f), float3(0.0f, 0.0f, -2.0f));
+                auto far = glm::translate(float4x4(1.0f), float3(0.0f, 0.0f, -500.0f));
+                commandList.SubmitDeferred(material, grid, close, glm::affineInverse(close));
+                commandList.SubmitDeferred(material, grid, far, glm::affineInverse(far));
+                commandList.Finish();
+
+                REQUIRE(commandList.GetStats().LodDraws == 1);
+                REQUIRE(commandList.GetStats().Triangles == grid->IndexCount() / 3 + lods.back().LodMesh->IndexCount() / 3);
+                REQUIRE(commandList.GetCommands().size() == 2);
+            }
+        }
+    }
+
+    GIVEN("A triangle smaller than a cell") {
+        auto vertices = std::vector<Vertex>{
+            {float3(0.0f), float3(0.0f, 1.0f, 0.0f)},
+            {float3(0.1f, 0.0f, 0.0f), float3(0.0f, 1.0f, 0.0f)},
+            {float3(0.0f, 0.0f, 0.1f), float3(0.0f, 1.0f, 0.0f)}
+        };
+        auto indices = std::vector<uint32_t>{0, 1, 2};
+
+        WHEN("It is simplified") {
+            auto outVertices = std::vector<Vertex>();
+            auto outIndices = std::vector<uint32_t>();
+            MeshSimplifier::ClusterVertices(vertices, indices, 1.0f, outVertices, outIndices);
+
+            THEN("it collapses and no unused vertices are left") {
+                REQUIRE(outIndices.empty());
+                REQUIRE(outVertices.empty());
+            }
+        }
+    }
+
+    GIVEN("Two quads next to each other, whose shared edge is a UV seam") {
+        auto up = float3(0.0f, 1.0f, 0.0f);
+        auto vertices = std::vector<Vertex>{
+            {float3(0.0f, 0.0f, 0.0f), up, float2(0.0f, 0.0f)},
+            {float3(1.0f, 0.0f, 0.0f), up, float2(1.0f, 0.0f)},
+            {float3(0.0f, 0.0f, 1.0f), up, float2(0.0f, 1.0f)},
+            {float3(1.0f, 0.0f, 1.0f), up, float2(1.0f, 1.0f)},
+            // The same positions as the right edge of the first quad, but with other texture coordinates
+            {float3(1.0f, 0.0f, 0.0f), up, float2(0.0f, 0.0f)},
+            {float3(2.0f, 0.0f, 0.0f), up, float2(1.0f, 0.0f)},
+            {float3(1.0f, 0.0f, 1.0f), up, float2(0.0f, 1.0f)},
+            {float3(2.0f, 0.0f, 1.0f), up, float2(1.0f, 1.0f)}
+        };
+        auto indices = std::vector<uint32_t>{0, 2, 1, 1, 2, 3, 4, 6, 5, 5, 6, 7};
+
+        WHEN("It is simplified with cells smaller than the quads") {
+            auto outVertices = std::vector<Vertex>();
+            auto outIndices = std::vector<uint32_t>();
+            MeshSimplifier::ClusterVertices(vertices, indices, 0.5f, outVertices, outIndices);
+
+            THEN("the vertices on both sides of the seam keep their texture coordinates") {
+                REQUIRE(outIndices.size() == indices.size());
+                REQUIRE(outVertices.size() == vertices.size());
+                for (auto& vertex : outVertices) {
+                    REQUIRE((vertex.TexCoords.x == 0.0f || vertex.TexCoords.x == 1.0f));
+                    REQUIRE((vertex.TexCoords.y == 0.0f || vertex.TexCoords.y == 1.0f));
+                }
+            }
+        }
+
+        WHEN("It is simplified with cells that contain a whole quad") {
+            auto outVertices = std::vector<Vertex>();
+            auto outIndices = std::vector<uint32_t>();
+            MeshSimplifier::ClusterVertices(vertices, indices, 1.5f, outVertices, outIndices);
+
+            THEN("the vertices of both charts in the same cell share their position, so the seam stays closed") {
+                for (auto& a : outVertices)
+                    for (auto& b : outVertices)
+                        if (a.TexCoords != b.TexCoords && glm::distance(a.Position, b.Position) < 0.5f)
+                            REQUIRE(a.Position == b.Position);
+            }
+        }
+    }
+
+    GIVEN("A cube whose faces do not share vertices, but all have the same texture coordinates at the corners") {
+        auto vertices = std::vector<Vertex>();
+        auto indices = std::vector<uint32_t>();
+        for (int axis = 0; axis < 3; ++axis) {
+            for (float side : {0.0f, 1.0f}) {
+                auto base = (uint32_t) vertices.size();
+                for (int corner = 0; corner < 4; ++corner) {
+                    auto position = float3(0.0f);
+                    position[axis] = side;
+                    position[(axis + 1) % 3] = (float) (corner & 1);
+                    position[(axis + 2) % 3] = (float) (corner >> 1);
+                    auto normal = float3(0.0f);
+                    normal[axis] = side * 2.0f - 1.0f;
+                    vertices.push_back({position, normal, float2(0.0f)});
+                }
+                indices.insert(indices.end(), {base, base + 1, base + 2, base + 1, base + 3, base + 2});
+            }
+        }
+
+        WHEN("It is simplified with cells smaller than the cube") {
+            auto outVertices = std::vector<Vertex>();
+            auto outIndices = std::vector<uint32_t>();
+            MeshSimplifier::ClusterVertices(vertices, indices, 0.5f, outVertices, outIndices);
+
+            THEN("the vertices that only differ in their normal are merged") {
+                REQUIRE(outIndices.size() == indices.size());
+                REQUIRE(outVertices.size() == 8);
+            }
+        }
+    }
+}
@@ -0,0 +1,133 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/MeshOptimizer.h>
+#include <random>
+
+using namespace modulith;
+
+namespace {
+
+    /**
+     * Creates a flat grid of quads, whose triangles are shuffled like in a badly exported model
+     */
+    void createShuffledGrid(int resolution, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+        for (int z = 0; z <= resolution; ++z)
+            for (int x = 0; x <= resolution; ++x)
+                vertices.push_back({float3((float) x, 0.0f, (float) z), float3(0.0f, 1.0f, 0.0f)});
+
+        auto triangles = std::vector<std::array<uint32_t, 3>>();
+        for (int z = 0; z < resolution; ++z) {
+            for (int x = 0; x < resolution; ++x) {
+                auto corner = (uint32_t) (z * (resolution + 1) + x);
+                auto below = corner + resolution + 1;
+                triangles.push_back({corner, below, corner + 1});
+                triangles.push_back({corner + 1, below, below + 1});
+            }
+        }
+        std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+
+        for (auto& triangle : triangles)
+            indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+
+    /**
+     * @return Returns the triangles by their vertices, each rotated so it starts with its smallest position
+     */
+    std::vector<std::array<float, 9>> sortedTriangles(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+        auto triangles = std::vector<std::array<float, 9>>();
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            auto first = 0;
+            for (int corner = 1; corner < 3; ++corner) {
+                auto& position = vertices[indices[i + corner]].Position;
+                auto& smallest = vertices[indices[i + first]].Position;
+                if (std::tie(position.x, position.z) < std::tie(smallest.x, smallest.z))
+                    first = corner;
+            }
+
+            auto triangle = std::array<float, 9>();
+            for (int corner = 0; corner < 3; ++corner) {
+                auto& position = vertices[indices[i + (first + corner) % 3]].Position;
+                triangle[3 * corner] = position.x;
+                triangle[3 * corner + 1] = position.y;
+                triangle[3 * corner + 2] = position.z;
+            }
+            triangles.push_back(triangle);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+SCENARIO("Meshes are optimized for the post transform cache and vertex fetches", "[Renderer]") {
+    GIVEN("A grid with shuffled triangles") {
+        auto vertices = std::vector<Vertex>();
+        auto indices = std::vector<uint32_t>();
+        createShuffledGrid(40, vertices, indices);
+        auto originalVertices = vertices;
+        auto originalIndices = indices;
+        auto originalAcmr = MeshOptimizer::CalculateAcmr(indices, vertices.size());
+
+        THEN("its ACMR is close to the worst case") {
+            REQUIRE(originalAcmr > 2.0f);
+        }
+
+        WHEN("Its vertex cache order is optimized") {
+            MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+
+            THEN("far fewer vertices are transformed per triangle") {
+                REQUIRE(MeshOptimizer::CalculateAcmr(indices, vertices.size()) < 0.8f);
+            }
+
+            THEN("the same triangles are drawn with the same winding") {
+                REQUIRE(sortedTriangles(vertices, indices) == sortedTriangles(originalVertices, originalIndices));
+            }
+
+            THEN("optimizing it again from the same input gives the same order") {
+                auto again = originalIndices;
+                MeshOptimizer::OptimizeVertexCache(again, vertices.size());
+                REQUIRE(again == indices);
+            }
+
+            AND_WHEN("Its vertex fetch order is optimized") {
+                auto acmr = MeshOptimizer::CalculateAcmr(indices, vertices.size());
+                MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+
+                THEN("the vertices are used in the order they are stored") {
+                    auto nextVertex = 0u;
+                    for (auto index : indices) {
+                        REQUIRE(index <= nextVertex);
+                        if (index == nextVertex)
+                            nextVertex += 1;
+                    }
+                    REQUIRE(nextVertex == vertices.size());
+                }
+
+                THEN("the triangles and the ACMR are unchanged") {
+                    REQUIRE(sortedTriangles(vertices, indices) == sortedTriangles(originalVertices, originalIndices));
+                    REQUIRE(MeshOptimizer::CalculateAcmr(indices, vertices.size()) == acmr);
+                }
+            }
+
+            AND_WHEN("Its overdraw is optimized") {
+                MeshOptimizer::OptimizeOverdraw(vertices, indices);
+
+                THEN("the same triangles are drawn") {
+                    REQUIRE(sortedTriangles(vertices, indices) == sortedTriangles(originalVertices, originalIndices));
+                }
+            }
+        }
+    }
+
+    GIVEN("Triangles that do not share any vertices") {
+        auto indices = std::vector<uint32_t>{0, 1, 2, 3, 4, 5};
+
+        THEN("every vertex misses the cache") {
+            REQUIRE(MeshOptimizer::CalculateAcmr(indices, 6) == 3.0f);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/Mesh.h>
+#include <renderer/NullRendererAPI.h>
+
+using namespace modulith;
+
+SCENARIO("Meshes only keep their data in main memory if they are CPU readable", "[Renderer]") {
+    GIVEN("The vertices and indices of a quad") {
+        auto api = std::make_shared<NullRendererAPI>();
+        auto vertices = std::vector<Vertex>{
+            {float3(0.0f), float3(0.0f, 1.0f, 0.0f)},
+            {float3(2.0f, 0.0f, 0.0f), float3(0.0f, 1.0f, 0.0f)},
+            {float3(2.0f, 0.0f, 2.0f), float3(0.0f, 1.0f, 0.0f)},
+            {float3(0.0f, 0.0f, 2.0f), float3(0.0f, 1.0f, 0.0f)}
+        };
+        auto indices = std::vector<uint32_t>{0, 1, 2, 0, 2, 3};
+
+        WHEN("A mesh is created from them with the default residency") {
+            auto mesh = Mesh(api, vertices, indices);
+
+            THEN("it is uploaded and keeps its counts and bounds, but not its data") {
+                REQUIRE(api->GetStats().VertexBufferBytes == 4 * sizeof(Vertex));
+                REQUIRE_FALSE(mesh.IsCpuReadable());
+                REQUIRE(mesh.VertexCount() == 4);
+                REQUIRE(mesh.IndexCount() == 6);
+                REQUIRE(mesh.LocalBounds().Center == float3(1.0f, 0.0f, 1.0f));
+            }
+        }
+
+        WHEN("A CPU readable mesh is created from them") {
+            auto mesh = Mesh(api, vertices, indices, MeshResidency::CpuReadable);
+
+            THEN("its data can be read") {
+                REQUIRE(mesh.IsCpuReadable());
+                REQUIRE(mesh.GetVertices().size() == 4);
+                REQUIRE(mesh.GetIndices() == indices);
+            }
+
+            THEN("releasing its data keeps its counts") {
+                mesh.ReleaseCpuData();
+                REQUIRE_FALSE(mesh.IsCpuReadable());
+                REQUIRE(mesh.VertexCount() == 4);
+                REQUIRE(mesh.IndexCount() == 6);
+            }
+        }
+
+        WHEN("A mesh is copied") {
+            auto original = std::make_shared<Mesh>(api, vertices, indices);
+            api->ResetStats();
+            auto copy = Mesh(original);
+
+            THEN("the copy shares the GPU buffers of the original") {
+                REQUIRE(api->GetStats().CreatedVertexArrays == 0);
+                REQUIRE(api->GetStats().VertexBufferBytes == 0);
+                REQUIRE(copy.VertexCount() == original->VertexCount());
+                REQUIRE(copy.IndexCount() == original->IndexCount());
+            }
+        }
+    }
+}
+
+SCENARIO("Meshes can store their vertices in the compact vertex format", "[Renderer]") {
+    GIVEN("The vertices of a quad with tiling tex coords") {
+        auto api = std::make_shared<NullRendererAPI>();
+        auto vertices = std::vector<Vertex>{
+            {float3(-1.0f, 0.0f, 4.0f), float3(0.0f, 1.0f, 0.0f), float2(0.0f, 0.0f)},
+            {float3(3.0f, 0.0f, 4.0f), float3(0.0f, 1.0f, 0.0f), float2(4.0f, 0.0f)},
+            {float3(3.0f, 0.0f, 8.0f), float3(0.0f, 1.0f, 0.0f), float2(4.0f, 4.0f)},
+            {float3(-1.0f, 0.0f, 8.0f), float3(0.0f, 1.0f, 0.0f), float2(0.0f, 4.0f)}
+        };
+        auto indices = std::vector<uint32_t>{0, 1, 2, 0, 2, 3};
+
+        WHEN("A mesh is created from them in the compact vertex format") {
+            auto mesh = Mesh(api, vertices, indices, MeshResidency::GpuOnly, VertexFormat::Compact);
+
+            THEN("its vertex buffer has half the size") {
+                REQUIRE(sizeof(CompactVertex) * 2 == sizeof(Vertex));
+                REQUIRE(api->GetStats().VertexBufferBytes == 4 * sizeof(CompactVertex));
+            }
+
+            THEN("its dequantization maps the corners of the unit cube to its bounds") {
+                auto dequantization = mesh.GetPositionDequantization();
+                auto min = dequantization * float4(-1.0f, -1.0f, -1.0f, 1.0f);
+                auto max = dequantization * float4(1.0f, 1.0f, 1.0f, 1.0f);
+                REQUIRE(min.x == Approx(-1.0f));
+                REQUIRE(min.z == Approx(4.0f));
+                REQUIRE(max.x == Approx(3.0f));
+                REQUIRE(max.z == Approx(8.0f));
+            }
+
+            THEN("its tex coords are scaled back to their range") {
+                REQUIRE(mesh.GetTexCoordTransform() == float4(4.0f, 4.0f, 0.0f, 0.0f));
+            }
+        }
+
+        WHEN("A mesh is created from them in the full vertex format") {
+            auto mesh = Mesh(api, vertices, indices);
+
+            THEN("it needs no dequantization") {
+                REQUIRE(mesh.GetPositionDequantization() == float4x4(1.0f));
+                REQUIRE(mesh.GetTexCoordTransform() == float4(1.0f, 1.0f, 0.0f, 0.0f));
+            }
+        }
+    }
+
+    GIVEN("Normals pointing in every direction") {
+        auto normals = std::vector<float3>{
+            float3(0.0f, 0.0f, 1.0f), float3(0.0f, 0.0f, -1.0f), float3(1.0f, 0.0f, 0.0f), float3(0.0f, -1.0f, 0.0f),
+            glm::normalize(float3(1.0f, 2.0f, -3.0f)), glm::normalize(float3(-0.3f, -0.5f, -0.8f))
+        };
+
+        THEN("they survive the octahedral encoding") {
+            for (auto& normal : normals) {
+                int16_t encoded[2];
+                CompactVertex::EncodeNormal(normal, encoded);
+                auto decoded = CompactVertex::DecodeNormal(encoded);
+                REQUIRE(glm::dot(decoded, normal) > 0.99999f);
+            }
+        }
+    }
+}
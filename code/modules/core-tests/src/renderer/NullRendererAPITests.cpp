@@ -0,0 +1,102 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/Renderer.h>
+#include <renderer/NullRendererAPI.h>
+#include "RendererTestUtils.h"
+
+using namespace modulith;
+
+namespace {
+
+    Renderer::SceneStats renderGrid(Renderer& renderer, const shared<Material>& material, const shared<Mesh>& mesh) {
+        renderer.BeginScene(float4x4(1.0f), float4x4(1.0f), float3(0.0f), std::nullopt, {});
+        for (int x = 0; x < 10; ++x)
+            for (int z = 0; z < 10; ++z)
+                renderer.SubmitDeferred(material, mesh, glm::translate(float4x4(1.0f), float3((float) x, 0.0f, (float) -z)));
+        return renderer.EndScene();
+    }
+}
+
+SCENARIO("Scenes can be rendered without a graphics context by the null renderer API", "[Renderer]") {
+    GIVEN("A renderer with a null renderer API and a quad") {
+        auto api = std::make_shared<NullRendererAPI>();
+        auto renderer = Renderer(api);
+        auto quad = CreateQuad(api);
+
+        THEN("the creation of the quad's buffers was recorded") {
+            auto& stats = api->GetStats();
+            REQUIRE(stats.CreatedVertexArrays == 1);
+            REQUIRE(stats.VertexBufferBytes == 4 * sizeof(Vertex));
+            REQUIRE(stats.IndexBufferBytes == 6 * sizeof(uint32_t));
+        }
+
+        WHEN("A grid of quads with an instanced shader is rendered twice") {
+            auto shader = CreateTestShader(api, true);
+            auto material = std::make_shared<Material>(shader);
+            renderGrid(renderer, material, quad);
+            api->ResetStats();
+            auto stats = renderGrid(renderer, material, quad);
+
+            THEN("every quad is drawn with a single instanced draw call") {
+                auto& apiStats = api->GetStats();
+                REQUIRE(apiStats.DrawCalls == 1);
+                REQUIRE(apiStats.InstancedDrawCalls == 1);
+                REQUIRE(apiStats.DrawnInstances == 100);
+                REQUIRE(apiStats.DrawnIndices == 600);
+            }
+
+            THEN("the instances and scene uniforms are uploaded, but nothing else") {
+                auto& apiStats = api->GetStats();
+                REQUIRE(apiStats.VertexBufferBytes == 100 * (2 * sizeof(float4x4) + 2 * sizeof(float4)));
+                REQUIRE(apiStats.UniformBufferBytes > 0);
+                REQUIRE(apiStats.IndexBufferBytes == 0);
+            }
+
+            THEN("the state of the first scene is still bound in the second one") {
+                REQUIRE(stats.StateChanges.ProgramBinds == 0);
+                REQUIRE(stats.StateChanges.SkippedProgramBinds == 1);
+                REQUIRE(stats.StateChanges.VertexArrayBinds == 0);
+            }
+        }
+
+        WHEN("The same grid is rendered with a shader that is not instanced") {
+            auto shader = CreateTestShader(api, false);
+            renderGrid(renderer, std::make_shared<Material>(shader), quad);
+
+            THEN("every quad is drawn on its own") {
+                REQUIRE(api->GetStats().DrawCalls == 100);
+                REQUIRE(api->GetStats().InstancedDrawCalls == 0);
+                REQUIRE(api->GetStats().DrawnIndices == 600);
+            }
+        }
+    }
+}
+
+SCENARIO("Frame buffers can be created without a graphics context by the null renderer API", "[Renderer]") {
+    GIVEN("A frame buffer of the null renderer API") {
+        auto api = std::make_shared<NullRendererAPI>();
+        auto frameBuffer = api->CreateFrameBuffer(int2(1280, 720));
+
+        THEN("its creation was recorded") {
+            REQUIRE(api->GetStats().CreatedFrameBuffers == 1);
+            REQUIRE(frameBuffer->GetSize() == int2(1280, 720));
+            REQUIRE(frameBuffer->GetColorAttachmentRendererId() != 0);
+        }
+
+        WHEN("It is bound, resized and unbound") {
+            frameBuffer->Bind();
+            frameBuffer->Resize(int2(640, 480));
+            frameBuffer->Unbind();
+            api->SetViewport(int2(1280, 720));
+
+            THEN("it has the new size") {
+                REQUIRE(frameBuffer->GetSize() == int2(640, 480));
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/RenderQueue.h>
+#include <random>
+
+using namespace modulith;
+
+SCENARIO("The render queue sorts draws by their state and depth", "[Renderer]") {
+    GIVEN("Keys that differ in only one of their fields") {
+        auto base = RenderQueue::MakeKey(3, 5, 7, 10.0f);
+
+        THEN("the shader is more significant than the material, vertex array and depth") {
+            REQUIRE(RenderQueue::MakeKey(2, 500, 700, 1000.0f) < base);
+            REQUIRE(RenderQueue::MakeKey(3, 4, 700, 1000.0f) < base);
+            REQUIRE(RenderQueue::MakeKey(3, 5, 6, 1000.0f) < base);
+            REQUIRE(RenderQueue::MakeKey(3, 5, 7, 9.0f) < base);
+        }
+
+        THEN("closer draws are sorted first and negative depths are treated as zero") {
+            REQUIRE(RenderQueue::MakeKey(3, 5, 7, 0.5f) < RenderQueue::MakeKey(3, 5, 7, 0.75f));
+            REQUIRE(RenderQueue::MakeKey(3, 5, 7, -4.0f) == RenderQueue::MakeKey(3, 5, 7, 0.0f));
+        }
+    }
+
+    GIVEN("The sort ids of every kind of object") {
+        WHEN("Many more vertex arrays and materials than shaders fit into a key are created") {
+            auto shaderId = RenderQueue::NextSortId(RenderQueue::SortIdKind::Shader);
+            for (int i = 0; i < 5000; ++i) {
+                RenderQueue::NextSortId(RenderQueue::SortIdKind::VertexArray);
+                RenderQueue::NextSortId(RenderQueue::SortIdKind::Material);
+            }
+
+            THEN("the next shader still gets the next shader id") {
+                REQUIRE(RenderQueue::NextSortId(RenderQueue::SortIdKind::Shader) == shaderId + 1);
+            }
+        }
+
+        WHEN("More ids are taken than fit into the material field") {
+            auto first = RenderQueue::NextSortId(RenderQueue::SortIdKind::Material);
+            for (int i = 0; i < (1 << 14) - 1; ++i)
+                RenderQueue::NextSortId(RenderQueue::SortIdKind::Material);
+
+            THEN("the ids wrap around at the width of the field") {
+                REQUIRE(RenderQueue::NextSortId(RenderQueue::SortIdKind::Material) == first);
+            }
+        }
+    }
+
+    GIVEN("A queue with many draws in random order") {
+        auto queue = RenderQueue();
+        auto random = std::mt19937(42);
+        auto expected = std::vector<RenderQueue::Entry>();
+        for (uint32_t i = 0; i < 1000; ++i) {
+            auto key = RenderQueue::MakeKey(random() % 4, random() % 16, random() % 64, (float) (random() % 100));
+            queue.Push(key, i);
+            expected.push_back({key, i});
+        }
+
+        WHEN("The queue is sorted") {
+            queue.Sort();
+
+            THEN("the draws are in the same order as a stable sort by key") {
+                std::stable_sort(
+                    expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) { return lhs.Key < rhs.Key; }
+                );
+                REQUIRE(queue.Size() == expected.size());
+                for (size_t i = 0; i < expected.size(); ++i) {
+                    REQUIRE(queue.GetEntries()[i].Key == expected[i].Key);
+                    REQUIRE(queue.GetEntries()[i].Payload == expected[i].Payload);
+                }
+            }
+        }
+
+        WHEN("The queue is cleared") {
+            queue.Clear();
+            queue.Sort();
+
+            THEN("it is empty") {
+                REQUIRE(queue.Size() == 0);
+            }
+        }
+    }
+}
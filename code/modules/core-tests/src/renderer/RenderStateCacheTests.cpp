@@ -0,0 +1,81 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/RenderStateCache.h>
+
+using namespace modulith;
+
+SCENARIO("Redundant state changes are skipped by the render state cache", "[Renderer]") {
+    GIVEN("An empty render state cache") {
+        auto cache = RenderStateCache();
+
+        WHEN("The same program, vertex array and texture are bound twice") {
+            auto firstBinds = std::vector<bool>{cache.BindProgram(1), cache.BindVertexArray(2), cache.BindTexture(0, 3)};
+            auto secondBinds = std::vector<bool>{cache.BindProgram(1), cache.BindVertexArray(2), cache.BindTexture(0, 3)};
+
+            THEN("only the first binds are issued") {
+                REQUIRE(firstBinds == std::vector<bool>{true, true, true});
+                REQUIRE(secondBinds == std::vector<bool>{false, false, false});
+
+                auto& counters = cache.GetCounters();
+                REQUIRE(counters.ProgramBinds == 1);
+                REQUIRE(counters.SkippedProgramBinds == 1);
+                REQUIRE(counters.VertexArrayBinds == 1);
+                REQUIRE(counters.SkippedVertexArrayBinds == 1);
+                REQUIRE(counters.TextureBinds == 1);
+                REQUIRE(counters.SkippedTextureBinds == 1);
+            }
+
+            THEN("textures are shadowed per unit") {
+                REQUIRE(cache.BindTexture(1, 3));
+                REQUIRE(cache.BindTexture(0, 4));
+                REQUIRE(cache.BindTexture(0, 3));
+            }
+
+            THEN("everything is bound again after the cache was invalidated") {
+                cache.Invalidate();
+                REQUIRE(cache.BindProgram(1));
+                REQUIRE(cache.BindVertexArray(2));
+                REQUIRE(cache.BindTexture(0, 3));
+            }
+
+            THEN("a deleted texture is no longer bound, even if its id is reused") {
+                cache.ForgetTexture(3);
+                REQUIRE(cache.BindTexture(0, 3));
+            }
+        }
+
+        WHEN("Uniform values are uploaded") {
+            auto color = float4(1.0f, 0.5f, 0.0f, 1.0f);
+            auto first = cache.SetUniform(1, 4, &color, sizeof(color));
+            auto same = cache.SetUniform(1, 4, &color, sizeof(color));
+            auto otherProgram = cache.SetUniform(2, 4, &color, sizeof(color));
+            color.y = 0.25f;
+            auto changed = cache.SetUniform(1, 4, &color, sizeof(color));
+
+            THEN("only changed values are uploaded to a program") {
+                REQUIRE(first);
+                REQUIRE_FALSE(same);
+                REQUIRE(otherProgram);
+                REQUIRE(changed);
+                REQUIRE(cache.GetCounters().UniformUploads == 3);
+                REQUIRE(cache.GetCounters().SkippedUniformUploads == 1);
+            }
+
+            THEN("uniforms the program does not use are never uploaded") {
+                REQUIRE_FALSE(cache.SetUniform(1, -1, &color, sizeof(color)));
+            }
+
+            THEN("the values are kept when the bindings are invalidated, but not when the program is deleted") {
+                cache.Invalidate();
+                REQUIRE_FALSE(cache.SetUniform(1, 4, &color, sizeof(color)));
+                cache.ForgetProgram(1);
+                REQUIRE(cache.SetUniform(1, 4, &color, sizeof(color)));
+            }
+        }
+    }
+}
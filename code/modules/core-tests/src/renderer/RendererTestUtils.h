@@ -0,0 +1,34 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+# pragma once
+
+#include "Core.h"
+#include <renderer/Mesh.h>
+#include <renderer/NullRendererAPI.h>
+
+using namespace modulith;
+
+/**
+ * @return Returns a quad of size 1 on the xz plane, with its first corner at the origin
+ */
+inline shared<Mesh> CreateQuad(const shared<RendererAPI>& api) {
+    auto vertices = std::vector<Vertex>{
+        {float3(0.0f), float3(0.0f, 1.0f, 0.0f)},
+        {float3(1.0f, 0.0f, 0.0f), float3(0.0f, 1.0f, 0.0f)},
+        {float3(1.0f, 0.0f, 1.0f), float3(0.0f, 1.0f, 0.0f)},
+        {float3(0.0f, 0.0f, 1.0f), float3(0.0f, 1.0f, 0.0f)}
+    };
+    return std::make_shared<Mesh>(api, vertices, std::vector<uint32_t>{0, 1, 2, 0, 2, 3});
+}
+
+/**
+ * @return Returns a shader of the null renderer API, which reads its per instance data from vertex attributes if it is instanced
+ */
+inline shared<Shader> CreateTestShader(const shared<NullRendererAPI>& api, bool isInstanced) {
+    return isInstanced
+        ? api->CreateShader("Instanced", "layout(location = 3) in mat4 a_M;", "")
+        : api->CreateShader("NotInstanced", "in vec3 a_Position;", "");
+}
@@ -0,0 +1,168 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/Renderer.h>
+#include <renderer/MaterialInstance.h>
+#include <renderer/RenderCommandList.h>
+#include "RendererTestUtils.h"
+
+using namespace modulith;
+
+namespace {
+
+    Renderer::SceneStats submitScene(
+        Renderer& renderer, const shared<Material>& material, const shared<Mesh>& first, const shared<Mesh>& second
+    ) {
+        renderer.BeginScene(float4x4(1.0f), float4x4(1.0f), float3(0.0f), std::nullopt, {});
+        // Submitted interleaved, the renderer has to group them
+        for (int i = 0; i < 3; ++i) {
+            auto transform = glm::translate(float4x4(1.0f), float3((float) i, 0.0f, -5.0f));
+            renderer.SubmitDeferred(material, first, transform);
+            if (i < 2)
+                renderer.SubmitDeferred(material, second, transform);
+        }
+        return renderer.EndScene();
+    }
+}
+
+SCENARIO("Deferred draws are batched by their material and vertex array", "[Renderer]") {
+    GIVEN("A renderer with a null renderer API and two meshes") {
+        auto api = std::make_shared<NullRendererAPI>();
+        auto renderer = Renderer(api);
+        auto first = CreateQuad(api);
+        auto second = CreateQuad(api);
+        api->ResetStats();
+
+        WHEN("Both meshes are submitted multiple times with an instanced material") {
+            auto material = std::make_shared<Material>(CreateTestShader(api, true));
+            auto stats = submitScene(renderer, material, first, second);
+
+            THEN("every mesh is drawn with a single instanced draw call") {
+                REQUIRE(api->GetStats().DrawCalls == 2);
+                REQUIRE(api->GetStats().InstancedDrawCalls == 2);
+                REQUIRE(api->GetStats().DrawnInstances == 5);
+                REQUIRE(stats.BatchedDrawCalls == 2);
+                REQUIRE(stats.InstancedDrawCalls == 2);
+                REQUIRE(stats.MaterialBatches == 1);
+                REQUIRE(stats.VertexArrayBatches == 2);
+            }
+
+            THEN("the instances of each batch are uploaded to one shared instance buffer") {
+                REQUIRE(api->GetStats().CreatedVertexBuffers == 1);
+                // A model matrix, a normal matrix, a color and the light indices per instance
+                auto instanceSize = 2 * sizeof(float4x4) + 2 * sizeof(float4);
+                REQUIRE(api->GetStats().VertexBufferBytes == 5 * instanceSize);
+            }
+        }
+
+        WHEN("Both meshes are submitted multiple times with a material that is not instanced") {
+            auto material = std::make_shared<Material>(CreateTestShader(api, false));
+            auto stats = submitScene(renderer, material, first, second);
+
+            THEN("every submit is drawn on its own, but the vertex arrays are only bound once") {
+                REQUIRE(api->GetStats().DrawCalls == 5);
+                REQUIRE(api->GetStats().InstancedDrawCalls == 0);
+                REQUIRE(stats.StateChanges.VertexArrayBinds == 2);
+                REQUIRE(stats.BatchedDrawCalls == 5);
+                REQUIRE(stats.VertexArrayBatches == 2);
+            }
+        }
+
+        WHEN("Both meshes are submitted with different instances of the same material") {
+            auto baseMaterial = std::make_shared<Material>(CreateTestShader(api, true));
+            auto red = std::make_shared<MaterialInstance>(baseMaterial, float4(1.0f, 0.0f, 0.0f, 1.0f));
+            auto blue = std::make_shared<MaterialInstance>(baseMaterial, float4(0.0f, 0.0f, 1.0f, 1.0f));
+
+            renderer.BeginScene(float4x4(1.0f), float4x4(1.0f), float3(0.0f), std::nullopt, {});
+            for (int i = 0; i < 4; ++i) {
+                auto transform = glm::translate(float4x4(1.0f), float3((float) i, 0.0f, -5.0f));
+                renderer.SubmitDeferred(i % 2 == 0 ? red : blue, first, transform);
+                renderer.SubmitDeferred(i % 2 == 0 ? blue : red, second, transform);
+            }
+            auto stats = renderer.EndScene();
+
+            THEN("they are drawn as instances of the base material") {
+                REQUIRE(stats.MaterialBatches == 1);
+                REQUIRE(api->GetStats().DrawCalls == 2);
+                REQUIRE(api->GetStats().InstancedDrawCalls == 2);
+                REQUIRE(api->GetStats().DrawnInstances == 8);
+            }
+
+            THEN("the instances keep their own color") {
+                REQUIRE(red->GetInstanceColor() == float4(1.0f, 0.0f, 0.0f, 1.0f));
+                REQUIRE(&red->GetBaseMaterial() == baseMaterial.get());
+            }
+        }
+
+        WHEN("A command list is built with deferred and immediate draws") {
+            auto material = std::make_shared<Material>(CreateTestShader(api, true));
+            auto commandList = RenderCommandList();
+            commandList.Begin(float4x4(1.0f), float4x4(1.0f), float3(0.0f), std::nullopt, {});
+            for (int i = 0; i < 3; ++i) {
+                auto transform = glm::translate(float4x4(1.0f), float3((float) i, 0.0f, -5.0f));
+                commandList.SubmitDeferred(material, first, transform, glm::affineInverse(transform));
+            }
+            commandList.SubmitImmediately(material, second, float4x4(1.0f));
+            commandList.Finish();
+
+            THEN("nothing is drawn while building it") {
+                REQUIRE(api->GetStats().DrawCalls == 0);
+            }
+
+            THEN("the immediate draw comes first and the deferred draws form a single batch") {
+                const auto& commands = commandList.GetCommands();
+                REQUIRE(commands.size() == 2);
+                REQUIRE(commands[0].DrawMesh == second.get());
+                REQUIRE(commands[0].InstanceCount == 1);
+                REQUIRE(commands[1].DrawMesh == first.get());
+                REQUIRE(commands[1].FirstInstance == 1);
+                REQUIRE(commands[1].InstanceCount == 3);
+                REQUIRE(commandList.GetInstances().size() == 4);
+            }
+
+            THEN("executing it draws every command") {
+                auto stats = renderer.Execute(commandList);
+                REQUIRE(api->GetStats().DrawCalls == 2);
+                REQUIRE(api->GetStats().DrawnInstances == 4);
+                REQUIRE(stats.StateChanges.VertexArrayBinds == 2);
+                REQUIRE(stats.ImmediateSubmits == 1);
+                REQUIRE(stats.DeferredSubmits == 3);
+                REQUIRE(stats.InstancedDrawCalls == 2);
+            }
+        }
+
+        WHEN("A command list is built for a scene with more lights than an object can be lit by") {
+            auto material = std::make_shared<Material>(CreateTestShader(api, true));
+            auto lights = std::vector<Renderer::PointLight>();
+            for (int i = 0; i < 6; ++i)
+                lights.emplace_back(float3((float) i * 2.0f, 0.0f, -5.0f), float3(1.0f), 3.0f);
+            lights.emplace_back(float3(100.0f), float3(1.0f), 3.0f);
+
+            auto commandList = RenderCommandList();
+            commandList.Begin(float4x4(1.0f), float4x4(1.0f), float3(0.0f), std::nullopt, lights);
+            commandList.SubmitImmediately(material, first, glm::translate(float4x4(1.0f), float3(0.0f, 0.0f, -5.0f)));
+            commandList.SubmitImmediately(material, first, glm::translate(float4x4(1.0f), float3(0.0f, 0.0f, 50.0f)));
+            commandList.Finish();
+
+            THEN("every light is part of the scene uniforms") {
+                REQUIRE(*reinterpret_cast<const int32_t*>(commandList.GetSceneUniforms().GetData() + 140) == 7);
+            }
+
+            THEN("an object is lit by the closest lights reaching it") {
+                auto& lightIndices = commandList.GetInstances()[0].LightIndices;
+                REQUIRE(lightIndices.x == 0.0f);
+                REQUIRE(lightIndices.y == 1.0f);
+                REQUIRE(lightIndices.z == 2.0f);
+                REQUIRE(lightIndices.w == -1.0f);
+            }
+
+            THEN("an object out of the range of every light is not lit") {
+                REQUIRE(commandList.GetInstances()[1].LightIndices == float4(-1.0f));
+            }
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/Renderer.h>
+#include <cstring>
+
+using namespace modulith;
+
+namespace {
+    template<class T>
+    T readAt(const Std140Writer& writer, size_t offset) {
+        T value;
+        std::memcpy(&value, writer.GetData() + offset, sizeof(T));
+        return value;
+    }
+}
+
+SCENARIO("Values are packed following the std140 layout rules", "[Renderer]") {
+    GIVEN("A std140 writer") {
+        auto writer = Std140Writer();
+
+        WHEN("Values of different alignments are written") {
+            auto scalarOffset = writer.Write(1.0f);
+            auto vec3Offset = writer.Write(float3(2.0f, 3.0f, 4.0f));
+            auto packedScalarOffset = writer.Write((int32_t) 5);
+            auto vec2Offset = writer.Write(float2(6.0f, 7.0f));
+            writer.BeginStruct();
+            auto structBoolOffset = writer.Write(true);
+            writer.EndStruct();
+            auto matrixOffset = writer.Write(float4x4(1.0f));
+
+            THEN("every value is aligned to its base alignment") {
+                REQUIRE(scalarOffset == 0);
+                REQUIRE(vec3Offset == 16);
+                REQUIRE(packedScalarOffset == 28);
+                REQUIRE(vec2Offset == 32);
+                REQUIRE(structBoolOffset == 48);
+                REQUIRE(matrixOffset == 64);
+                REQUIRE(writer.GetSize() == 128);
+            }
+
+            THEN("the values are stored at their offsets") {
+                REQUIRE(readAt<float>(writer, vec3Offset + 8) == 4.0f);
+                REQUIRE(readAt<int32_t>(writer, packedScalarOffset) == 5);
+                REQUIRE(readAt<int32_t>(writer, structBoolOffset) == 1);
+                REQUIRE(readAt<float>(writer, matrixOffset + 5 * sizeof(float)) == 1.0f);
+                REQUIRE(readAt<float>(writer, matrixOffset + 6 * sizeof(float)) == 0.0f);
+            }
+        }
+    }
+
+    GIVEN("The camera and lights of a scene") {
+        auto projection = float4x4(2.0f);
+        auto view = float4x4(1.0f);
+        auto directionalLight = Renderer::DirectionalLight(float3(0.0f, -1.0f, 0.0f), float3(1.0f, 0.5f, 0.25f), 0.1f);
+        Renderer::PointLight lights[] = {
+            Renderer::PointLight(float3(1.0f, 2.0f, 3.0f), float3(1.0f), 10.0f),
+            Renderer::PointLight(float3(4.0f, 5.0f, 6.0f), float3(0.5f), 5.0f)
+        };
+
+        WHEN("They are packed into the scene uniform block") {
+            auto writer = Std140Writer();
+            Renderer::PackSceneUniforms(writer, projection, view, directionalLight, lights, 2);
+
+            THEN("the data is found at the std140 offsets of the block's members") {
+                REQUIRE(writer.GetSize() == 192 + Renderer::MaxLights * 48);
+
+                REQUIRE(readAt<float>(writer, 0) == 2.0f);
+                REQUIRE(readAt<float>(writer, 64) == 1.0f);
+                REQUIRE(readAt<int32_t>(writer, 140) == 2);
+
+                REQUIRE(readAt<int32_t>(writer, 144) == 1);
+                REQUIRE(readAt<float>(writer, 164) == -1.0f);
+                REQUIRE(readAt<float>(writer, 180) == 0.5f);
+                REQUIRE(readAt<float>(writer, 188) == Approx(0.1f));
+
+                // u_Lights[1] starts at 192 + 48
+                REQUIRE(readAt<float>(writer, 240 + 8) == 6.0f);
+                REQUIRE(readAt<float>(writer, 240 + 16) == 0.5f);
+                REQUIRE(readAt<float>(writer, 240 + 32) == 1.0f);
+                REQUIRE(readAt<float>(writer, 240 + 40) == Approx(10.0f / 25.0f));
+
+                // Unused lights are zeroed
+                REQUIRE(readAt<float>(writer, 288 + 40) == 0.0f);
+            }
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <renderer/primitives/Shader.h>
+#include <renderer/NullRendererAPI.h>
+
+using namespace modulith;
+
+SCENARIO("Uniform ids are shared by all uniforms with the same name", "[Renderer]") {
+    GIVEN("Ids created from the same and from different names") {
+        auto color = UniformId("u_UniformIdTestsColor");
+        auto sameColor = UniformId(std::string("u_UniformIdTests") + "Color");
+        auto matrix = UniformId("u_UniformIdTestsMatrix");
+
+        THEN("ids of the same name are equal") {
+            REQUIRE(color == sameColor);
+            REQUIRE(color.GetIndex() == sameColor.GetIndex());
+        }
+
+        THEN("ids of different names are distinct") {
+            REQUIRE_FALSE(color == matrix);
+            REQUIRE(color.GetIndex() != matrix.GetIndex());
+        }
+
+        THEN("every id knows its name") {
+            REQUIRE(color.GetName() == "u_UniformIdTestsColor");
+            REQUIRE(matrix.GetName() == "u_UniformIdTestsMatrix");
+        }
+    }
+}
+
+SCENARIO("Only uniforms declared by a shader are uploaded", "[Renderer]") {
+    GIVEN("A bound shader of the null renderer API declaring a color and an array of offsets") {
+        auto api = std::make_shared<NullRendererAPI>();
+        auto shader = api->CreateShader(
+            "Uniforms",
+            "uniform SceneData { mat4 u_ViewProjection; };\nuniform vec4 u_Color;\nuniform float u_Offsets[3];",
+            "uniform sampler2D u_Texture;"
+        );
+        shader->Bind();
+        api->ResetStateCounters();
+
+        WHEN("A declared uniform is uploaded by its name and by its id") {
+            shader->UploadUniformFloat4("u_Color", float4(1.0f));
+            shader->UploadUniformFloat4(UniformId("u_Color"), float4(0.5f));
+
+            THEN("both values are uploaded") {
+                REQUIRE(api->GetStats().UniformBytes == 2 * sizeof(float4));
+                REQUIRE(api->GetStateCounters().UniformUploads == 2);
+            }
+        }
+
+        WHEN("Elements of a declared array and a uniform of the fragment source are uploaded") {
+            shader->UploadUniformFloat1("u_Offsets[2]", 1.0f);
+            shader->UploadUniformFloat1(UniformId("u_Offsets"), 2.0f);
+            shader->UploadUniformInt1("u_Texture", 0);
+
+            THEN("they are uploaded") {
+                REQUIRE(api->GetStateCounters().UniformUploads == 3);
+            }
+        }
+
+        WHEN("Uniforms the shader does not declare are uploaded") {
+            shader->UploadUniformFloat4("u_Missing", float4(1.0f));
+            shader->UploadUniformFloat4(UniformId("u_Missing"), float4(1.0f));
+            shader->UploadUniformFloat1("u_Offsets[3]", 1.0f);
+            shader->UploadUniformMat4("u_ViewProjection", float4x4(1.0f));
+
+            THEN("nothing is uploaded or counted") {
+                REQUIRE(api->GetStats().UniformBytes == 0);
+                REQUIRE(api->GetStateCounters().UniformUploads == 0);
+                REQUIRE(api->GetStateCounters().SkippedUniformUploads == 0);
+            }
+        }
+    }
+}
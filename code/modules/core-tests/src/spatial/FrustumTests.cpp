@@ -0,0 +1,64 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <spatial/Frustum.h>
+
+using namespace modulith;
+
+SCENARIO("Bounds outside of a camera's frustum are culled", "[Spatial]") {
+    GIVEN("The frustum of a camera at the origin looking along -z and bounds around it") {
+        auto view = glm::lookAt(float3(0.0f), float3(0.0f, 0.0f, -1.0f), float3(0.0f, 1.0f, 0.0f));
+        auto projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+        auto frustum = Frustum(projection * view);
+
+        auto bounds = std::vector<WorldBoundsData>{
+            WorldBoundsData(Bounds(float3(0.0f, 0.0f, -10.0f), float3(1.0f))),   // in front
+            WorldBoundsData(Bounds(float3(0.0f, 0.0f, 10.0f), float3(1.0f))),    // behind
+            WorldBoundsData(Bounds(float3(-50.0f, 0.0f, -10.0f), float3(1.0f))), // left of the view
+            WorldBoundsData(Bounds(float3(0.0f, 50.0f, -10.0f), float3(1.0f))),  // above the view
+            WorldBoundsData(Bounds(float3(0.0f, 0.0f, -200.0f), float3(1.0f))),  // beyond the far plane
+            WorldBoundsData(Bounds(float3(0.0f), float3(1.0f))),                 // containing the camera
+            WorldBoundsData(Bounds(float3(-11.5f, 0.0f, -10.0f), float3(2.0f))), // partially inside on the left
+            WorldBoundsData(Bounds(float3(0.0f), float3(500.0f))),               // containing the whole frustum
+            WorldBoundsData(Bounds(float3(5.0f, -5.0f, -50.0f), float3(0.1f))),  // small and far, but inside
+        };
+        auto expected = std::vector<uint8_t>{1, 0, 0, 0, 0, 1, 1, 1, 1};
+
+        WHEN("The bounds are culled at once") {
+            auto visible = std::vector<uint8_t>(bounds.size(), 2);
+            auto visibleCount = frustum.Cull(bounds.data(), bounds.size(), visible.data());
+
+            THEN("only the bounds intersecting the frustum are visible") {
+                REQUIRE(visible == expected);
+                REQUIRE(visibleCount == 5);
+            }
+
+            THEN("the result is the same as testing every bounds on its own") {
+                for (size_t i = 0; i < bounds.size(); ++i)
+                    REQUIRE(frustum.Intersects(bounds[i].Value) == (visible[i] != 0));
+            }
+        }
+    }
+
+    GIVEN("Bounds of an object that is rotated by 45 degrees and translated") {
+        auto local = Bounds::FromPoints(std::vector<float3>{float3(-1.0f, -2.0f, -1.0f), float3(1.0f, 2.0f, 1.0f)}.data(), 2);
+        auto transform = glm::rotate(glm::translate(float4x4(1.0f), float3(3.0f, 0.0f, 0.0f)), glm::radians(45.0f), float3(0, 0, 1));
+
+        WHEN("They are transformed into world space") {
+            auto world = local.TransformedBy(transform);
+
+            THEN("they contain the rotated box") {
+                auto halfDiagonal = (1.0f + 2.0f) * std::sqrt(0.5f);
+                REQUIRE(world.Center.x == Approx(3.0f));
+                REQUIRE(world.Center.y == Approx(0.0f).margin(0.0001f));
+                REQUIRE(world.Extents.x == Approx(halfDiagonal));
+                REQUIRE(world.Extents.y == Approx(halfDiagonal));
+                REQUIRE(world.Extents.z == Approx(1.0f));
+            }
+        }
+    }
+}
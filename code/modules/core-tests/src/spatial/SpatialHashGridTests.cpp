@@ -0,0 +1,148 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "Core.h"
+#include "catch.hpp"
+#include <spatial/SpatialHashGrid.h>
+
+using namespace modulith;
+
+namespace {
+    EntitySet queryRadius(const SpatialHashGrid& grid, const float3& center, float radius) {
+        auto result = EntitySet();
+        grid.QueryRadius(center, radius, [&result](Entity entity, const float3& position) { result.insert(entity); });
+        return result;
+    }
+}
+
+SCENARIO("The spatial hash grid finds entities near a position", "[Spatial]") {
+    GIVEN("A grid with entities spread over many cells, including negative coordinates") {
+        auto grid = SpatialHashGrid(2.0f);
+        auto positions = std::vector<float3>();
+        for (int x = -5; x <= 5; ++x)
+            for (int z = -5; z <= 5; ++z)
+                positions.emplace_back(1.5f * x, 0.25f * x, 1.5f * z);
+        for (uint32_t i = 0; i < positions.size(); ++i)
+            grid.Insert(Entity(i + 1), positions[i]);
+        grid.Build();
+
+        WHEN("The entities within a radius are queried") {
+            auto center = float3(0.7f, 0.0f, -2.1f);
+            auto radius = 3.2f;
+            auto found = queryRadius(grid, center, radius);
+
+            THEN("exactly the entities within the radius are found") {
+                auto expected = EntitySet();
+                for (uint32_t i = 0; i < positions.size(); ++i) {
+                    auto offset = positions[i] - center;
+                    if (glm::dot(offset, offset) <= radius * radius)
+                        expected.insert(Entity(i + 1));
+                }
+                REQUIRE(!expected.empty());
+                REQUIRE(found == expected);
+            }
+        }
+
+        WHEN("A radius larger than the whole grid is queried") {
+            auto found = queryRadius(grid, float3(0.0f), 1000.0f);
+
+            THEN("all entities are found") {
+                REQUIRE(found.size() == positions.size());
+                REQUIRE(grid.Size() == positions.size());
+            }
+        }
+
+        WHEN("The entities inside a box are queried") {
+            auto found = EntitySet();
+            grid.QueryBox(
+                float3(-3.0f, -10.0f, -0.5f), float3(0.0f, 10.0f, 1.5f),
+                [&found](Entity entity, const float3& position) { found.insert(entity); }
+            );
+
+            THEN("exactly the entities inside the box are found") {
+                // x in {-3, -1.5, 0} and z in {0, 1.5}
+                REQUIRE(found.size() == 3 * 2);
+            }
+        }
+
+        WHEN("The nearest entities are searched") {
+            auto center = float3(4.4f, 0.0f, 4.4f);
+            auto nearest = grid.FindNearest(center, 3, 100.0f);
+
+            THEN("they are returned sorted by their distance") {
+                REQUIRE(nearest.size() == 3);
+                auto lastDistance = 0.0f;
+                for (auto entity : nearest) {
+                    auto offset = positions[entity.GetId() - 1] - center;
+                    auto distance = glm::dot(offset, offset);
+                    REQUIRE(distance >= lastDistance);
+                    lastDistance = distance;
+                }
+                REQUIRE(positions[nearest[0].GetId() - 1].x == Approx(4.5f));
+                REQUIRE(positions[nearest[0].GetId() - 1].z == Approx(4.5f));
+            }
+        }
+
+        WHEN("The nearest entities are searched within a small radius") {
+            auto nearest = grid.FindNearest(float3(100.0f, 0.0f, 100.0f), 3, 10.0f);
+
+            THEN("no entity is returned") {
+                REQUIRE(nearest.empty());
+            }
+        }
+
+        WHEN("The grid is cleared") {
+            grid.Clear();
+
+            THEN("no entity is found anymore") {
+                REQUIRE(queryRadius(grid, float3(0.0f), 1000.0f).empty());
+            }
+        }
+    }
+}
+
+SCENARIO("The spatial hash grid finds entities packed into a few cells", "[Spatial]") {
+    GIVEN("A grid with many entities clustered in two distant cells") {
+        auto grid = SpatialHashGrid(4.0f);
+        auto positions = std::vector<float3>();
+        for (int i = 0; i < 500; ++i) {
+            auto offset = float3((float) (i % 10), 0.0f, (float) (i / 10 % 10)) * 0.3f;
+            positions.push_back(float3(0.5f) + offset);
+            positions.push_back(float3(40.5f, 0.5f, 0.5f) + offset);
+        }
+        for (uint32_t i = 0; i < positions.size(); ++i)
+            grid.Insert(Entity(i + 1), positions[i]);
+        grid.Build();
+
+        WHEN("A radius covering many more cells than are occupied is queried around one cluster") {
+            auto center = float3(2.0f, 0.0f, 2.0f);
+            auto radius = 15.0f;
+            auto found = queryRadius(grid, center, radius);
+
+            THEN("exactly the entities of that cluster within the radius are found") {
+                auto expected = EntitySet();
+                for (uint32_t i = 0; i < positions.size(); ++i) {
+                    auto offset = positions[i] - center;
+                    if (glm::dot(offset, offset) <= radius * radius)
+                        expected.insert(Entity(i + 1));
+                }
+                REQUIRE(expected.size() == 500);
+                REQUIRE(found == expected);
+            }
+        }
+
+        WHEN("A box between the clusters is queried") {
+            auto found = EntitySet();
+            grid.QueryBox(
+                float3(10.0f, -20.0f, -20.0f), float3(30.0f, 20.0f, 20.0f),
+                [&found](Entity entity, const float3& position) { found.insert(entity); }
+            );
+
+            THEN("no entity is found") {
+                REQUIRE(found.empty());
+            }
+        }
+    }
+}
@@ -245,6 +245,12 @@ namespace modulith {
 
         ///@}
 
+        /**
+         * Updates a single system, so that its Changed queries see every write done since its last update.
+         * OnUpdate calls this for every registered system in their execution order.
+         */
+        void UpdateSystem(System& system, float deltaTime);
+
         void OnInitialize() override;
 
         void OnUpdate(float deltaTime) override;
@@ -14,7 +14,8 @@ namespace modulith{
      * The "each" restriction used in the EntityManager queries
      * @see EntityManager.QueryAll
      * @see EntityManager.QueryActive
-     * @tparam ... All of the component types that must be present on an entity to be included in the query
+     * @tparam ... All of the component types that must be present on an entity to be included in the query.
+     * Const-qualified types (e.g. Each<const PositionData>) are passed as const references and are only read.
      */
     template<class...>
     struct Each{
@@ -25,7 +26,8 @@ namespace modulith{
      * The "any" restriction used in the EntityManager queries
      * @see EntityManager.QueryAll
      * @see EntityManager.QueryActive
-     * @tparam ... One of these component types must be present on an entity to be included in the query
+     * @tparam ... One of these component types must be present on an entity to be included in the query.
+     * Const-qualified types (e.g. Any<const PositionData>) are passed as const pointers and are only read.
      */
     template<class...>
     struct Any{
@@ -53,6 +55,25 @@ namespace modulith{
     struct Has{
     };
 
+    /**
+     * The "changed" restriction used in the EntityManager queries
+     * @see EntityManager.QueryAll
+     * @see EntityManager.QueryActive
+     * @tparam ... Only chunks where at least one of these component types was written to since the
+     * currently executing system last ran are included in the query.
+     * The restriction is evaluated per chunk, not per entity.
+     */
+    template<class...>
+    struct Changed{
+    };
+
+    /**
+     * True if a component type given to a query or GetComponent is only accessed for reading,
+     * which is expressed by const-qualifying it. Read-only accesses do not count as changes.
+     */
+    template<class TComponent>
+    constexpr bool IsReadOnlyAccess = std::is_const_v<TComponent>;
+
     /**
      * Utility. When used with std::declval it converts any type into a boolean.
      * There is no implementation. This should only be used inside std::declval!
@@ -114,4 +135,72 @@ namespace modulith{
             return lhs.get() == rhs.get();
         }
     };
+
+    /**
+     * Describes which component types are read and which are written by a query.
+     * This can be used to determine if two queries (or systems) may safely access the same data concurrently.
+     */
+    struct ComponentAccess {
+        /**
+         * Component types that are only read
+         */
+        ComponentSet Reads{};
+
+        /**
+         * Component types that may be written to
+         */
+        ComponentSet Writes{};
+
+        /**
+         * @return Returns the access of a query with the given Each and Any restrictions.
+         * Const-qualified component types are read, all others are written.
+         */
+        template<class... EachComponents, class... AnyComponents>
+        static ComponentAccess Of(Each<EachComponents...>, Any<AnyComponents...> = Any<>()) {
+            auto res = ComponentAccess();
+            (res.add<EachComponents>(), ...);
+            (res.add<AnyComponents>(), ...);
+            return res;
+        }
+
+        /**
+         * Combines the access of both, e.g. for describing a system that executes multiple queries
+         */
+        [[nodiscard]] ComponentAccess CombineWith(const ComponentAccess& other) const {
+            auto res = *this;
+            res.Writes.insert(other.Writes.begin(), other.Writes.end());
+            for (auto& read : other.Reads)
+                if (res.Writes.count(read) == 0)
+                    res.Reads.insert(read);
+            for (auto& write : res.Writes)
+                res.Reads.erase(write);
+            return res;
+        }
+
+        /**
+         * @return Returns true if one of the accesses writes to a component type the other one reads or writes
+         */
+        [[nodiscard]] bool ConflictsWith(const ComponentAccess& other) const {
+            for (auto& write : Writes)
+                if (other.Writes.count(write) > 0 || other.Reads.count(write) > 0)
+                    return true;
+            for (auto& write : other.Writes)
+                if (Reads.count(write) > 0)
+                    return true;
+            return false;
+        }
+
+    private:
+        template<class TComponent>
+        void add() {
+            if constexpr (IsReadOnlyAccess<TComponent>) {
+                if (Writes.count(typeid(TComponent)) == 0)
+                    Reads.insert(typeid(TComponent));
+            }
+            else {
+                Reads.erase(typeid(TComponent));
+                Writes.insert(typeid(TComponent));
+            }
+        }
+    };
 }
@@ -14,10 +14,15 @@ namespace modulith{
     /// Each entity chunk's entity buffer size is 16 kb
     #define MODU_CHUNK_SIZE_BYTES 16 * 1024
 
+    /// Each column of an entity chunk's buffer starts at a multiple of 16 bytes, so it can be used with SIMD instructions
+    #define MODU_CHUNK_COLUMN_ALIGNMENT 16
+
     /**
      * An entity chunk contains a number of entities that all have the same signature (e.g. they have the same components).
      * It is a custom allocator for entities with the same signature and ensures a cache-friendly memory layout.
-     * @remark Its buffer is organized as follows: First, all alive entities, then all dead entities followed by all unoccupied entity slots.
+     * @remark Its buffer is organized in columns: First, a column containing all entities, followed by one column per component type.
+     * Every column is aligned to 16 bytes and stores its values contiguously in the same order:
+     * First, all alive entities, then all dead entities followed by all unoccupied entity slots.
      * "Dead" entities are excluded from queries and will be removed at the end of the frame.
      */
     class CORE_API EntityChunk {
@@ -49,6 +54,11 @@ namespace modulith{
          */
         [[nodiscard]] size_t GetCapacity() const { return _capacity; }
 
+        /**
+         * @return Returns the amount of entities that are alive, e.g. not marked as "dead"
+         */
+        [[nodiscard]] size_t GetAlive() const { return _aliveCount; }
+
         /**
          * @return Returns the amount of entity slots currently free
          */
@@ -129,15 +139,93 @@ namespace modulith{
          */
         [[nodiscard]] bool ContainsComponent(const ComponentIdentifier& componentType) const;
 
+        /**
+         * @return Returns a pointer to the first entity of this chunk.
+         * The first GetAlive() entities are alive, followed by all entities marked as "dead".
+         */
+        [[nodiscard]] const Entity* GetEntities() const { return reinterpret_cast<const Entity*>(_buffer); }
+
+        /**
+         * Returns a typed pointer to the column of the given component, which contains the component of every entity in this chunk.
+         * The component of the entity at GetEntities()[i] is located at GetColumn<TComponent>()[i].
+         * @tparam TComponent The type of the component. It may be const-qualified.
+         * @return A pointer to the first component of the column, or nullptr if this chunk does not contain the component.
+         * @remark This does not mark the component as changed.
+         */
+        template<class TComponent>
+        TComponent* GetColumn();
+
+        /**
+         * Returns an untyped pointer to the column of the given component
+         * @return A pointer to the first component of the column, or nullptr if this chunk does not contain the component.
+         * @remark This does not mark the component as changed.
+         */
+        void* GetColumn(const ComponentIdentifier& component);
+
         /**
          * Internal Implementation of the EntityManager.Query.
          * The passed function is called for every entity in this chunk with the appropriate parameters.
+         * All non-const Each and Any components present in this chunk are marked as changed with the given version.
          * @see EntityManager.QueryActive
          * @see EntityManager.QueryAll
          * @remark Refer to the general doxygen documentation on Queries on how this method is used
          */
         template<class... EachComponents, class... AnyComponents, class... HasComponents, class Fn>
-        void Query(Each<EachComponents...> each, Any<AnyComponents...> any, Fn function, HasComponents... hasComponents);
+        void Query(
+            Each<EachComponents...> each, Any<AnyComponents...> any, Fn function, uint64_t changeVersion,
+            HasComponents... hasComponents
+        );
+
+        /**
+         * Internal Implementation of the EntityManager.QueryChunks.
+         * The passed function is called once with the columns of all alive entities in this chunk,
+         * unless this chunk does not contain any alive entities.
+         * All non-const Each and Any components present in this chunk are marked as changed with the given version.
+         * @see EntityManager.QueryAllChunks
+         * @see EntityManager.QueryActiveChunks
+         */
+        template<class... EachComponents, class... AnyComponents, class Fn>
+        void QueryColumns(Each<EachComponents...> each, Any<AnyComponents...> any, Fn function, uint64_t changeVersion);
+
+        ///@}
+
+        /**
+         * @name Change Tracking
+         * Every component type of a chunk stores the version in which it was last handed out for writing.
+         * Additionally, the chunk stores the version in which an entity was last moved into it.
+         * Versions are supplied by the EntityManager.
+         */
+        ///@{
+
+        /**
+         * @return Returns the version in which the given component was last written to in this chunk,
+         * or 0 if the component is not contained in this chunk
+         */
+        [[nodiscard]] uint64_t GetChangeVersion(const ComponentIdentifier& component) const;
+
+        /**
+         * @return Returns the version in which an entity was last allocated in this chunk
+         */
+        [[nodiscard]] uint64_t GetStructuralVersion() const { return _structuralVersion; }
+
+        /**
+         * @return Returns true if the given component was written to or an entity was allocated in this chunk
+         * after the given version
+         */
+        [[nodiscard]] bool HasChangedSince(const ComponentIdentifier& component, uint64_t version) const;
+
+        /**
+         * Marks the given component as changed. Has no effect if the component is not contained in this chunk.
+         * @param component The component that was (potentially) written to
+         * @param version The current version of the entity manager
+         */
+        void MarkChanged(const ComponentIdentifier& component, uint64_t version);
+
+        /**
+         * Marks all components of this chunk as changed, e.g. because a new entity was allocated in it
+         * @param version The current version of the entity manager
+         */
+        void MarkStructureChanged(uint64_t version) { _structuralVersion = version; }
 
         ///@}
 
@@ -204,6 +292,12 @@ namespace modulith{
 
     private:
 
+        /**
+         * Marks the component as changed, unless it is only accessed for reading (e.g. it is const-qualified)
+         */
+        template<class TComponent>
+        void markWritten(uint64_t version);
+
         /**
          * @param fromIndex Inclusive
          * @param toIndex Exclusive
@@ -212,6 +306,23 @@ namespace modulith{
         void makeLastAliveEntity(Entity entity);
         [[nodiscard]] Entity entityAt(uint32_t index) const;
 
+        /**
+         * The location of a component's values in the chunk's buffer
+         */
+        struct ComponentColumn {
+            /// The offset of the column's first value from the start of the buffer in bytes
+            size_t Offset;
+            /// The size of a single value in bytes
+            size_t Size;
+            /// The version in which the component was last written to
+            uint64_t ChangeVersion;
+        };
+
+        /**
+         * Swaps two values of a column, using the column's unoccupied slot at index _capacity as temporary storage
+         */
+        void swapSlots(size_t columnOffset, size_t valueSize, uint32_t index, uint32_t otherIndex);
+
         ref<ComponentManager> _componentManager;
 
         size_t _capacity;
@@ -225,9 +336,11 @@ namespace modulith{
         size_t _entitySize;
 
         EntityMappedTo<uint32_t> _entityIndices;
-        ComponentMap<size_t> _offsets;
+        ComponentMap<ComponentColumn> _columns;
 
-        std::byte _buffer[MODU_CHUNK_SIZE_BYTES];
+        uint64_t _structuralVersion = 0;
+
+        alignas(MODU_CHUNK_COLUMN_ALIGNMENT) std::byte _buffer[MODU_CHUNK_SIZE_BYTES];
     };
 
 
@@ -236,16 +349,49 @@ namespace modulith{
         return (TComponent*) GetComponentPtr(entity, typeid(TComponent));
     }
 
+    template<class TComponent>
+    TComponent* EntityChunk::GetColumn() {
+        return (TComponent*) GetColumn(typeid(TComponent));
+    }
+
     template<class... EachComponents, class... AnyComponents, class... HasComponents, class Fn>
-    void EntityChunk::Query(Each<EachComponents...>, Any<AnyComponents...>, Fn function, HasComponents... hasComponents) {
-
-        for(uint32_t index = 0; index < _aliveCount; ++index){
-            auto entity = entityAt(index);
-            function(
-                entity, *(GetComponentPtr<EachComponents>(entity))..., (GetComponentPtr<AnyComponents>(entity))...,
-                hasComponents...
-            );
-        }
+    void EntityChunk::Query(
+        Each<EachComponents...>, Any<AnyComponents...>, Fn function, uint64_t changeVersion,
+        HasComponents... hasComponents
+    ) {
+        QueryColumns(
+            Each<EachComponents...>(), Any<AnyComponents...>(),
+            [&function, &hasComponents...](
+                const Entity* entities, EachComponents* ... eachColumns, AnyComponents* ... anyColumns, size_t count
+            ) {
+                for (size_t index = 0; index < count; ++index) {
+                    function(
+                        entities[index], eachColumns[index]...,
+                        (anyColumns != nullptr ? anyColumns + index : nullptr)...,
+                        hasComponents...
+                    );
+                }
+            }, changeVersion
+        );
+    }
+
+    template<class... EachComponents, class... AnyComponents, class Fn>
+    void EntityChunk::QueryColumns(
+        Each<EachComponents...>, Any<AnyComponents...>, Fn function, uint64_t changeVersion
+    ) {
+        if (_aliveCount == 0)
+            return;
+
+        (markWritten<EachComponents>(changeVersion), ...);
+        (markWritten<AnyComponents>(changeVersion), ...);
+
+        function(GetEntities(), GetColumn<EachComponents>()..., GetColumn<AnyComponents>()..., (size_t) _aliveCount);
+    }
+
+    template<class TComponent>
+    void EntityChunk::markWritten(uint64_t version) {
+        if constexpr (!IsReadOnlyAccess<TComponent>)
+            MarkChanged(typeid(TComponent), version);
     }
 
     template<class TComponent>
@@ -167,13 +167,25 @@ namespace modulith{
 
         /**
          * Tries to get the component attached to an entity
-         * @tparam TComponent The type of the component
+         * @tparam TComponent The type of the component. If it is const-qualified, the component is only read
+         * and is not considered changed.
          * @param entity The entity
          * @return Nullptr if the component was not present, a pointer to the component otherwise
          */
         template<class TComponent>
         TComponent* GetComponent(Entity entity);
 
+        /**
+         * Tries to get multiple components attached to an entity at once.
+         * This only looks up the entity's chunk and its position in the chunk once, instead of once per component.
+         * @tparam TComponents The types of the components. Const-qualified components are only read
+         * and are not considered changed.
+         * @param entity The entity
+         * @return A tuple with a pointer for every component, which is nullptr if the component was not present
+         */
+        template<class... TComponents>
+        std::tuple<TComponents*...> GetComponents(Entity entity);
+
         ///@}
 
         /**
@@ -193,6 +205,8 @@ namespace modulith{
          * @see Any At least one of the given types must be present on an entity to be part fo the query.
          * @see None None of the types given to this class must be present on the entity to be part of the query.
          * @see Has For each type given to this class the function will receive a boolean that is set to true if the given component type is present on the entity.
+         * @see Changed At least one of the given types must have been written to since the currently executing system last ran.
+         * This restriction is evaluated per chunk, so unchanged entities sharing a chunk with changed ones are included as well.
          *
          * The provided function must have an appropriate signature depending on the restrictions:
          * First, a parameter for the entity of type Entity
@@ -208,6 +222,12 @@ namespace modulith{
          *
          * QueryActive will automatically exclude entities with the {@link DisabledTag} or {@link IndirectlyDisabledTag}
          * QueryAll does not exclude such entities
+         *
+         * Every Each and Any component handed out by a query is considered written to and
+         * has its change version bumped in the chunk it is contained in.
+         * Component types can be const-qualified (e.g. Each<const Foo>) to only read them:
+         * they are then passed as const Foo& or const Foo* and their change version is left untouched.
+         * @see ComponentAccess for the read / write metadata of a query
          */
         ///@{
 
@@ -295,6 +315,55 @@ namespace modulith{
         void QueryAll(Each<EachComponents...> each, None<NoneComponents...> none, Fn function);
 
 
+        /**
+         * @remark Refer to the general doxygen documentation on Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class Fn, class = typename std::enable_if<
+            // If Fn is a Callable with signature void(Entity, EachComponents&..., AnyComponents*...) this function can be used
+            std::is_same<
+                decltype(std::declval<Fn>().operator()(
+                    std::declval<Entity>(),
+                    std::declval<EachComponents&>()...,
+                    std::declval<AnyComponents*>()...
+                )),
+                void
+            >::value>::type>
+        void QueryAll(
+            Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none,
+            Changed<ChangedComponents...> changed, Fn function
+        );
+
+        /**
+         * @remark Refer to the general doxygen documentation on Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... ChangedComponents, class Fn, class = typename std::enable_if<
+            // If Fn is a Callable with signature void(Entity, EachComponents&...) this function can be used
+            std::is_same<
+                decltype(std::declval<Fn>().operator()(
+                    std::declval<Entity>(),
+                    std::declval<EachComponents&>()...
+                )),
+                void
+            >::value>::type>
+        void QueryAll(Each<EachComponents...> each, Changed<ChangedComponents...> changed, Fn function);
+
+        /**
+         * @remark Refer to the general doxygen documentation on Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... NoneComponents, class... ChangedComponents, class Fn, class = typename std::enable_if<
+            // If Fn is a Callable with signature void(Entity, EachComponents&...) this function can be used
+            std::is_same<
+                decltype(std::declval<Fn>().operator()(
+                    std::declval<Entity>(),
+                    std::declval<EachComponents&>()...
+                )),
+                void
+            >::value>::type>
+        void QueryAll(
+            Each<EachComponents...> each, None<NoneComponents...> none, Changed<ChangedComponents...> changed,
+            Fn function
+        );
+
         /**
          * @remark Refer to the general doxygen documentation on Queries on how to use this method and its overloads
          */
@@ -372,6 +441,141 @@ namespace modulith{
             >::value>::type>
         void QueryActive(Each<EachComponents...> each, None<NoneComponents...> none, Fn function);
 
+
+        /**
+         * @remark Refer to the general doxygen documentation on Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class Fn, class = typename std::enable_if<
+            // If Fn is a Callable with signature void(Entity, EachComponents&..., AnyComponents*...) this function can be used
+            std::is_same<
+                decltype(std::declval<Fn>().operator()(
+                    std::declval<Entity>(),
+                    std::declval<EachComponents&>()...,
+                    std::declval<AnyComponents*>()...
+                )),
+                void
+            >::value>::type>
+        void QueryActive(
+            Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none,
+            Changed<ChangedComponents...> changed, Fn function
+        );
+
+        /**
+         * @remark Refer to the general doxygen documentation on Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... ChangedComponents, class Fn, class = typename std::enable_if<
+            // If Fn is a Callable with signature void(Entity, EachComponents&...) this function can be used
+            std::is_same<
+                decltype(std::declval<Fn>().operator()(
+                    std::declval<Entity>(),
+                    std::declval<EachComponents&>()...
+                )),
+                void
+            >::value>::type>
+        void QueryActive(Each<EachComponents...> each, Changed<ChangedComponents...> changed, Fn function);
+
+        /**
+         * @remark Refer to the general doxygen documentation on Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... NoneComponents, class... ChangedComponents, class Fn, class = typename std::enable_if<
+            // If Fn is a Callable with signature void(Entity, EachComponents&...) this function can be used
+            std::is_same<
+                decltype(std::declval<Fn>().operator()(
+                    std::declval<Entity>(),
+                    std::declval<EachComponents&>()...
+                )),
+                void
+            >::value>::type>
+        void QueryActive(
+            Each<EachComponents...> each, None<NoneComponents...> none, Changed<ChangedComponents...> changed,
+            Fn function
+        );
+
+        ///@}
+
+        /**
+         * @name Chunk Queries
+         *
+         * These queries match chunks with the same restrictions as the entity queries above (excluding Has),
+         * but call the provided function only once per matching chunk that contains alive entities.
+         * Instead of single components, the function receives pointers to contiguous arrays (columns) that
+         * contain the values of all alive entities in the chunk.
+         * This allows writing tight loops over the components which can be vectorized by the compiler or by hand.
+         *
+         * The provided function must have the following signature:
+         * First, a pointer to the chunk's entities of type const Entity*
+         * Then, pointers to the columns of all Each types of type Each*
+         * After that, pointers to the columns of all Any types of type Any*, which are nullptr if the chunk does not contain the type
+         * Lastly, the amount of entities of type size_t
+         *
+         * This results in a function signature similar to:
+         * void(const Entity*, EachComponents*..., AnyComponents*..., size_t)
+         *
+         * Example: Calling QueryAllChunks(Each<Foo>(), Any<Bar>(), None<Baz>(), ...) requires a lambda function with the parameters
+         * void(const Entity* entities, Foo* foos, Bar* bars, size_t count). The component of entities[i] is foos[i].
+         *
+         * The same rules for deferring operations, change tracking and const-qualification as for the entity queries apply.
+         */
+        ///@{
+
+        /**
+         * @remark Refer to the documentation on Chunk Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class Fn>
+        void QueryAllChunks(Each<EachComponents...> each, Fn function);
+
+        /**
+         * @remark Refer to the documentation on Chunk Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... NoneComponents, class Fn>
+        void QueryAllChunks(Each<EachComponents...> each, None<NoneComponents...> none, Fn function);
+
+        /**
+         * @remark Refer to the documentation on Chunk Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... AnyComponents, class... NoneComponents, class Fn>
+        void QueryAllChunks(
+            Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none, Fn function
+        );
+
+        /**
+         * @remark Refer to the documentation on Chunk Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class Fn>
+        void QueryAllChunks(
+            Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none,
+            Changed<ChangedComponents...> changed, Fn function
+        );
+
+        /**
+         * @remark Refer to the documentation on Chunk Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class Fn>
+        void QueryActiveChunks(Each<EachComponents...> each, Fn function);
+
+        /**
+         * @remark Refer to the documentation on Chunk Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... NoneComponents, class Fn>
+        void QueryActiveChunks(Each<EachComponents...> each, None<NoneComponents...> none, Fn function);
+
+        /**
+         * @remark Refer to the documentation on Chunk Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... AnyComponents, class... NoneComponents, class Fn>
+        void QueryActiveChunks(
+            Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none, Fn function
+        );
+
+        /**
+         * @remark Refer to the documentation on Chunk Queries on how to use this method and its overloads
+         */
+        template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class Fn>
+        void QueryActiveChunks(
+            Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none,
+            Changed<ChangedComponents...> changed, Fn function
+        );
+
         ///@}
 
         /**
@@ -409,6 +613,41 @@ namespace modulith{
 
         ///@}
 
+        /**
+         * @name Change Tracking
+         * The entity manager has a version that is incremented before each system update.
+         * Whenever a component is handed out for writing, its chunk remembers the current version.
+         * The Changed restriction of queries compares these against the version of the system's last update.
+         */
+        ///@{
+
+        /**
+         * @return Returns the current change version. Component writes are stamped with this version.
+         */
+        [[nodiscard]] uint64_t GetChangeVersion() const { return _changeVersion; }
+
+        /**
+         * @return Returns the change version of the last update of the currently executing system,
+         * or 0 if it has never been updated before
+         */
+        [[nodiscard]] uint64_t GetLastSystemVersion() const { return _lastSystemVersion; }
+
+        /**
+         * Increments the change version. Should be called before a system is updated.
+         * @param lastSystemVersion The version returned by this method when the system was last updated, or 0
+         * @return Returns the new change version, which should be stored by the caller for the next update
+         */
+        uint64_t BeginSystemUpdate(uint64_t lastSystemVersion);
+
+        /**
+         * Increments the change version. Should be called after a system was updated,
+         * so writes done outside of systems afterwards (e.g. by subcontexts or at the end of the frame)
+         * are stamped with a newer version than the system's and are seen as changes by its next update.
+         */
+        void EndSystemUpdate();
+
+        ///@}
+
         /**
          * Should be used during iteration methods (such as @refitem QueryActive) to call
          * methods that modify entities and their components.
@@ -437,6 +676,43 @@ namespace modulith{
         template<class TComponent>
         void ensureComponentIsRegistered() const;
 
+        /**
+         * The implementation of all queries. The function is invoked for every entity in the matching chunks.
+         */
+        template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class... THasComponents, class Fn>
+        void query(
+            Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none,
+            Changed<ChangedComponents...> changed, Has<THasComponents...>, Fn& function
+        );
+
+        /**
+         * The implementation of all chunk queries. The function is invoked once for every matching chunk.
+         */
+        template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class Fn>
+        void queryChunks(
+            Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none,
+            Changed<ChangedComponents...> changed, Fn& function
+        );
+
+        /**
+         * Invokes the chunkFunction for every chunk matching the restrictions.
+         * Operations deferred during the invocations are executed afterwards.
+         */
+        template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class ChunkFn>
+        void forEachMatchingChunk(
+            Each<EachComponents...>, Any<AnyComponents...>, None<NoneComponents...>, Changed<ChangedComponents...>,
+            const ChunkFn& chunkFunction
+        );
+
+        template<class... ChangedComponents>
+        [[nodiscard]] bool hasChangedSinceLastSystemUpdate(const EntityChunk& chunk) const;
+
+        /**
+         * @return Returns the component of the entity at the given index of the chunk, or nullptr if the chunk does not contain it
+         */
+        template<class TComponent>
+        TComponent* getComponentAt(EntityChunk& chunk, size_t index);
+
         /**
          * The depth of nested iteration functions currently being executed
          */
@@ -449,6 +725,10 @@ namespace modulith{
         void executeDeferredOperations();
 
         unsigned int _runningEntityId = 0; // TODO temporary: replace with guid system / id pool?
+
+        // Starts at 1, so that newly created chunks are always considered changed for systems that have never run
+        uint64_t _changeVersion = 1;
+        uint64_t _lastSystemVersion = 0;
         std::vector<shared<EntityChunk>> _chunks;
         EntityMappedTo<shared<EntityChunk>> _entityLocations;
 
@@ -541,9 +821,11 @@ namespace modulith{
             EntityChunk::MoveEntity(entity, *currentChunk, *destinationChunk, currentIdentifier, _componentManager);
 
             _entityLocations[entity] = destinationChunk;
+            destinationChunk->MarkStructureChanged(_changeVersion);
         }
 
         (destinationChunk->MoveComponentIntoChunk<TComponents>(entity, toAdd), ...);
+        (destinationChunk->MarkChanged(typeid(TComponents), _changeVersion), ...);
     }
 
 /// --------------------------------------------------------------------------------------------------------
@@ -589,6 +871,7 @@ namespace modulith{
         EntityChunk::MoveEntity(entity, *currentChunk, *destinationChunk, destinationIdentifier, _componentManager);
 
         _entityLocations[entity] = destinationChunk;
+        destinationChunk->MarkStructureChanged(_changeVersion);
 
         return true;
     }
@@ -601,9 +884,27 @@ namespace modulith{
     TComponent* EntityManager::GetComponent(Entity entity) {
         ensureComponentsAreRegistered<TComponent>();
         auto chunk = getChunkReadWrite(entity);
+        if constexpr (!IsReadOnlyAccess<TComponent>)
+            chunk->MarkChanged(typeid(TComponent), _changeVersion);
         return chunk->GetComponentPtr<TComponent>(entity);
     }
 
+    template<class... TComponents>
+    std::tuple<TComponents*...> EntityManager::GetComponents(Entity entity) {
+        ensureComponentsAreRegistered<TComponents...>();
+        auto chunk = getChunkReadWrite(entity);
+        auto index = chunk->OffsetOf(entity);
+        return std::make_tuple(getComponentAt<TComponents>(*chunk, index)...);
+    }
+
+    template<class TComponent>
+    TComponent* EntityManager::getComponentAt(EntityChunk& chunk, size_t index) {
+        if constexpr (!IsReadOnlyAccess<TComponent>)
+            chunk.MarkChanged(typeid(TComponent), _changeVersion);
+        auto column = chunk.GetColumn<TComponent>();
+        return column != nullptr ? column + index : nullptr;
+    }
+
     template<class... TComponents>
     bool EntityManager::HasComponents(Entity entity) {
         ensureComponentsAreRegistered<TComponents...>();
@@ -617,12 +918,20 @@ namespace modulith{
         return (chunk->GetSignature() & signature) == signature;
     }
 
-    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... THasComponents, class Fn, class>
-    void EntityManager::QueryAll(
-        Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...>, Has<THasComponents...>,
-        Fn function
+    template<class... ChangedComponents>
+    bool EntityManager::hasChangedSinceLastSystemUpdate(const EntityChunk& chunk) const {
+        if constexpr (sizeof...(ChangedComponents) == 0)
+            return true;
+        else
+            return (chunk.HasChangedSince(typeid(ChangedComponents), _lastSystemVersion) || ...);
+    }
+
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class ChunkFn>
+    void EntityManager::forEachMatchingChunk(
+        Each<EachComponents...>, Any<AnyComponents...>, None<NoneComponents...>, Changed<ChangedComponents...>,
+        const ChunkFn& chunkFunction
     ) {
-        ensureComponentsAreRegistered<EachComponents..., AnyComponents..., NoneComponents..., THasComponents...>();
+        ensureComponentsAreRegistered<EachComponents..., AnyComponents..., NoneComponents..., ChangedComponents...>();
         ++_iterationDepth;
 
         auto eachIdentifier = _componentManager->ToIdentifier<EachComponents...>();
@@ -635,13 +944,13 @@ namespace modulith{
         auto noneSignature = _componentManager->ToSignature(noneIdentifier);
 
         for (const shared<EntityChunk>& chunk : _chunks) {
-            auto chunkIdentifier = chunk->GetIdentifier();
             auto chunkSignature = chunk->GetSignature();
             if ((chunkSignature & eachSignature) == eachSignature
                 && (anySignature.none() || (chunkSignature & anySignature).any())
                 && (chunkSignature & noneSignature).none()
+                && hasChangedSinceLastSystemUpdate<ChangedComponents...>(*chunk)
                 ) {
-                chunk->Query(each, any, function, (chunkIdentifier.count(typeid(THasComponents)) > 0)...);
+                chunkFunction(*chunk);
             }
         }
 
@@ -650,100 +959,81 @@ namespace modulith{
             executeDeferredOperations();
     }
 
-    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class Fn, class>
-    void
-    EntityManager::QueryAll(Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...>, Fn function) {
-        ensureComponentsAreRegistered<EachComponents..., AnyComponents..., NoneComponents...>();
-        ++_iterationDepth;
-
-        auto eachIdentifier = _componentManager->ToIdentifier<EachComponents...>();
-        auto eachSignature = _componentManager->ToSignature(eachIdentifier);
-
-        auto anyIdentifier = _componentManager->ToIdentifier<AnyComponents...>();
-        auto anySignature = _componentManager->ToSignature(anyIdentifier);
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class... THasComponents, class Fn>
+    void EntityManager::query(
+        Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none,
+        Changed<ChangedComponents...> changed, Has<THasComponents...>, Fn& function
+    ) {
+        ensureComponentsAreRegistered<THasComponents...>();
+        forEachMatchingChunk(each, any, none, changed, [this, &function](EntityChunk& chunk) {
+            chunk.Query(
+                Each<EachComponents...>(), Any<AnyComponents...>(), function, _changeVersion,
+                chunk.ContainsComponent(typeid(THasComponents))...
+            );
+        });
+    }
 
-        auto noneIdentifier = _componentManager->ToIdentifier<NoneComponents...>();
-        auto noneSignature = _componentManager->ToSignature(noneIdentifier);
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class Fn>
+    void EntityManager::queryChunks(
+        Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none,
+        Changed<ChangedComponents...> changed, Fn& function
+    ) {
+        static_assert(
+            std::is_invocable_r_v<void, Fn&, const Entity*, EachComponents*..., AnyComponents*..., size_t>,
+            "The function of a chunk query must have the signature void(const Entity*, EachComponents*..., AnyComponents*..., size_t)"
+        );
+        forEachMatchingChunk(each, any, none, changed, [this, &function](EntityChunk& chunk) {
+            chunk.QueryColumns(Each<EachComponents...>(), Any<AnyComponents...>(), function, _changeVersion);
+        });
+    }
 
-        for (const shared<EntityChunk>& chunk : _chunks) {
-            auto chunkSignature = chunk->GetSignature();
-            if ((chunkSignature & eachSignature) == eachSignature
-                && (anySignature.none() || (chunkSignature & anySignature).any())
-                && (chunkSignature & noneSignature).none()
-                ) {
-                chunk->Query(each, any, function);
-            }
-        }
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... THasComponents, class Fn, class>
+    void EntityManager::QueryAll(
+        Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none, Has<THasComponents...> has,
+        Fn function
+    ) {
+        query(each, any, none, Changed(), has, function);
+    }
 
-        --_iterationDepth;
-        if (_iterationDepth == 0)
-            executeDeferredOperations();
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class Fn, class>
+    void
+    EntityManager::QueryAll(Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none, Fn function) {
+        query(each, any, none, Changed(), Has(), function);
     }
 
     template<class... EachComponents, class Fn, class>
     void EntityManager::QueryAll(Each<EachComponents...> each, Fn function) {
-        ensureComponentsAreRegistered<EachComponents...>();
-        ++_iterationDepth;
-
-        auto eachIdentifier = _componentManager->ToIdentifier<EachComponents...>();
-        auto eachSignature = _componentManager->ToSignature(eachIdentifier);
-
-        for (const shared<EntityChunk>& chunk : _chunks) {
-            auto chunkSignature = chunk->GetSignature();
-            if ((chunkSignature & eachSignature) == eachSignature) {
-                chunk->Query(each, Any(), function);
-            }
-        }
-
-        --_iterationDepth;
-        if (_iterationDepth == 0)
-            executeDeferredOperations();
+        query(each, Any(), None(), Changed(), Has(), function);
     }
 
     template<class... AnyComponents, class Fn, class>
     void EntityManager::QueryAll(Any<AnyComponents...> any, Fn function) {
-        ensureComponentsAreRegistered<AnyComponents...>();
-        ++_iterationDepth;
-
-        auto anyIdentifier = _componentManager->ToIdentifier<AnyComponents...>();
-        auto anySignature = _componentManager->ToSignature(anyIdentifier);
-
-        for (const shared<EntityChunk>& chunk : _chunks) {
-            auto chunkSignature = chunk->GetSignature();
-            if (anySignature.none() || (chunkSignature & anySignature).any()) {
-                chunk->Query(Each(), any, function);
-            }
-        }
-
-        --_iterationDepth;
-        if (_iterationDepth == 0)
-            executeDeferredOperations();
+        query(Each(), any, None(), Changed(), Has(), function);
     }
 
-
     template<class... EachComponents, class... NoneComponents, class Fn, class>
-    void EntityManager::QueryAll(Each<EachComponents...> each, None<NoneComponents...>, Fn function) {
-        ensureComponentsAreRegistered<EachComponents..., NoneComponents...>();
-        ++_iterationDepth;
-
-        auto eachIdentifier = _componentManager->ToIdentifier<EachComponents...>();
-        auto eachSignature = _componentManager->ToSignature(eachIdentifier);
+    void EntityManager::QueryAll(Each<EachComponents...> each, None<NoneComponents...> none, Fn function) {
+        query(each, Any(), none, Changed(), Has(), function);
+    }
 
-        auto noneIdentifier = _componentManager->ToIdentifier<NoneComponents...>();
-        auto noneSignature = _componentManager->ToSignature(noneIdentifier);
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class Fn, class>
+    void EntityManager::QueryAll(
+        Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none,
+        Changed<ChangedComponents...> changed, Fn function
+    ) {
+        query(each, any, none, changed, Has(), function);
+    }
 
-        for (const shared<EntityChunk>& chunk : _chunks) {
-            auto chunkSignature = chunk->GetSignature();
-            if ((chunkSignature & eachSignature) == eachSignature
-                && (chunkSignature & noneSignature).none()
-                ) {
-                chunk->Query(each, Any(), function);
-            }
-        }
+    template<class... EachComponents, class... ChangedComponents, class Fn, class>
+    void EntityManager::QueryAll(Each<EachComponents...> each, Changed<ChangedComponents...> changed, Fn function) {
+        query(each, Any(), None(), changed, Has(), function);
+    }
 
-        --_iterationDepth;
-        if (_iterationDepth == 0)
-            executeDeferredOperations();
+    template<class... EachComponents, class... NoneComponents, class... ChangedComponents, class Fn, class>
+    void EntityManager::QueryAll(
+        Each<EachComponents...> each, None<NoneComponents...> none, Changed<ChangedComponents...> changed, Fn function
+    ) {
+        query(each, Any(), none, changed, Has(), function);
     }
 
     template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... THasComponents, class Fn, class>
@@ -768,7 +1058,7 @@ namespace modulith{
 
     template<class... AnyComponents, class Fn, class>
     void EntityManager::QueryActive(Any<AnyComponents...> any, Fn function) {
-        QueryAll(any, None<IndirectlyDisabledTag>(), function);
+        QueryAll(Each(), any, None<IndirectlyDisabledTag>(), function);
     }
 
     template<class... EachComponents, class... NoneComponents, class Fn, class>
@@ -776,6 +1066,76 @@ namespace modulith{
         QueryAll(each, None<IndirectlyDisabledTag, NoneComponents...>(), function);
     }
 
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class Fn, class>
+    void EntityManager::QueryActive(
+        Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...>,
+        Changed<ChangedComponents...> changed, Fn function
+    ) {
+        QueryAll(each, any, None<IndirectlyDisabledTag, NoneComponents...>(), changed, function);
+    }
+
+    template<class... EachComponents, class... ChangedComponents, class Fn, class>
+    void EntityManager::QueryActive(Each<EachComponents...> each, Changed<ChangedComponents...> changed, Fn function) {
+        QueryAll(each, None<IndirectlyDisabledTag>(), changed, function);
+    }
+
+    template<class... EachComponents, class... NoneComponents, class... ChangedComponents, class Fn, class>
+    void EntityManager::QueryActive(
+        Each<EachComponents...> each, None<NoneComponents...>, Changed<ChangedComponents...> changed, Fn function
+    ) {
+        QueryAll(each, None<IndirectlyDisabledTag, NoneComponents...>(), changed, function);
+    }
+
+    template<class... EachComponents, class Fn>
+    void EntityManager::QueryAllChunks(Each<EachComponents...> each, Fn function) {
+        queryChunks(each, Any(), None(), Changed(), function);
+    }
+
+    template<class... EachComponents, class... NoneComponents, class Fn>
+    void EntityManager::QueryAllChunks(Each<EachComponents...> each, None<NoneComponents...> none, Fn function) {
+        queryChunks(each, Any(), none, Changed(), function);
+    }
+
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class Fn>
+    void EntityManager::QueryAllChunks(
+        Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none, Fn function
+    ) {
+        queryChunks(each, any, none, Changed(), function);
+    }
+
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class Fn>
+    void EntityManager::QueryAllChunks(
+        Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...> none,
+        Changed<ChangedComponents...> changed, Fn function
+    ) {
+        queryChunks(each, any, none, changed, function);
+    }
+
+    template<class... EachComponents, class Fn>
+    void EntityManager::QueryActiveChunks(Each<EachComponents...> each, Fn function) {
+        queryChunks(each, Any(), None<IndirectlyDisabledTag>(), Changed(), function);
+    }
+
+    template<class... EachComponents, class... NoneComponents, class Fn>
+    void EntityManager::QueryActiveChunks(Each<EachComponents...> each, None<NoneComponents...>, Fn function) {
+        queryChunks(each, Any(), None<IndirectlyDisabledTag, NoneComponents...>(), Changed(), function);
+    }
+
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class Fn>
+    void EntityManager::QueryActiveChunks(
+        Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...>, Fn function
+    ) {
+        queryChunks(each, any, None<IndirectlyDisabledTag, NoneComponents...>(), Changed(), function);
+    }
+
+    template<class... EachComponents, class... AnyComponents, class... NoneComponents, class... ChangedComponents, class Fn>
+    void EntityManager::QueryActiveChunks(
+        Each<EachComponents...> each, Any<AnyComponents...> any, None<NoneComponents...>,
+        Changed<ChangedComponents...> changed, Fn function
+    ) {
+        queryChunks(each, any, None<IndirectlyDisabledTag, NoneComponents...>(), changed, function);
+    }
+
 /// --------------------------------------------------------------------------------------------------------
 ///                     ENTITY ALIASES
 /// --------------------------------------------------------------------------------------------------------
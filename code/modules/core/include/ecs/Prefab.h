@@ -27,7 +27,8 @@ namespace modulith {
         static shared<Prefab> Create(ref<ComponentManager> componentManager, TComponents&... components);
 
         /**
-         * Creates a prefab with all of the entities components
+         * Creates a prefab with all of the entities components.
+         * The HierarchyNodeData and WithChildrenData are not copied, because they are maintained by the ParentSystem
          * @param componentManager A reference to the current component manager
          * @param entityManager A reference to the entity manager the entity is from
          * @param entity The entity to copy. All attached components must be trivially copy-constructable
@@ -36,7 +37,7 @@ namespace modulith {
         static shared<Prefab> CreateFromEntity(const ref<ComponentManager>& componentManager, const ref<EntityManager>& entityManager, Entity entity);
 
         /**
-         * Creates a prefab with the given signature
+         * Creates a prefab with the given signature, without the HierarchyNodeData and WithChildrenData
          * @param identifier The component signature of the prefab. All contained component types must be trivially copy-construcable
          * @param componentManager A reference to the current component manager
          */
@@ -10,12 +10,14 @@
 namespace modulith {
 
     class Context;
+    class ECSContext;
 
     /**
      * Subclasses of systems are registered in the context and will receive callbacks while the engine is running.
      * Only one instance of a type of System may be registered
      */
     class CORE_API System {
+        friend ECSContext;
     public:
         /**
          * Creates a system with the given name, which is used for debugging purposes
@@ -56,7 +58,14 @@ namespace modulith {
          */
         virtual void OnShutdown() {}
 
+        /**
+         * @return Returns the entity manager's change version of this system's last update, or 0 if it has not been updated yet
+         * @see EntityManager.BeginSystemUpdate
+         */
+        [[nodiscard]] uint64_t GetLastChangeVersion() const { return _lastChangeVersion; }
+
     private:
         ::std::string _name;
+        uint64_t _lastChangeVersion = 0;
     };
 };
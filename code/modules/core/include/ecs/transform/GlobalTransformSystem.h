@@ -13,7 +13,11 @@
 namespace modulith{
 
     /**
-     * Updates the GlobalTransformData based on the WithChildrenData and LocalTransformData each frame.
+     * Updates the GlobalTransformData, InverseGlobalTransformData and DecomposedGlobalTransformData based on the WithChildrenData and LocalTransformData each frame.
+     * Children are updated level by level using their HierarchyNodeData,
+     * reading the transform of their parent from a dense array instead of recursing through the hierarchy.
+     * The WorldBoundsData of entities with a LocalBoundsData is transformed into world space as well.
+     * Afterwards, the flags of the TransformDirtyData are reset, because all transforms are up to date.
      */
     class CORE_API GlobalTransformSystem : public System {
     public:
@@ -23,6 +27,12 @@ namespace modulith{
 
         void OnUpdate(float deltaTime) override;
 
+        /**
+         * Updates the global transforms and the disabled state in the hierarchy of all entities of the given entity manager.
+         * The hierarchy must have been updated by the ParentSystem before.
+         */
+        static void UpdateGlobalTransforms(ref<EntityManager> ecs);
+
         static void UpdateGlobalTransformsBelow(ref<EntityManager> ecs, Entity entity);
 
     private:
@@ -12,7 +12,8 @@
 namespace modulith{
 
     /**
-     * Updates the LocalTransformData based on the PositionData, RotationData and ScaleData of an entity
+     * Updates the LocalTransformData based on the PositionData, RotationData and ScaleData of an entity.
+     * Only chunks in which one of these components changed since the last update are recalculated.
      */
     class CORE_API LocalTransformSystem : public System {
     public:
@@ -20,7 +21,22 @@ namespace modulith{
         ~LocalTransformSystem() override = default;
         void OnUpdate(float deltaTime) override;
 
-        static float4x4 CalculateLocalTransform(PositionData* position, RotationData* rotation, ScaleData* scale);
+        static float4x4 CalculateLocalTransform(
+            const PositionData* position, const RotationData* rotation, const ScaleData* scale
+        );
+
+        /**
+         * Calculates the local transforms of multiple entities at once from the columns of a chunk.
+         * Each of the position, rotation and scale columns may be nullptr if the chunk does not contain the component.
+         * A kernel specialized for the present components is selected, which composes four entities at once using SSE where available,
+         * or eight entities at once using AVX if the build targets AVX2.
+         * @param localTransforms The column the results are written to. Must contain room for count values.
+         * @param count The amount of entities in the columns
+         */
+        static void CalculateLocalTransforms(
+            const PositionData* positions, const RotationData* rotations, const ScaleData* scales,
+            LocalTransformData* localTransforms, size_t count
+        );
     };
 
 }
@@ -7,17 +7,47 @@
 
 #include "CoreModule.h"
 #include "ecs/systems/System.h"
+#include "ecs/Entity.h"
 
 namespace modulith{
 
+    class EntityManager;
+
     /**
-     * Updates the entity hierarchy and WithChildrenData based on the WithParentData each frame.
+     * Maintains the entity hierarchy, WithChildrenData and HierarchyNodeData based on the WithParentData.
+     * Only chunks whose WithParentData or HierarchyNodeData changed since the last update are visited,
+     * so entities whose parent did not change do not cost anything.
      */
     class CORE_API ParentSystem : public System {
     public:
         explicit ParentSystem() : System("Parent System"){}
         ~ParentSystem() override = default;
         void OnUpdate(float deltaTime) override;
+
+        /**
+         * Applies the WithParentData that was added, changed or removed since the last update of the currently executing system
+         * to the WithChildrenData and HierarchyNodeData of the given entity manager
+         */
+        static void UpdateHierarchy(ref<EntityManager> ecs);
+
+    private:
+        /**
+         * Removes the child from the WithChildrenData of the parent.
+         * The WithChildrenData is removed once the parent has no children left.
+         */
+        static void detach(ref<EntityManager>& ecs, Entity child, Entity parent);
+
+        /**
+         * Adds the child to the WithChildrenData of the parent and updates its HierarchyNodeData.
+         * Children of parents that are not alive are not attached and do not have a HierarchyNodeData.
+         * @return Returns true if the child was attached
+         */
+        static bool attach(ref<EntityManager>& ecs, Entity child, Entity parent);
+
+        /**
+         * Recalculates the depth of the given entity and all of its (indirect) children
+         */
+        static void updateDepthsBelow(ref<EntityManager>& ecs, Entity entity);
     };
 
 }
@@ -8,6 +8,7 @@
 #include "CoreModule.h"
 #include <ecs/ECSUtils.h>
 #include "serialization/Serializer.h"
+#include "spatial/Bounds.h"
 
 namespace modulith{
 
@@ -45,13 +46,45 @@ namespace modulith{
     };
 
     /**
-     * This component stores the children of an entity in the scene graph
-     * These are re-calculated every frame by the TransformSystem.
+     * This component stores the children of an entity in the scene graph, sorted by their id.
+     * These are maintained by the ParentSystem whenever the WithParentData of an entity is added, changed or removed.
      * To change the children on an entity, the parents of the to-be children need to be changed instead.
      * @see WithParentData
      */
     struct CORE_API WithChildrenData {
         std::vector<Entity> Values;
+
+        /**
+         * @return Returns true if the given entity is one of the children
+         */
+        [[nodiscard]] bool Contains(Entity child) const;
+
+        /**
+         * Inserts the given child at its sorted position, unless it is already contained
+         */
+        void Add(Entity child);
+
+        /**
+         * Removes the given child if it is contained
+         * @return Returns true if the child was contained
+         */
+        bool Remove(Entity child);
+    };
+
+    /**
+     * Stores where a child entity is attached to the scene graph: the parent whose WithChildrenData contains it
+     * and its depth, which is one more than the depth of its parent.
+     * Root entities (without a parent) do not have this component and are considered to have a depth of 0.
+     * It is maintained by the ParentSystem and allows the GlobalTransformSystem to update the hierarchy level by level.
+     * @see WithParentData
+     */
+    struct CORE_API HierarchyNodeData {
+        HierarchyNodeData() = default;
+
+        HierarchyNodeData(Entity parent, uint32_t depth) : Parent(parent), Depth(depth) {}
+
+        Entity Parent{};
+        uint32_t Depth = 0;
     };
 
 
@@ -115,11 +148,13 @@ namespace modulith{
             Value = glm::quatLookAt(glm::normalize(direction), float3(0,1,0));
         }
 
-        [[nodiscard]] inline float3 Right() const { return glm::normalize(glm::mat4_cast(Value)[0]); }
+        // The basis vectors are rotated directly by the quaternion, instead of converting it into a matrix first
 
-        [[nodiscard]] inline float3 Up() const { return glm::normalize(glm::mat4_cast(Value)[1]); }
+        [[nodiscard]] inline float3 Right() const { return Value * float3(1, 0, 0); }
 
-        [[nodiscard]] inline float3 Forward() const { return glm::normalize(glm::mat4_cast(Value)[2]); }
+        [[nodiscard]] inline float3 Up() const { return Value * float3(0, 1, 0); }
+
+        [[nodiscard]] inline float3 Forward() const { return Value * float3(0, 0, 1); }
     };
 
 
@@ -202,22 +237,22 @@ namespace modulith{
         /**
          * @return Returns the right vector (positive x) relative to its parent
          */
-        [[nodiscard]] float3 Right() const;
+        [[nodiscard]] inline float3 Right() const { return glm::normalize(float3(Value[0])); }
 
         /**
          * @return Returns the up vector (positive y) relative to its parent
          */
-        [[nodiscard]] float3 Up() const;
+        [[nodiscard]] inline float3 Up() const { return glm::normalize(float3(Value[1])); }
 
         /**
          * @return Returns the forward vector (positive z) relative to its parent
          */
-        [[nodiscard]] float3 Forward() const;
+        [[nodiscard]] inline float3 Forward() const { return glm::normalize(float3(Value[2])); }
 
         /**
          * @return Returns the position relative to its parent
          */
-        [[nodiscard]] float3 Position() const;
+        [[nodiscard]] inline float3 Position() const { return Value[3]; }
 
         /**
          * @return Returns the rotation relative to its parent
@@ -276,22 +311,22 @@ namespace modulith{
         /**
          * @return Returns the right vector (positive x) relative to world space
          */
-        [[nodiscard]] float3 Right() const;
+        [[nodiscard]] inline float3 Right() const { return glm::normalize(float3(Value[0])); }
 
         /**
          * @return Returns the up vector (positive y) relative to world space
          */
-        [[nodiscard]] float3 Up() const;
+        [[nodiscard]] inline float3 Up() const { return glm::normalize(float3(Value[1])); }
 
         /**
          * @return Returns the forward vector (positive z) relative to world space
          */
-        [[nodiscard]] float3 Forward() const;
+        [[nodiscard]] inline float3 Forward() const { return glm::normalize(float3(Value[2])); }
 
         /**
          * @return Returns the position relative to world space
          */
-        [[nodiscard]] float3 Position() const;
+        [[nodiscard]] inline float3 Position() const { return Value[3]; }
 
         /**
          * @return Returns the rotation relative to world space
@@ -330,4 +365,98 @@ namespace modulith{
             return std::nullopt;
         }
     };
+
+    /**
+     * Stores the inverse of the GlobalTransformData, which transforms from world space into the space of the entity.
+     * This component is optional: It is only calculated by the GlobalTransformSystem for entities that have it,
+     * so systems that need the inverse every frame (e.g. for normal matrices) do not have to invert the matrix themselves.
+     * It should not be manually set, because it is re-calculated every frame.
+     */
+    struct CORE_API InverseGlobalTransformData {
+        InverseGlobalTransformData() = default;
+
+        explicit InverseGlobalTransformData(const glm::mat4& transform) : Value(transform) {}
+
+        /**
+         * The inverse global transform matrix
+         */
+        float4x4 Value = float4x4(1.0f);
+    };
+
+    /**
+     * Stores the GlobalTransformData decomposed into its position, rotation and scale in world space.
+     * This component is optional: It is only calculated by the GlobalTransformSystem for entities it was added to,
+     * so systems that read the rotation or scale of many entities do not have to decompose the matrix on every call.
+     * Systems that only need the position should read GlobalTransformData::Position instead, which is not decomposed
+     * and is available for every entity with a transform.
+     * It should not be manually set, because it is re-calculated every frame.
+     */
+    struct CORE_API DecomposedGlobalTransformData {
+        DecomposedGlobalTransformData() = default;
+
+        /**
+         * Decomposes the given transform matrix, which may not contain any shearing or projection
+         */
+        explicit DecomposedGlobalTransformData(const float4x4& transform);
+
+        float3 Position = float3(0.0f);
+        glm::quat Rotation = glm::quat();
+        float3 Scale = float3(1.0f);
+
+        /**
+         * @return Returns the right vector (positive x) relative to world space
+         */
+        [[nodiscard]] inline float3 Right() const { return Rotation * float3(1, 0, 0); }
+
+        /**
+         * @return Returns the up vector (positive y) relative to world space
+         */
+        [[nodiscard]] inline float3 Up() const { return Rotation * float3(0, 1, 0); }
+
+        /**
+         * @return Returns the forward vector (positive z) relative to world space
+         */
+        [[nodiscard]] inline float3 Forward() const { return Rotation * float3(0, 0, 1); }
+    };
+
+    /**
+     * Stores the bounds of an entity in its own object space, e.g. the bounds of its mesh.
+     * Entities with this component and a WorldBoundsData get their world bounds updated by the GlobalTransformSystem.
+     */
+    struct CORE_API LocalBoundsData {
+        LocalBoundsData() = default;
+
+        explicit LocalBoundsData(const Bounds& value) : Value(value) {}
+
+        Bounds Value{};
+    };
+
+    /**
+     * Stores the LocalBoundsData transformed into world space by the GlobalTransformData.
+     * It is re-calculated every frame by the GlobalTransformSystem and should not be manually set.
+     */
+    struct CORE_API WorldBoundsData {
+        WorldBoundsData() = default;
+
+        explicit WorldBoundsData(const Bounds& value) : Value(value) {}
+
+        Bounds Value{};
+    };
+
+    /**
+     * Marks an entity whose transform was changed outside of the transform systems,
+     * but whose LocalTransformData and GlobalTransformData have not been updated yet.
+     * All marked entities are updated at once by TransformUtils::UpdateDirtyTransforms,
+     * or by the transform systems at the latest, which also reset the flag.
+     * The component is kept after the update and only the flag is reset, so marking an entity again
+     * does not move it into another chunk.
+     * @see TransformUtils::MarkTransformDirty
+     */
+    struct CORE_API TransformDirtyData {
+        TransformDirtyData() = default;
+
+        explicit TransformDirtyData(bool isDirty) : IsDirty(isDirty) {}
+
+        bool IsDirty = true;
+    };
 }
@@ -20,6 +20,25 @@ namespace modulith{
          */
         static void UpdateTransformOf(ref<EntityManager> ecs, Entity entity);
 
+        /**
+         * Marks the transform of the given entity as changed, without updating it immediately.
+         * This is cheaper than calling UpdateTransformOf for many entities, because every subtree of the hierarchy
+         * is only updated once by UpdateDirtyTransforms or the transform systems.
+         * May also be called while iterating over entities.
+         * @param ecs The entity manager the entity is contained in
+         * @param entity The entity whose transform data should be updated
+         */
+        static void MarkTransformDirty(ref<EntityManager> ecs, Entity entity);
+
+        /**
+         * Immediately updates the LocalTransformData and GlobalTransformData of all entities
+         * whose transform was marked as changed and of all their children.
+         * Entities below another marked entity are updated together with it instead of separately.
+         * Must not be called while iterating over entities.
+         * @param ecs The entity manager the entities are contained in
+         */
+        static void UpdateDirtyTransforms(ref<EntityManager> ecs);
+
         /**
          * For a given entity, execute the given function for it and all its children
          * (deep search, includes children of children etc)
@@ -29,5 +48,16 @@ namespace modulith{
          * @param fn The function that is called for every entity
          */
         static void ForAllChildren(ref<EntityManager> ecs, Entity entity, const std::function<void(ref<EntityManager>, Entity)>& fn);
+
+    private:
+        /**
+         * Calculates the LocalTransformData of the given entity from its position, rotation and scale
+         */
+        static void updateLocalTransformOf(ref<EntityManager>& ecs, Entity entity);
+
+        /**
+         * @return Returns true if one of the (indirect) parents of the given entity is contained in the dirty entities
+         */
+        static bool hasDirtyAncestor(ref<EntityManager>& ecs, Entity entity, const EntitySet& dirtyEntities);
     };
 }
@@ -0,0 +1,96 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include "Renderer.h"
+#include "spatial/Bounds.h"
+
+namespace modulith {
+
+    /**
+     * Assigns point lights to the objects they reach, by testing the range of every light against the bounds of an object.
+     * The lights are sorted into a uniform grid of cubic cells, where every light is stored in all cells its range overlaps.
+     * An object only tests the lights of the cells its bounds overlap, so scenes with hundreds of lights
+     * do not test every light for every object.
+     *
+     * Lights without a range reach everything, so they are assigned to every object.
+     * Lights with a range much larger than a cell are not stored in the cells, but tested for every object,
+     * so a few large lights do not fill a large part of the grid.
+     */
+    class CORE_API LightGrid {
+    public:
+
+        /**
+         * Removes all lights and sorts the given lights into the grid.
+         * The edge length of a cell is the median range of the lights, which keeps the cells small
+         * even if a few lights have a much larger range than the others.
+         * @param lights The lights, whose positions are in the same space as the bounds they are tested against
+         */
+        void Build(const Renderer::PointLight* lights, size_t count);
+
+        /**
+         * Finds the lights whose range intersects the given bounds
+         * @param indices Receives the indices of the lights in the array passed to Build, sorted by the distance
+         * of the lights to the center of the bounds
+         * @param maxCount The maximum amount of lights written to indices, at most Renderer::MaxLightsPerObject.
+         * Farther lights are dropped.
+         * @return Returns the amount of lights written to indices
+         */
+        size_t Assign(const Bounds& bounds, uint32_t* indices, size_t maxCount);
+
+        /**
+         * @return Returns the amount of lights in the grid
+         */
+        [[nodiscard]] size_t Size() const { return _lights.size(); }
+
+        /**
+         * Lights with a range larger than this many cells are tested for every object instead of being stored in the cells
+         */
+        static constexpr float LargeLightCellCount = 2.0f;
+
+    private:
+        /**
+         * The range of _cellLights that belongs to one cell
+         */
+        struct CellRange {
+            uint32_t Begin;
+            uint32_t End;
+            int3 Cell;
+        };
+
+        /**
+         * Tests a light against the bounds and inserts it into the sorted candidates if it is among the closest ones
+         */
+        void testLight(uint32_t light, const Bounds& bounds, uint32_t* indices, float* distances, size_t& count, size_t maxCount);
+
+        [[nodiscard]] int3 cellOf(const float3& position) const;
+
+        /**
+         * Packs the 21 lower bits of each cell coordinate into a single key, like the SpatialHashGrid does
+         */
+        [[nodiscard]] static uint64_t keyOf(const int3& cell);
+
+        /**
+         * Unpacks the cell coordinates from a key created by keyOf
+         */
+        [[nodiscard]] static int3 cellOfKey(uint64_t key);
+
+        float _inverseCellSize = 1.0f;
+
+        std::vector<Renderer::PointLight> _lights{};
+        // The lights without a range and the ones larger than LargeLightCellCount cells, which are tested for every object
+        std::vector<uint32_t> _unboundedLights{};
+
+        // The lights of every cell, sorted by the key of the cell
+        std::vector<std::pair<uint64_t, uint32_t>> _cellLights{};
+        std::unordered_map<uint64_t, CellRange> _cells{};
+
+        // A light overlapping several cells of the bounds is only tested once, when its mark differs from the current one
+        std::vector<uint32_t> _lightMarks{};
+        uint32_t _currentMark = 0;
+    };
+}
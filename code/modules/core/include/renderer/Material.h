@@ -26,6 +26,10 @@ namespace modulith{
          * The name of the uniform variable, by which it can be accessed
          */
         std::string UniformName;
+        /**
+         * The id of the uniform variable, by which it is uploaded
+         */
+        UniformId Id;
         /**
          * The type of the uniform variable
          */
@@ -70,10 +74,28 @@ namespace modulith{
          */
         virtual void UploadUniforms();
 
-        shared<Shader> GetShader() { return _shader; }
+        [[nodiscard]] const shared<Shader>& GetShader() const { return _shader; }
+
+        /**
+         * @return Returns the material that is bound to draw this material.
+         * Draws of all materials sharing the same base material are batched together.
+         */
+        virtual Material& GetBaseMaterial() { return *this; }
+
+        /**
+         * @return Returns the color the base material is tinted with when drawing this material.
+         * Instanced shaders read it from the per instance attribute "a_Color", others from the uniform "u_InstanceColor".
+         */
+        [[nodiscard]] virtual float4 GetInstanceColor() const { return float4(1.0f); }
+
+        /**
+         * @return Returns the id by which draws using this material are grouped in the RenderQueue
+         */
+        [[nodiscard]] uint32_t GetSortId() const { return _sortId; }
 
     private:
         std::vector<ShaderUniform> _data{};
+        uint32_t _sortId = RenderQueue::NextSortId(RenderQueue::SortIdKind::Material);
     protected:
         shared<Shader> _shader;
     };
@@ -0,0 +1,44 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+# pragma once
+
+#include <CoreModule.h>
+#include "Material.h"
+
+namespace modulith{
+
+    /**
+     * A material that shares the shader and all uniforms of a base material and only differs in its color.
+     * Unlike separate materials, draws of all instances of the same base material are batched together,
+     * since the color is passed as per instance data instead of as a uniform.
+     */
+    class CORE_API MaterialInstance : public Material {
+    public:
+        /**
+         * Creates an instance of the base material, which is tinted with the given color
+         */
+        MaterialInstance(shared<Material> baseMaterial, const float4& color)
+            : Material(baseMaterial->GetShader()), Color(color), _baseMaterial(std::move(baseMaterial)) {}
+
+        Material& GetBaseMaterial() override { return _baseMaterial->GetBaseMaterial(); }
+
+        [[nodiscard]] float4 GetInstanceColor() const override { return Color * _baseMaterial->GetInstanceColor(); }
+
+        /**
+         * Only uploads the uniforms of the base material, since the color is passed per instance
+         */
+        void UploadUniforms() override { _baseMaterial->UploadUniforms(); }
+
+        /**
+         * The color the base material is tinted with. Unlike the uniforms of the base material,
+         * this can be changed without affecting the other instances.
+         */
+        float4 Color;
+
+    private:
+        shared<Material> _baseMaterial;
+    };
+}
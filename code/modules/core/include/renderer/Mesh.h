@@ -7,11 +7,14 @@
 
 #include <CoreModule.h>
 #include <renderer/primitives/VertexArray.h>
+#include <spatial/Bounds.h>
 
 namespace modulith{
 
     class Renderer;
+    class RenderCommandList;
     class RenderContext;
+    class RendererAPI;
 
     /**
      * The data of a mesh's single vertex
@@ -34,24 +37,117 @@ namespace modulith{
     };
 
     /**
-     * The rendering-api independent implementation of a mesh
+     * The data of a mesh's single vertex in the compact vertex format, which needs half the memory of a Vertex.
+     * Positions and tex coords are stored relative to the range of the mesh's vertices,
+     * which the renderer reverts with the mesh's dequantization.
+     */
+    struct CORE_API CompactVertex{
+        /**
+         * The position as half floats, where -1 and 1 are the minimum and maximum of the mesh's bounds.
+         * The fourth component is padding.
+         */
+        uint16_t Position[4];
+
+        /**
+         * The normal encoded on an octahedron as signed normalized shorts, see EncodeNormal
+         */
+        int16_t Normal[2];
+
+        /**
+         * The tex coords as unsigned normalized shorts, where 0 and 1 are the minimum and maximum of the mesh's tex coords
+         */
+        uint16_t TexCoords[2];
+
+        /**
+         * Projects a unit vector onto an octahedron, whose lower half is folded over the upper one, so it is stored
+         * in two components with an error of a few thousandths of a degree
+         */
+        static void EncodeNormal(const float3& normal, int16_t* encoded);
+
+        /**
+         * Reverts EncodeNormal, like the shaders do for meshes in the compact vertex format
+         */
+        static float3 DecodeNormal(const int16_t* encoded);
+    };
+
+    /**
+     * How the vertices of a mesh are stored on the GPU
+     */
+    enum class VertexFormat {
+        /**
+         * Every attribute is stored as 32 bit floats, see Vertex
+         */
+        Full,
+        /**
+         * Half float positions, octahedral normals and 16 bit tex coords, see CompactVertex.
+         * The positions keep a precision of about a thousandth of the mesh's size, which suits props and characters,
+         * but not large level geometry.
+         */
+        Compact
+    };
+
+    /**
+     * Whether a mesh keeps a copy of its vertices and indices in main memory after uploading them to the GPU
+     */
+    enum class MeshResidency {
+        /**
+         * Only the bounds and counts are kept, the vertices and indices are freed once they were uploaded
+         */
+        GpuOnly,
+        /**
+         * The vertices and indices are kept, so they can be read with GetVertices and GetIndices
+         */
+        CpuReadable
+    };
+
+    /**
+     * The rendering-api independent implementation of a mesh.
+     * By default, meshes only keep their data on the GPU, see MeshResidency.
      */
     class CORE_API Mesh{
         friend Renderer;
+        friend RenderCommandList;
 
     public:
+        /**
+         * A simpler version of a mesh, which is drawn instead of it when it covers only a small part of the screen
+         */
+        struct Lod {
+            shared<Mesh> LodMesh;
+            /**
+             * The lod is used when the bounding sphere of the object covers less than this fraction of the screen height
+             */
+            float ScreenSize;
+        };
+
         /**
          * Creates a mesh from the given vertex positions, normals and indices
          */
-        Mesh(const std::vector<float3>& positions, const std::vector<float3>& normals, std::vector<uint32_t> indices);
+        Mesh(
+            const std::vector<float3>& positions, const std::vector<float3>& normals, std::vector<uint32_t> indices,
+            MeshResidency residency = MeshResidency::GpuOnly
+        );
         /**
-         * Copies another mesh by deep copying all its vertices and indices
+         * Copies another mesh, which shares the GPU buffers of the other mesh instead of uploading its data again.
+         * Meshes are never changed after their creation, so the copy behaves like a deep copy.
+         * The vertices and indices are only copied if the other mesh is CPU readable.
          */
         explicit Mesh(const shared<Mesh>& other);
         /**
          * Creates a mesh from the given vertices and indices
          */
-        Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+        Mesh(
+            const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, MeshResidency residency = MeshResidency::GpuOnly,
+            VertexFormat format = VertexFormat::Full
+        );
+        /**
+         * Creates a mesh from the given vertices and indices, whose vertex array is created by the given renderer API
+         * instead of the one of the RenderContext
+         */
+        Mesh(
+            const shared<RendererAPI>& rendererAPI, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+            MeshResidency residency = MeshResidency::GpuOnly, VertexFormat format = VertexFormat::Full
+        );
 
         ~Mesh();
 
@@ -68,22 +164,109 @@ namespace modulith{
         /**
          * @return Returns the vertices in the mesh
          */
-        [[nodiscard]] uint64_t VertexCount() const { return _vertices.size(); }
+        [[nodiscard]] uint64_t VertexCount() const { return _vertexCount; }
 
         /**
          * @return Returns the indices in the mesh. The triangle count is generally a third of this value.
          */
-        [[nodiscard]] uint64_t IndexCount() const { return _indices.size(); }
+        [[nodiscard]] uint64_t IndexCount() const { return _indexCount; }
+
+        [[nodiscard]] VertexFormat GetVertexFormat() const { return _format; }
+
+        /**
+         * @return Returns the transform from the quantized positions of the vertex buffer to object space,
+         * which the renderer applies before the model matrix. It is the identity for meshes in the full vertex format.
+         */
+        [[nodiscard]] float4x4 GetPositionDequantization() const;
+
+        /**
+         * @return Returns the scale (xy) and offset (zw) from the quantized tex coords of the vertex buffer to the tex coords
+         * of the mesh. It is a scale of one and no offset for meshes in the full vertex format.
+         */
+        [[nodiscard]] const float4& GetTexCoordTransform() const { return _texCoordTransform; }
+
+        /**
+         * @return Returns whether the mesh still has its vertices and indices in main memory
+         */
+        [[nodiscard]] bool IsCpuReadable() const { return _residency == MeshResidency::CpuReadable; }
+
+        /**
+         * @return Returns the vertices of the mesh, which is only allowed for CPU readable meshes
+         */
+        [[nodiscard]] const std::vector<Vertex>& GetVertices() const;
+
+        /**
+         * @return Returns the indices of the mesh, which is only allowed for CPU readable meshes
+         */
+        [[nodiscard]] const std::vector<uint32_t>& GetIndices() const;
+
+        /**
+         * Frees the vertices and indices in main memory, which makes the mesh GPU only.
+         * Useful for meshes that only had to be CPU readable while being processed after loading, e.g. to generate lods.
+         */
+        void ReleaseCpuData();
+
+        /**
+         * @return Returns the bounds of all vertices in object space, which are calculated when the mesh is created
+         */
+        [[nodiscard]] const Bounds& LocalBounds() const { return _localBounds; }
+
+        /**
+         * Adds a level of detail to the mesh, which replaces the mesh when it covers less than the screen size
+         * @param mesh The simplified mesh. It must not have lods itself.
+         * @param screenSize The fraction of the screen height, below which the lod is used
+         */
+        void AddLod(const shared<Mesh>& mesh, float screenSize);
+
+        /**
+         * Generates a chain of lods by simplifying the mesh with MeshSimplifier::ClusterVertices.
+         * Only CPU readable meshes can be simplified, the generated lods are GPU only and use the mesh's vertex format.
+         * Every level clusters the vertices in coarser cells and is used at half the screen size of the previous one.
+         * Levels that barely reduce the triangle count are skipped.
+         * @param levelCount The maximum amount of lods generated
+         * @param firstScreenSize The screen size below which the first lod is used
+         */
+        void GenerateLods(int levelCount, float firstScreenSize = 0.25f);
+
+        /**
+         * Generates a chain of lods like GenerateLods, whose vertex arrays are created by the given renderer API
+         * instead of the one of the RenderContext
+         */
+        void GenerateLods(const shared<RendererAPI>& rendererAPI, int levelCount, float firstScreenSize = 0.25f);
+
+        /**
+         * @return Returns the lods of the mesh, sorted from the most to the least detailed one
+         */
+        [[nodiscard]] const std::vector<Lod>& GetLods() const { return _lods; }
+
+        /**
+         * @param screenSize The fraction of the screen height covered by the bounding sphere of the object
+         * @return Returns the least detailed lod whose screen size is above the given one, or this mesh if there is none
+         */
+        [[nodiscard]] const Mesh& SelectLod(float screenSize) const;
 
     private:
 
         static shared<Mesh> _standardCube;
 
-        void generateVertexArray();
+        void generateVertexArray(
+            const shared<RendererAPI>& renderingAPI, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices
+        );
+        shared<VertexBuffer> createCompactVertexBuffer(const shared<RendererAPI>& renderingAPI, const std::vector<Vertex>& vertices);
 
+        MeshResidency _residency;
+        VertexFormat _format = VertexFormat::Full;
+        float4 _texCoordTransform{1.0f, 1.0f, 0.0f, 0.0f};
+        uint64_t _vertexCount = 0;
+        uint64_t _indexCount = 0;
+
+        // Empty unless the mesh is CPU readable
         std::vector<Vertex> _vertices{};
         std::vector<uint32_t> _indices{};
 
+        Bounds _localBounds{};
+        std::vector<Lod> _lods{};
+
         shared<VertexArray> _vertexArray = nullptr;
     };
 }
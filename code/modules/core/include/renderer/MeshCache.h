@@ -0,0 +1,93 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include "Mesh.h"
+
+namespace modulith {
+
+    /**
+     * A submesh of a model as it was imported, before it is uploaded to the GPU
+     */
+    struct CORE_API CookedSubmesh {
+        std::vector<Vertex> Vertices{};
+        std::vector<uint32_t> Indices{};
+
+        /**
+         * The index of the submesh's material in CookedModel::Materials
+         */
+        uint32_t MaterialIndex = 0;
+    };
+
+    /**
+     * The properties of a StandardMaterial as they were imported
+     */
+    struct CORE_API CookedMaterial {
+        float4 DiffuseColor = float4(0.0f, 0.0f, 0.0f, 1.0f);
+        float4 SpecularColor = float4(0.0f, 0.0f, 0.0f, 1.0f);
+
+        /**
+         * The paths of the textures relative to the model file, or empty if the material has no texture
+         */
+        std::string DiffuseTexture{};
+        std::string SpecularTexture{};
+    };
+
+    /**
+     * Everything needed to create the meshes and materials of a model file without parsing it again
+     */
+    struct CORE_API CookedModel {
+        std::vector<CookedSubmesh> Submeshes{};
+        std::vector<CookedMaterial> Materials{};
+
+        /**
+         * The files besides the source that were read while importing it, e.g. material libraries.
+         * Changing any of them invalidates the cooked file, like changing the source does.
+         */
+        std::vector<std::filesystem::path> Dependencies{};
+    };
+
+    /**
+     * Stores imported models in a binary format, so they are loaded with a single read instead of being parsed again.
+     * Every cooked file contains the stamps of its source and its dependencies, which are compared when it is read,
+     * so changing the model file, a file it references or the settings it was imported with invalidates it.
+     */
+    class CORE_API MeshCache {
+    public:
+
+        /**
+         * Increased whenever the layout of cooked files or the Vertex struct changes, which invalidates all of them
+         */
+        static constexpr uint32_t FormatVersion = 2;
+
+        /**
+         * @param importKey Identifies everything besides the source file that changes the cooked data, e.g. import settings
+         * @return Returns a hash of the size and modification time of the source file and the import key,
+         * or 0 if the source file does not exist
+         */
+        static uint64_t SourceStamp(const std::filesystem::path& sourcePath, uint64_t importKey);
+
+        /**
+         * @return Returns the path the cooked version of the source file is stored at, which is in the folder cache/meshes
+         * of the working directory, outside of any module's assets. Like the modules folder found by ModulePathUtils,
+         * this is next to the executable when the engine is started from its folder.
+         */
+        static std::filesystem::path CachePathFor(const std::filesystem::path& sourcePath);
+
+        /**
+         * @return Returns the cooked model, or nothing if the file does not exist, is damaged
+         * or was cooked from a source with a different stamp or from dependencies that changed since
+         */
+        static std::optional<CookedModel> Read(const std::filesystem::path& cachePath, uint64_t sourceStamp);
+
+        /**
+         * Writes the cooked model together with the current stamps of its dependencies, creating the folders of the path if needed
+         * @return Returns whether the file was written completely
+         */
+        static bool Write(const std::filesystem::path& cachePath, uint64_t sourceStamp, const CookedModel& model);
+    };
+}
@@ -0,0 +1,53 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include "Mesh.h"
+
+namespace modulith {
+
+    /**
+     * Reorders the triangles and vertices of meshes, so the GPU draws them faster without changing what is drawn.
+     * Every function is deterministic and only runs on the CPU, which is why meshes are optimized once while they are loaded.
+     */
+    class CORE_API MeshOptimizer {
+    public:
+
+        /**
+         * The amount of vertices in the simulated post transform cache, which is in the order of modern GPUs
+         */
+        static constexpr uint32_t CacheSize = 32;
+
+        /**
+         * Calculates the average cache miss ratio (ACMR) of the triangles, which is the amount of vertices
+         * transformed per triangle when drawing them with a FIFO post transform cache.
+         * It is between 0.5 for an ideal order of a large grid and 3 if no vertex is ever reused.
+         * @return Returns 0 if there are no triangles
+         */
+        static float CalculateAcmr(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize = CacheSize);
+
+        /**
+         * Reorders the triangles for the post transform cache with Tom Forsyth's linear-speed vertex cache optimization.
+         * Triangles keep their winding, only their order changes.
+         */
+        static void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+        /**
+         * Sorts clusters of triangles, so the ones facing away from the center of the mesh come first
+         * and occlude the inner ones, which reduces overdraw. Call this after OptimizeVertexCache,
+         * since clusters of consecutive triangles keep most of their cache efficiency.
+         * @param clusterSize The amount of consecutive triangles moved together
+         */
+        static void OptimizeOverdraw(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, uint32_t clusterSize = 64);
+
+        /**
+         * Reorders the vertices by their first use in the triangles, so they are fetched from memory sequentially.
+         * Vertices not used by any triangle are removed. Call this after reordering the triangles.
+         */
+        static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+    };
+}
@@ -0,0 +1,34 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include "Mesh.h"
+
+namespace modulith {
+
+    /**
+     * Reduces the triangle count of meshes, which is used to generate the levels of detail of a mesh when it is loaded
+     */
+    class CORE_API MeshSimplifier {
+    public:
+
+        /**
+         * Simplifies a mesh by vertex clustering: All vertices inside the same cubic cell of a grid are merged into
+         * a single vertex at their average position, and triangles that collapse by the merge are removed.
+         * Vertices on different sides of a UV seam are merged into separate vertices at the same position,
+         * so their texture coordinates are not averaged across the seam.
+         * This is fast and never fails, but does not preserve the silhouette as well as edge collapsing would.
+         * @param cellSize The edge length of a cell. Details smaller than it are removed.
+         * @param outVertices Receives the merged vertices, it is cleared first
+         * @param outIndices Receives the remaining triangles, it is cleared first
+         */
+        static void ClusterVertices(
+            const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, float cellSize,
+            std::vector<Vertex>& outVertices, std::vector<uint32_t>& outIndices
+        );
+    };
+}
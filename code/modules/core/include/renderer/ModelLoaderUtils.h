@@ -27,15 +27,47 @@ namespace modulith{
         shared<Material> Material;
     };
 
+    /**
+     * How the meshes of a model file are processed while they are loaded
+     */
+    struct CORE_API MeshImportSettings {
+        /**
+         * The maximum amount of lods generated for every mesh, see Mesh::GenerateLods
+         */
+        int LodLevels = 0;
+
+        /**
+         * The format the vertices of every mesh and its lods are stored in on the GPU
+         */
+        VertexFormat Format = VertexFormat::Full;
+
+        /**
+         * Whether the triangles and vertices of every mesh are reordered for the post transform cache and for sequential
+         * vertex fetches, see MeshOptimizer. The ACMR before and after the optimization is logged per mesh.
+         */
+        bool OptimizeVertexCache = true;
+
+        /**
+         * Whether clusters of triangles are additionally sorted to reduce overdraw, which slightly increases the ACMR
+         */
+        bool OptimizeOverdraw = false;
+
+        /**
+         * Whether the imported meshes and materials are stored in a cooked file, see MeshCache.
+         * Later imports of the same unchanged file with the same optimizations read the cooked file instead of parsing it.
+         */
+        bool UseCache = true;
+    };
+
     class CORE_API ModelLoaderUtils {
 
     public:
 
-        static shared<Mesh> LoadSingleFromFile(const Address& address);
+        static shared<Mesh> LoadSingleFromFile(const Address& address, const MeshImportSettings& settings = {});
 
-        static std::vector<shared<Mesh>> LoadMeshesFromFile(const Address& address);
+        static std::vector<shared<Mesh>> LoadMeshesFromFile(const Address& address, const MeshImportSettings& settings = {});
 
-        static std::vector<Model> LoadSceneFromFile(const Address& address);
+        static std::vector<Model> LoadSceneFromFile(const Address& address, const MeshImportSettings& settings = {});
 
     };
 
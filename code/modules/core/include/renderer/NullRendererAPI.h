@@ -0,0 +1,121 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include "RendererAPI.h"
+
+namespace modulith {
+
+    /**
+     * Counts the work a NullRendererAPI and the primitives it created were asked to do
+     */
+    struct NullRendererStats {
+        uint32_t DrawCalls = 0;
+        uint32_t InstancedDrawCalls = 0;
+        /**
+         * The amount of instances drawn, where every non-instanced draw call draws a single instance
+         */
+        uint64_t DrawnInstances = 0;
+        /**
+         * The amount of indices drawn over all instances
+         */
+        uint64_t DrawnIndices = 0;
+
+        uint64_t VertexBufferBytes = 0;
+        uint64_t IndexBufferBytes = 0;
+        uint64_t UniformBufferBytes = 0;
+        /**
+         * The size of all uniform values uploaded to shaders, without the uploads that were skipped as redundant
+         */
+        uint64_t UniformBytes = 0;
+
+        uint32_t CreatedVertexBuffers = 0;
+        uint32_t CreatedIndexBuffers = 0;
+        uint32_t CreatedUniformBuffers = 0;
+        uint32_t CreatedVertexArrays = 0;
+        uint32_t CreatedShaders = 0;
+        uint32_t CreatedTextures = 0;
+        uint32_t CreatedFrameBuffers = 0;
+    };
+
+    struct NullRendererState;
+
+    /**
+     * A renderer API that does not draw anything and does not need a graphics context.
+     * Its primitives only record what they were asked to do, so the whole render submission path
+     * can be tested and benchmarked on machines without a GPU.
+     *
+     * Binds and uniform uploads are filtered by a RenderStateCache like in the other APIs,
+     * so the state counters are comparable.
+     * It is used instead of OpenGL when the preference "RendererAPI" is set to "Null",
+     * together with a NullWindow, so no window or graphics context is created.
+     */
+    class CORE_API NullRendererAPI : public RendererAPI {
+    public:
+        /**
+         * @param shadersFromFilesAreInstanced The files of shaders created from an address are not read,
+         * so this decides whether they read their per instance data from vertex attributes
+         * like the engine's PhongShader does. Every uniform of these shaders is assumed to be declared.
+         */
+        explicit NullRendererAPI(bool shadersFromFilesAreInstanced = true);
+
+        void Init() override {}
+
+        void SetClearColor(const glm::vec4& color) override {}
+
+        void Clear() override {}
+
+        void SetViewport(int2 size) override {}
+
+        void DrawIndexed(const shared<VertexArray>& vertexArray) override;
+
+        void DrawIndexedInstanced(const shared<VertexArray>& vertexArray, uint32_t instanceCount) override;
+
+        shared<VertexBuffer> CreateVertexBuffer(float* vertices, uint32_t size) override;
+
+        shared<VertexBuffer> CreateVertexBuffer(void* vertexData, uint32_t size) override;
+
+        shared<IndexBuffer> CreateIndexBuffer(uint32_t* indices, uint32_t count) override;
+
+        shared<UniformBuffer> CreateUniformBuffer(uint32_t bindingPoint) override;
+
+        shared<VertexArray> CreateVertexArray() override;
+
+        shared<Shader> CreateShader(const Address& address) override;
+
+        /**
+         * Creates a shader, which is instanced if its vertex source declares the attribute a_M.
+         * Like in OpenGL, uploads to uniforms that are not declared in its sources are ignored.
+         */
+        shared<Shader> CreateShader(
+            const std::string& name, const std::string& vertexSource, const std::string& fragmentSource
+        ) override;
+
+        shared<Texture2D> CreateTexture2D(const Address& address) override;
+
+        shared<FrameBuffer> CreateFrameBuffer(int2 size) override;
+
+        void InvalidateState() override;
+
+        [[nodiscard]] RenderStateCounters GetStateCounters() const override;
+
+        void ResetStateCounters() override;
+
+        /**
+         * @return Returns what was recorded since the creation of the API or the last call of ResetStats
+         */
+        [[nodiscard]] const NullRendererStats& GetStats() const;
+
+        void ResetStats();
+
+    private:
+        bool _shadersFromFilesAreInstanced;
+
+        // Shared with every primitive created by this API, so they can record their work after the API was destroyed
+        shared<NullRendererState> _state;
+    };
+}
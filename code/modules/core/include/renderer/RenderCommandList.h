@@ -0,0 +1,163 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include "Renderer.h"
+#include "LightGrid.h"
+
+namespace modulith {
+
+    /**
+     * The CPU side of rendering a scene, which collects the objects seen by a camera
+     * and turns them into a list of draw commands: The draws are sorted and batched,
+     * their per instance data is calculated and the scene uniforms are packed.
+     * Every object is assigned the closest point lights reaching its bounds, whose indices are part of its instance data.
+     *
+     * Building a list never calls the renderer API, so lists can be built on any thread
+     * and executed later by Renderer::Execute on the thread owning the API.
+     * The submitted materials and meshes are not copied, so they must be kept alive until the list was executed.
+     */
+    class CORE_API RenderCommandList {
+    public:
+
+        /**
+         * The per instance data read by instanced shaders, matching the layout of the renderer's instance buffer
+         */
+        struct InstanceData {
+            /**
+             * The model matrix, which includes the position dequantization of meshes in the compact vertex format
+             */
+            float4x4 Model;
+            float4x4 Normal;
+            float4 Color;
+            /**
+             * The indices of the point lights affecting the instance in the scene uniform block, sorted from the closest
+             * to the farthest light. Unused entries are -1.
+             */
+            float4 LightIndices;
+        };
+
+        /**
+         * Draws a mesh with a material once per instance.
+         * Commands sharing a material or vertex array are adjacent, so they only need to be bound once.
+         */
+        struct Command {
+            /**
+             * The base material, whose shader and uniforms are bound for the draw
+             */
+            Material* DrawMaterial;
+            const Mesh* DrawMesh;
+
+            /**
+             * The range of the command's instances in the instance data of the list
+             */
+            uint32_t FirstInstance;
+            uint32_t InstanceCount;
+
+            /**
+             * Whether all instances are drawn with a single instanced draw call, or with a draw call each
+             */
+            bool IsInstanced;
+        };
+
+        /**
+         * Clears the list and begins a new scene rendered by a camera
+         * @param projectionMatrix The projection matrix of the camera
+         * @param viewMatrix The view matrix of the camera
+         * @param cameraPosition The position of the camera in worldspace
+         * @param directionalLight The directional light to be rendered
+         * @param pointLights The point lights to be rendered, of which the closest Renderer::MaxLights are used
+         */
+        void Begin(
+            const float4x4& projectionMatrix, const float4x4& viewMatrix, const float3& cameraPosition,
+            const std::optional<Renderer::DirectionalLight>& directionalLight, std::vector<Renderer::PointLight> pointLights
+        );
+
+        /**
+         * Adds a command drawing a single object, without batching it with any other objects.
+         * Like deferred objects, the object is drawn with the lod of its mesh that matches its size on the screen.
+         * These commands are executed in the order of their submission, before all deferred draws.
+         */
+        void SubmitImmediately(const shared<Material>& material, const shared<Mesh>& mesh, const float4x4& transform);
+
+        /**
+         * Adds an object, which is sorted and batched with all other deferred objects once the list is finished.
+         * If the mesh has lods, the one matching the size of the object on the screen is drawn instead of it.
+         * @param inverseTransform The inverse of the transform, which is needed for the normal matrix
+         */
+        void SubmitDeferred(
+            const shared<Material>& material, const shared<Mesh>& mesh, const float4x4& transform, const float4x4& inverseTransform
+        );
+
+        /**
+         * Sorts and batches the deferred objects, which completes the list for its execution
+         */
+        void Finish();
+
+        [[nodiscard]] const std::vector<Command>& GetCommands() const { return _commands; }
+
+        [[nodiscard]] const std::vector<InstanceData>& GetInstances() const { return _instances; }
+
+        /**
+         * @return Returns the data of the scene uniform block in its std140 layout
+         */
+        [[nodiscard]] const Std140Writer& GetSceneUniforms() const { return _sceneUniforms; }
+
+        /**
+         * @return Returns the statistics about the submitted objects.
+         * The statistics about the batches are added when the list is executed.
+         */
+        [[nodiscard]] const Renderer::SceneStats& GetStats() const { return _stats; }
+
+    private:
+        InstanceData makeInstance(
+            const Mesh& mesh, const float4x4& matrix, const float4x4& inverseMatrix, const float4& color, const float4& lightIndices
+        ) const;
+
+        /**
+         * @return Returns the indices of the lights reaching the world bounds of an object
+         */
+        float4 assignLights(const Bounds& worldBounds);
+
+        /**
+         * @return Returns the lod of the mesh matching the size of the object's world bounds on the screen
+         */
+        const Mesh& selectLod(const Mesh& mesh, const Bounds& worldBounds);
+
+        /**
+         * The data of a deferred draw, referenced by the payload of its entry in the render queue
+         */
+        struct DeferredDraw {
+            /**
+             * The base material of the submitted material, so instances of it are batched together
+             */
+            Material* DrawMaterial;
+            const Mesh* DrawMesh;
+            float4x4 Matrix;
+            float4x4 InverseMatrix;
+            float4 Color;
+            float4 LightIndices;
+        };
+
+        float4x4 _viewMatrix{1.0f};
+        float4x4 _inverseViewMatrix{1.0f};
+        float3 _cameraPosition{0.0f};
+        // The screen size of a sphere is its radius times this scale, divided by its distance for perspective projections
+        float _lodScale = 1.0f;
+        bool _isPerspective = true;
+        Renderer::SceneStats _stats{};
+
+        // Kept between scenes, so their memory is reused
+        RenderQueue _renderQueue{};
+        std::vector<DeferredDraw> _deferredDraws{};
+        LightGrid _lightGrid{};
+
+        std::vector<Command> _commands{};
+        std::vector<InstanceData> _instances{};
+        Std140Writer _sceneUniforms{};
+    };
+}
@@ -68,6 +68,8 @@ namespace modulith {
         void OnBeforeUnloadModules(const std::vector<Module>& modules) override;
 
     private:
+        // Set when the null renderer API is used, in which case no window or graphics context is created
+        bool _isHeadless;
 
         owned<Renderer> _renderer;
         owned<ShaderLibrary> _shaderLibrary;
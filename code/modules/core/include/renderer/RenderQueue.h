@@ -0,0 +1,82 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+
+namespace modulith {
+
+    /**
+     * A flat list of draws, each identified by a 64 bit sort key and the index of its payload.
+     * Sorting the keys orders the draws by shader, material, vertex array and finally by depth,
+     * so state changes are minimized and the order does not depend on the order of submission.
+     *
+     * The layout of a key from the most to the least significant bits is:
+     * | shader (10) | material (14) | vertex array (20) | depth (20) |
+     * Ids that do not fit into their bits are wrapped around. This only worsens the grouping, never the result.
+     */
+    class CORE_API RenderQueue {
+    public:
+
+        /**
+         * A draw in the queue
+         */
+        struct Entry {
+            uint64_t Key;
+            /**
+             * The index of the draw's data, which is stored by the owner of the queue
+             */
+            uint32_t Payload;
+        };
+
+        /**
+         * The kinds of objects encoded into a sort key, each of which has its own ids
+         */
+        enum class SortIdKind {
+            Shader,
+            Material,
+            VertexArray
+        };
+
+        /**
+         * @return Returns a new id for an object of the given kind, which wraps around at the width of its field in the key.
+         * Shaders, materials and vertex arrays take one on creation, so they can be encoded into sort keys.
+         * Every kind counts separately, so creating many meshes does not use up the few ids of the shaders.
+         */
+        static uint32_t NextSortId(SortIdKind kind);
+
+        /**
+         * Creates the sort key of a draw
+         * @param depth The distance of the draw to the camera. Negative distances are treated as zero.
+         * Closer draws are sorted first, if their state is the same.
+         */
+        static uint64_t MakeKey(uint32_t shaderId, uint32_t materialId, uint32_t vertexArrayId, float depth);
+
+        /**
+         * Adds a draw to the queue
+         */
+        void Push(uint64_t key, uint32_t payload) { _entries.push_back({key, payload}); }
+
+        /**
+         * Sorts the draws by their key using a radix sort.
+         * Draws with the same key keep the order in which they were pushed.
+         */
+        void Sort();
+
+        /**
+         * Removes all draws, but keeps the allocated memory
+         */
+        void Clear() { _entries.clear(); }
+
+        [[nodiscard]] const std::vector<Entry>& GetEntries() const { return _entries; }
+
+        [[nodiscard]] size_t Size() const { return _entries.size(); }
+
+    private:
+        std::vector<Entry> _entries;
+        std::vector<Entry> _sortBuffer;
+    };
+}
@@ -0,0 +1,137 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include <array>
+#include <limits>
+
+namespace modulith {
+
+    /**
+     * Counts the state changes a renderer API was asked to make, split into those that were issued
+     * and those that were skipped because the state was already set
+     */
+    struct RenderStateCounters {
+        uint32_t ProgramBinds = 0;
+        uint32_t SkippedProgramBinds = 0;
+
+        uint32_t VertexArrayBinds = 0;
+        uint32_t SkippedVertexArrayBinds = 0;
+
+        uint32_t TextureBinds = 0;
+        uint32_t SkippedTextureBinds = 0;
+
+        uint32_t UniformUploads = 0;
+        uint32_t SkippedUniformUploads = 0;
+
+        [[nodiscard]] RenderStateCounters CombineWith(const RenderStateCounters& other) const {
+            return RenderStateCounters{
+                ProgramBinds + other.ProgramBinds,
+                SkippedProgramBinds + other.SkippedProgramBinds,
+
+                VertexArrayBinds + other.VertexArrayBinds,
+                SkippedVertexArrayBinds + other.SkippedVertexArrayBinds,
+
+                TextureBinds + other.TextureBinds,
+                SkippedTextureBinds + other.SkippedTextureBinds,
+
+                UniformUploads + other.UniformUploads,
+                SkippedUniformUploads + other.SkippedUniformUploads,
+            };
+        }
+    };
+
+    /**
+     * Shadows the state that is bound in a renderer API, so redundant state changes can be skipped.
+     * The cache does not call the API itself: every function returns whether the change has to be issued
+     * and records the new state, so it does not need a context and can be used by any API.
+     *
+     * Objects are identified by the ids the API gave them.
+     * Whenever the state is changed without the cache, e.g. by ImGui, Invalidate has to be called.
+     */
+    class CORE_API RenderStateCache {
+    public:
+        /**
+         * How many texture units are shadowed. Binds to units above this are always issued.
+         */
+        static constexpr uint32_t MaxTextureUnits = 32;
+
+        /**
+         * How many bytes the value of a single uniform may have to be shadowed, which is the size of a 4x4 matrix.
+         * Larger uniforms are always uploaded.
+         */
+        static constexpr uint32_t MaxUniformSize = 64;
+
+        RenderStateCache() { Invalidate(); }
+
+        /**
+         * @return Returns whether the program has to be bound
+         */
+        bool BindProgram(uint32_t program);
+
+        /**
+         * @return Returns whether the vertex array has to be bound
+         */
+        bool BindVertexArray(uint32_t vertexArray);
+
+        /**
+         * @return Returns whether the texture has to be bound to the unit
+         */
+        bool BindTexture(uint32_t unit, uint32_t texture);
+
+        /**
+         * Uniforms are part of their program's state, so their values are shadowed per program
+         * and are kept when the program is unbound or the cache is invalidated.
+         * @param location The location of the uniform in the program. Negative locations are never uploaded.
+         * @return Returns whether the value has to be uploaded
+         */
+        bool SetUniform(uint32_t program, int32_t location, const void* value, uint32_t size);
+
+        /**
+         * Forgets the uniforms of a deleted program, since its id may be reused
+         */
+        void ForgetProgram(uint32_t program);
+
+        /**
+         * Forgets a deleted vertex array, since its id may be reused
+         */
+        void ForgetVertexArray(uint32_t vertexArray);
+
+        /**
+         * Forgets a deleted texture, since its id may be reused
+         */
+        void ForgetTexture(uint32_t texture);
+
+        /**
+         * Forgets which program, vertex array and textures are bound, so the next binds are issued again
+         */
+        void Invalidate();
+
+        [[nodiscard]] const RenderStateCounters& GetCounters() const { return _counters; }
+
+        void ResetCounters() { _counters = {}; }
+
+    private:
+        // Marks state that is not known, since no valid id is this large
+        static constexpr uint32_t unknown = std::numeric_limits<uint32_t>::max();
+
+        struct UniformValue {
+            // A size of zero marks values that were never uploaded
+            uint32_t Size = 0;
+            std::array<uint8_t, MaxUniformSize> Bytes{};
+        };
+
+        uint32_t _program{};
+        uint32_t _vertexArray{};
+        std::array<uint32_t, MaxTextureUnits> _textures{};
+
+        // The values of every program, indexed by their location
+        std::unordered_map<uint32_t, std::vector<UniformValue>> _uniforms{};
+
+        RenderStateCounters _counters{};
+    };
+}
@@ -10,13 +10,18 @@
 #include "renderer/primitives/Shader.h"
 #include "Mesh.h"
 #include "Material.h"
+#include "RenderQueue.h"
+#include "Std140Writer.h"
 
 namespace modulith{
 
     class RenderContext;
+    class RenderCommandList;
 
     /**
-     * The renderer collects information about the current scene and renders it
+     * The renderer executes render command lists with its renderer API.
+     * For convenience, it can also build and execute a list for a single scene with BeginScene, the submit functions
+     * and EndScene.
      */
     class CORE_API Renderer {
 
@@ -24,7 +29,23 @@ namespace modulith{
 
     public:
 
-        explicit Renderer(const shared<RendererAPI>& rendererAPI) : _api(rendererAPI){}
+        explicit Renderer(const shared<RendererAPI>& rendererAPI);
+
+        ~Renderer();
+
+        /**
+         * The maximum amount of point lights in a scene. If there are more, the closest lights to the camera are used.
+         * Available to shaders as MAX_LIGHTS.
+         */
+        static constexpr int MaxLights = 128;
+
+        /**
+         * The maximum amount of point lights that affect a single object.
+         * Every object is lit by the closest lights whose range reaches its bounds.
+         * Available to shaders as MAX_LIGHTS_PER_OBJECT.
+         */
+        static constexpr int MaxLightsPerObject = 4;
+        static_assert(MaxLightsPerObject <= 4, "The light indices of an instance are passed to shaders as a single vec4");
 
         /**
         * The data representation of a directional light
@@ -71,8 +92,9 @@ namespace modulith{
             uint32_t DeferredSubmits = 0;
 
             /**
-             * How many material batches were used when drawing deferred meshes.
-             * This is equal to the amount of unique materials submitted via DeferredSubmit
+             * How many material batches were used when drawing the scene.
+             * For deferred meshes, this is equal to the amount of unique base materials submitted via DeferredSubmit,
+             * since the draws are sorted by their base material
              */
             uint32_t MaterialBatches = 0;
             /**
@@ -81,9 +103,13 @@ namespace modulith{
              */
             uint32_t VertexArrayBatches = 0;
             /**
-             * The amount of draw calls made during batching.
+             * The amount of draw calls made when drawing the scene.
              */
             uint32_t BatchedDrawCalls = 0;
+            /**
+             * How many of the batched draw calls drew all instances of a batch at once
+             */
+            uint32_t InstancedDrawCalls = 0;
 
             /**
              * The total amount of vertices rendered
@@ -93,6 +119,15 @@ namespace modulith{
              * The total amount of triangles rendered
              */
             uint64_t Triangles = 0;
+            /**
+             * How many objects were drawn with one of the lods of their mesh instead of the mesh itself
+             */
+            uint32_t LodDraws = 0;
+
+            /**
+             * The state changes issued and skipped by the renderer API while drawing the scene
+             */
+            RenderStateCounters StateChanges{};
 
             [[nodiscard]] SceneStats CombineWith(const SceneStats& other) const{
                 return SceneStats {
@@ -102,13 +137,23 @@ namespace modulith{
                     MaterialBatches + other.MaterialBatches,
                     VertexArrayBatches + other.VertexArrayBatches,
                     BatchedDrawCalls + other.BatchedDrawCalls,
+                    InstancedDrawCalls + other.InstancedDrawCalls,
 
                     Vertices + other.Vertices,
                     Triangles + other.Triangles,
+                    LodDraws + other.LodDraws,
+
+                    StateChanges.CombineWith(other.StateChanges),
                 };
             }
         };
 
+        /**
+         * Binds the scene uniforms and draws the commands of a finished command list
+         * @return Returns the statistics of the list's scene
+         */
+        SceneStats Execute(const RenderCommandList& commandList);
+
         /**
          * Begins a scene rendered by a camera
          * @param projectionMatrix The projection matrix of the camera
@@ -120,7 +165,7 @@ namespace modulith{
         void BeginScene(glm::mat4 projectionMatrix, float4x4 viewMatrix, float3 cameraPosition, std::optional<DirectionalLight> directionalLight, std::vector<PointLight> pointLights);
 
         /**
-         * Submits an object to be rendered in the current scene immediately.
+         * Submits an object to be rendered in the current scene before all deferred objects, in the order of submission.
          * This will not make use of any batching optimizations!
          * @param material The material of the object
          * @param mesh The mesh of the object
@@ -131,7 +176,9 @@ namespace modulith{
 
         /**
          * Submits an object to be rendered in the current scene once EndScene is called.
-         * This call is more performant as it may make use of batching
+         * This call is more performant as it may make use of batching.
+         * If the material's shader is instanced, all objects with the same material and mesh are drawn with a single draw call.
+         * The material and mesh are not copied, so they must be kept alive until EndScene is called.
          * @param material The material of the object
          * @param mesh The mesh of the object
          * @param transform The worldspace to object space transform matrix of the object
@@ -139,7 +186,33 @@ namespace modulith{
         void SubmitDeferred(const shared<Material>& material, const shared<Mesh>& mesh, glm::mat4 transform);
 
         /**
-         * Ends the current scene, resetting all registered lights.
+         * Submits an object to be rendered in the current scene once EndScene is called.
+         * Prefer this overload when the inverse transform is already known (e.g. from the InverseGlobalTransformData),
+         * since it is needed for the normal matrix and otherwise calculated by the renderer.
+         * @param material The material of the object
+         * @param mesh The mesh of the object
+         * @param transform The worldspace to object space transform matrix of the object
+         * @param inverseTransform The inverse of the transform
+         */
+        void SubmitDeferred(
+            const shared<Material>& material, const shared<Mesh>& mesh, const glm::mat4& transform, const glm::mat4& inverseTransform
+        );
+
+        /**
+         * Packs the camera and lights of a scene in the std140 layout of the SceneUniformBlock, which is:
+         * mat4 u_P, mat4 u_V, vec3 u_CameraPosition, int u_LightCount,
+         * DirectionalLight u_DirectionalLight, PointLight u_Lights[MaxLights]
+         * @param writer The writer the data is written to. It is cleared first.
+         * @param viewSpaceLights The point lights, whose positions are already in view space
+         * @param lightCount The amount of point lights, at most MaxLights
+         */
+        static void PackSceneUniforms(
+            Std140Writer& writer, const float4x4& projectionMatrix, const float4x4& viewMatrix,
+            const std::optional<DirectionalLight>& directionalLight, const PointLight* viewSpaceLights, int lightCount
+        );
+
+        /**
+         * Ends the current scene, drawing all submitted objects and resetting all registered lights.
          */
         SceneStats EndScene();
 
@@ -147,49 +220,28 @@ namespace modulith{
 
     private:
 
-        void bindMaterial(const shared<Material>& shader);
-        void bindVertexArray(const shared<VertexArray>& vertexArray);
-        void drawVertexArray(const shared<Shader>& activeShader, const shared<VertexArray>& vertexArray, float4x4 matrix);
+        void bindMaterial(Material& material);
+        void bindMesh(const shared<Shader>& activeShader, const Mesh& mesh);
+        void drawVertexArray(
+            const shared<Shader>& activeShader, const shared<VertexArray>& vertexArray, const float4x4& matrix,
+            const float4x4& normalMatrix, const float4& color, const float4& lightIndices
+        );
+        void drawInstances(const shared<VertexArray>& vertexArray, const void* instances, uint32_t instanceCount);
 
         void initialize();
         void shutdown();
         void beginFrame();
         void endFrame();
 
-        struct VertexArrayBatch{
-            std::vector<float4x4> _matrices;
-        };
-
-        struct MaterialBatch{
-            std::unordered_map<shared<VertexArray>, VertexArrayBatch> _vertexArrayBatch{};
-        };
-
-        struct SceneData {
-            SceneStats Stats{};
-
-            float4x4 ProjectionMatrix;
-            float4x4 ViewMatrix;
-
-            std::optional<DirectionalLight> CurrentDirectionalLight{};
-            std::vector<PointLight> Lights{};
-            PointLight CurrentCameraLights[4];
-            int CurrentLightCount = 0;
-
-            std::unordered_map<shared<Material>, MaterialBatch> _batches{};
-        };
-
-        owned<SceneData> _sceneData;
-
-
-        void initTex(int2 initialTextureSize);
-        void resize(int2 newTextureSize);
-        void destroyTex();
+        // The list built by BeginScene, the submit functions and EndScene
+        owned<RenderCommandList> _commandList;
 
-        uint32_t _frameBuffer;
-        uint32_t _colorTex;
-        uint32_t _depthTex;
+        // The instances of every batch are uploaded to this buffer, which is shared by all vertex arrays
+        shared<VertexBuffer> _instanceBuffer = nullptr;
+        shared<UniformBuffer> _sceneUniformBuffer = nullptr;
 
-        int2 _currentImGuiFramebufferSize;
+        // Rendered into instead of the window while ImGui is enabled, so it can be shown in an ImGui window
+        shared<FrameBuffer> _frameBuffer = nullptr;
 
         shared<RendererAPI> _api;
     };
@@ -8,7 +8,9 @@
 #include "CoreModule.h"
 #include <renderer/primitives/Shader.h>
 #include <renderer/primitives/Texture.h>
+#include <renderer/primitives/FrameBuffer.h>
 #include "renderer/primitives/VertexArray.h"
+#include "renderer/RenderStateCache.h"
 #include <filesystem>
 #include <assets/AssetContext.h>
 
@@ -37,12 +39,26 @@ namespace modulith{
          */
         virtual void Clear() = 0;
 
+        /**
+         * Sets the area of the bound frame buffer or window that is rendered into, starting at its lower left corner
+         * @param size The width and height (in pixels) of the area
+         */
+        virtual void SetViewport(int2 size) = 0;
+
         /**
          * When called the currently bound vertex array should be rendered by the renderer API
          * @param vertexArray The vertexArray that is already bound which should be rendered
          */
         virtual void DrawIndexed(const shared<VertexArray>& vertexArray) = 0;
 
+        /**
+         * When called the currently bound vertex array should be rendered multiple times by the renderer API.
+         * Per instance data is read from the vertex buffers of the array whose layout is per instance.
+         * @param vertexArray The vertexArray that is already bound which should be rendered
+         * @param instanceCount How often the vertex array is drawn
+         */
+        virtual void DrawIndexedInstanced(const shared<VertexArray>& vertexArray, uint32_t instanceCount) = 0;
+
         /**
         * Creates a vertex buffer from the given vertices
         * @param vertices A pointer to an array of vertices
@@ -72,6 +88,12 @@ namespace modulith{
          */
         virtual shared<IndexBuffer> CreateIndexBuffer(uint32_t* indices, uint32_t count) = 0;
 
+        /**
+         * Creates an empty uniform buffer
+         * @param bindingPoint The binding point the buffer is bound to
+         */
+        virtual shared<UniformBuffer> CreateUniformBuffer(uint32_t bindingPoint) = 0;
+
         /**
          * Creates a vertex array based on the current rendering API
          */
@@ -95,6 +117,29 @@ namespace modulith{
          * Creates a 2D texture by loading the texture file at the given file path
          */
         virtual shared<Texture2D> CreateTexture2D(const Address& address) = 0;
+
+        /**
+         * Creates a frame buffer with a color and a depth attachment of the given size
+         * @param size The width and height (in pixels) of the attachments
+         */
+        virtual shared<FrameBuffer> CreateFrameBuffer(int2 size) = 0;
+
+        /**
+         * Forgets the state the API assumes to be bound, so the next state changes are issued again.
+         * This needs to be called after the state was changed without the API, e.g. by ImGui or direct API calls.
+         */
+        virtual void InvalidateState() {}
+
+        /**
+         * @return Returns how many state changes were issued and how many were skipped
+         * since the last call of ResetStateCounters. APIs that do not skip redundant state changes return no counts.
+         */
+        [[nodiscard]] virtual RenderStateCounters GetStateCounters() const { return {}; }
+
+        /**
+         * Resets the state change counters to zero
+         */
+        virtual void ResetStateCounters() {}
     };
 
 }
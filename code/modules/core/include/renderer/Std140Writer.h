@@ -0,0 +1,69 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+
+namespace modulith {
+
+    /**
+     * Packs values into a byte buffer following the std140 layout rules of GLSL uniform blocks,
+     * so the buffer can be uploaded to a uniform buffer as is.
+     *
+     * Values have to be written in the order in which they are declared in the block.
+     * Scalars are aligned to 4 bytes, two component vectors to 8 bytes and
+     * three or four component vectors, matrix columns and structs to 16 bytes.
+     */
+    class CORE_API Std140Writer {
+    public:
+
+        /**
+         * Writes a value at the next offset that satisfies its alignment
+         * @return Returns the offset (in bytes) the value was written to
+         */
+        size_t Write(float value);
+        size_t Write(int32_t value);
+        /**
+         * Booleans are stored as 4 byte integers
+         */
+        size_t Write(bool value);
+        size_t Write(const float2& value);
+        size_t Write(const float3& value);
+        size_t Write(const float4& value);
+        /**
+         * Matrices are stored as an array of their columns
+         */
+        size_t Write(const float4x4& value);
+
+        /**
+         * Starts a struct or an element of an array of structs, which are aligned to 16 bytes
+         */
+        void BeginStruct();
+
+        /**
+         * Ends a struct, whose size is rounded up to a multiple of 16 bytes
+         */
+        void EndStruct();
+
+        /**
+         * Removes all written values, but keeps the allocated memory
+         */
+        void Clear() { _data.clear(); }
+
+        [[nodiscard]] const uint8_t* GetData() const { return _data.data(); }
+
+        /**
+         * @return Returns the size (in bytes) of all written values, including padding
+         */
+        [[nodiscard]] size_t GetSize() const { return _data.size(); }
+
+    private:
+        size_t write(const void* value, size_t size, size_t alignment);
+        void align(size_t alignment);
+
+        std::vector<uint8_t> _data;
+    };
+}
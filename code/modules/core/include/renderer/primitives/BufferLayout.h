@@ -24,7 +24,19 @@ namespace modulith{
         Int2,
         Int3,
         Int4,
-        Bool
+        Bool,
+        /**
+         * Four 16 bit floats, only supported as vertex attribute
+         */
+        Half4,
+        /**
+         * Two signed 16 bit integers, only supported as vertex attribute and usually normalized to [-1, 1]
+         */
+        Short2,
+        /**
+         * Two unsigned 16 bit integers, only supported as vertex attribute and usually normalized to [0, 1]
+         */
+        UShort2
     };
 
     /**
@@ -54,6 +66,12 @@ namespace modulith{
                 return 4 * sizeof(int);
             case ShaderDataType::Bool:
                 return sizeof(bool);
+            case ShaderDataType::Half4:
+                return 4 * sizeof(uint16_t);
+            case ShaderDataType::Short2:
+                return 2 * sizeof(int16_t);
+            case ShaderDataType::UShort2:
+                return 2 * sizeof(uint16_t);
             default: CoreAssert(false, "Unsupported ShaderDataType {0}", type);
                 return 0;
         }
@@ -70,12 +88,15 @@ namespace modulith{
                 return 1;
             case ShaderDataType::Int2:
             case ShaderDataType::Float2:
+            case ShaderDataType::Short2:
+            case ShaderDataType::UShort2:
                 return 2;
             case ShaderDataType::Int3:
             case ShaderDataType::Float3:
                 return 3;
             case ShaderDataType::Int4:
             case ShaderDataType::Float4:
+            case ShaderDataType::Half4:
                 return 4;
             case ShaderDataType::Mat3:
                 return 9;
@@ -155,6 +176,15 @@ namespace modulith{
             calculateOffset();
         }
 
+        /**
+         * Creates a buffer layout from the given elements
+         * @param isPerInstance If the elements are advanced once per drawn instance instead of once per vertex
+         */
+        BufferLayout(const std::initializer_list<BufferElement>& elements, bool isPerInstance)
+            : _elements(elements), _isPerInstance(isPerInstance) {
+            calculateOffset();
+        }
+
         /**
          * @return Returns the elements inside the buffer layout
          */
@@ -165,6 +195,11 @@ namespace modulith{
          */
         [[nodiscard]] uint32_t GetStride() const { return _stride; }
 
+        /**
+         * @return Returns if the data is advanced once per drawn instance instead of once per vertex
+         */
+        [[nodiscard]] bool IsPerInstance() const { return _isPerInstance; }
+
     private:
 
         void calculateOffset() {
@@ -178,6 +213,7 @@ namespace modulith{
         }
 
         uint32_t _stride = 0;
+        bool _isPerInstance = false;
         std::vector<BufferElement> _elements{};
     };
 
@@ -37,6 +37,14 @@ namespace modulith{
          */
         virtual void SetLayout(const BufferLayout& layout) = 0;
 
+        /**
+         * Replaces the whole data of the vertex buffer, which may change its size.
+         * Used for buffers whose data changes every frame, like instance data.
+         * @param data A pointer to the new data
+         * @param size The size (in bytes) of the new data
+         */
+        virtual void SetData(const void* data, uint32_t size) = 0;
+
     };
 
     /**
@@ -63,4 +71,27 @@ namespace modulith{
 
     };
 
+    /**
+     * A rendering-api independent implementation of a uniform buffer,
+     * which provides the data of a uniform block to all shaders at once
+     */
+    class CORE_API UniformBuffer {
+    public:
+        virtual ~UniformBuffer() = default;
+
+        /**
+         * Binds the uniform buffer to its binding point,
+         * so all shaders read the uniform block bound to the same point from it
+         */
+        virtual void Bind() const = 0;
+
+        /**
+         * Replaces the whole data of the uniform buffer
+         * @param data A pointer to the new data, laid out as the uniform block expects it (e.g. std140)
+         * @param size The size (in bytes) of the new data
+         */
+        virtual void SetData(const void* data, uint32_t size) = 0;
+
+    };
+
 }
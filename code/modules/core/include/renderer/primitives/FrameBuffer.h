@@ -0,0 +1,47 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include <CoreModule.h>
+
+namespace modulith{
+
+    /**
+     * A rendering-api independent implementation of a frame buffer with a color and a depth attachment,
+     * which can be rendered into instead of the window
+     */
+    class CORE_API FrameBuffer {
+    public:
+        virtual ~FrameBuffer() = default;
+
+        /**
+         * Binds the frame buffer, so everything is rendered into it, and sets the viewport to its size
+         */
+        virtual void Bind() const = 0;
+
+        /**
+         * Binds the window again, so everything is rendered into it.
+         * The viewport needs to be set to the size of the window afterwards
+         */
+        virtual void Unbind() const = 0;
+
+        /**
+         * Resizes the attachments of the frame buffer, discarding their content
+         * @param size The new width and height (in pixels)
+         */
+        virtual void Resize(int2 size) = 0;
+
+        /**
+         * @return Returns the width and height (in pixels) of the attachments
+         */
+        [[nodiscard]] virtual int2 GetSize() const = 0;
+
+        /**
+         * @return Returns the renderer api specific id of the color attachment, e.g. to draw it with ImGui
+         */
+        [[nodiscard]] virtual uint32_t GetColorAttachmentRendererId() const = 0;
+    };
+}
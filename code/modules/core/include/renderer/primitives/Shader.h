@@ -7,9 +7,48 @@
 
 #include <CoreModule.h>
 #include <assets/AssetContext.h>
+#include "renderer/RenderQueue.h"
 
 namespace modulith{
 
+    /**
+     * Identifies a uniform variable by its name. Uploading by id instead of by name avoids building, hashing and
+     * looking up the name for every upload, since a shader caches the location of every id it has seen.
+     * Ids are shared by all shaders, so they are best created once and stored.
+     */
+    class CORE_API UniformId {
+    public:
+        /**
+         * Creates the id of the uniform variable with the given name. Ids created from the same name are equal.
+         */
+        explicit UniformId(const std::string& name);
+
+        /**
+         * @return Returns a small index, which is unique for every uniform name
+         */
+        [[nodiscard]] uint32_t GetIndex() const { return _index; }
+
+        /**
+         * @return Returns the name of the uniform variable
+         */
+        [[nodiscard]] const std::string& GetName() const;
+
+        bool operator==(const UniformId& other) const { return _index == other._index; }
+
+    private:
+        uint32_t _index;
+    };
+
+    /**
+     * The uniform block containing the camera and lights of the current scene, which is shared by all shaders.
+     * Shaders bind a block of this name to the binding point when they are created.
+     * @see Renderer::PackSceneUniforms for its layout
+     */
+    struct SceneUniformBlock {
+        static constexpr const char* Name = "SceneData";
+        static constexpr uint32_t BindingPoint = 0;
+    };
+
     /**
      * A rendering API-independent implementation of a shader
      */
@@ -104,11 +143,79 @@ namespace modulith{
          */
         virtual void UploadUniformBool(const std::string& name, bool value) = 0;
 
+        /**
+         * Uploads an Int1 uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformInt1(const UniformId& id, int value) = 0;
+
+        /**
+         * Uploads an Int2 uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformInt2(const UniformId& id, glm::vec<2, int> value) = 0;
+
+        /**
+         * Uploads an Int3 uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformInt3(const UniformId& id, glm::vec<3, int> value) = 0;
+
+        /**
+         * Uploads an Int4 uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformInt4(const UniformId& id, glm::vec<4, int> value) = 0;
+
+        /**
+         * Uploads a Float1 uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformFloat1(const UniformId& id, float value) = 0;
+
+        /**
+         * Uploads a Float2 uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformFloat2(const UniformId& id, const glm::vec2& value) = 0;
+
+        /**
+         * Uploads a Float3 uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformFloat3(const UniformId& id, const glm::vec3& value) = 0;
+
+        /**
+         * Uploads a Float4 uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformFloat4(const UniformId& id, const glm::vec4& value) = 0;
+
+        /**
+         * Uploads a Mat3 uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformMat3(const UniformId& id, const glm::mat3& matrix) = 0;
+
+        /**
+         * Uploads a Mat4 uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformMat4(const UniformId& id, const glm::mat4& matrix) = 0;
+
+        /**
+         * Uploads a Bool uniform value to the shader by its id. The shader must be bound when this method is called.
+         */
+        virtual void UploadUniformBool(const UniformId& id, bool value) = 0;
+
         /**
          * @return Returns the name of the shader
          */
         [[nodiscard]] virtual const std::string& GetName() const = 0;
 
+        /**
+         * @return Returns if the shader reads the model matrix "a_M" and normal matrix "a_N" from per instance attributes.
+         * Otherwise they are uploaded as the uniforms "u_M" and "u_N" for every draw.
+         */
+        [[nodiscard]] virtual bool IsInstanced() const = 0;
+
+        /**
+         * @return Returns the id by which draws using this shader are grouped in the RenderQueue
+         */
+        [[nodiscard]] uint32_t GetSortId() const { return _sortId; }
+
+    private:
+        uint32_t _sortId = RenderQueue::NextSortId(RenderQueue::SortIdKind::Shader);
     };
 
     class RenderContext;
@@ -7,6 +7,7 @@
 
 #include <CoreModule.h>
 #include "renderer/primitives/Buffers.h"
+#include "renderer/RenderQueue.h"
 
 namespace modulith{
 
@@ -53,6 +54,14 @@ namespace modulith{
          * @return Returns the index buffer attached to this vertex array
          */
         [[nodiscard]] virtual const shared<IndexBuffer>& GetIndexBuffer() const = 0;
+
+        /**
+         * @return Returns the id by which draws using this vertex array are grouped in the RenderQueue
+         */
+        [[nodiscard]] uint32_t GetSortId() const { return _sortId; }
+
+    private:
+        uint32_t _sortId = RenderQueue::NextSortId(RenderQueue::SortIdKind::VertexArray);
     };
 
 }
@@ -0,0 +1,48 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+
+namespace modulith {
+
+    /**
+     * An axis aligned bounding box, stored as its center and its half size in every direction.
+     * This representation allows transforming it and testing it against planes without visiting all eight corners.
+     */
+    struct CORE_API Bounds {
+        Bounds() = default;
+
+        Bounds(const float3& center, const float3& extents) : Center(center), Extents(extents) {}
+
+        /**
+         * @return Returns the smallest bounds containing all of the given points, or empty bounds at the origin if there are none
+         */
+        static Bounds FromPoints(const float3* points, size_t count, size_t stride = sizeof(float3));
+
+        float3 Center = float3(0.0f);
+
+        /**
+         * The half size of the box in every direction
+         */
+        float3 Extents = float3(0.0f);
+
+        [[nodiscard]] float3 Min() const { return Center - Extents; }
+
+        [[nodiscard]] float3 Max() const { return Center + Extents; }
+
+        /**
+         * @return Returns the radius of the sphere around the center that contains the whole box
+         */
+        [[nodiscard]] float SphereRadius() const { return glm::length(Extents); }
+
+        /**
+         * @return Returns the axis aligned bounds that contain this box after it is transformed by the given matrix.
+         * The result may be larger than the transformed box, if the transform contains a rotation.
+         */
+        [[nodiscard]] Bounds TransformedBy(const float4x4& transform) const;
+    };
+}
@@ -0,0 +1,46 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include "spatial/Bounds.h"
+#include "ecs/transform/TransformComponents.h"
+
+namespace modulith {
+
+    /**
+     * The volume visible to a camera, described by its six planes in world space.
+     * Used to cull objects whose bounds are completely outside of the view before they are submitted for rendering.
+     */
+    class CORE_API Frustum {
+    public:
+        /**
+         * Extracts the planes from the combined projection and view matrix of a camera
+         */
+        explicit Frustum(const float4x4& viewProjection);
+
+        /**
+         * @return Returns false if the bounds are completely outside of the frustum.
+         * Bounds close to a corner of the frustum may be considered inside, even though they are not.
+         */
+        [[nodiscard]] bool Intersects(const Bounds& bounds) const;
+
+        /**
+         * Tests multiple bounds against the frustum at once, four at a time using SSE where available.
+         * @param bounds The contiguous column of world bounds, e.g. of a chunk
+         * @param visible Receives 1 for every bounds that intersects the frustum and 0 otherwise. Must contain room for count values.
+         * @return Returns the amount of bounds that intersect the frustum
+         */
+        size_t Cull(const WorldBoundsData* bounds, size_t count, uint8_t* visible) const;
+
+    private:
+        /**
+         * The planes as (normal, distance), with the normal pointing into the frustum:
+         * left, right, bottom, top, near and far
+         */
+        std::array<float4, 6> _planes;
+    };
+}
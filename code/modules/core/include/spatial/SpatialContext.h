@@ -0,0 +1,36 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include "spatial/SpatialHashGrid.h"
+
+namespace modulith {
+
+    /**
+     * Provides a spatial index of all active entities with a SpatiallyIndexedTag and a GlobalTransformData.
+     * Systems can use it to find entities near a position, instead of testing every entity of a query.
+     * The index is rebuilt by the SpatialIndexSystem after the global transforms were updated,
+     * so it contains the positions of the current frame for all systems executed after the TransformSystemsGroup.
+     * Subcontexts are not ordered relative to the ECSContext, so they may see the index of the previous frame,
+     * which has the same positions as the GlobalTransformData at that point.
+     * Entities that were destroyed after the index was built are still contained until the next frame,
+     * and entities created or tagged since then are missing until the next rebuild.
+     * Entities without a SpatiallyIndexedTag are never contained, so consumers that must see them need to query them separately.
+     */
+    class CORE_API SpatialContext : public Subcontext {
+    public:
+        SpatialContext() : Subcontext("Spatial Context") {}
+
+        /**
+         * @return Returns the spatial index of the current frame
+         */
+        ref<SpatialHashGrid> GetIndex() { return ref(&_index); }
+
+    private:
+        SpatialHashGrid _index;
+    };
+}
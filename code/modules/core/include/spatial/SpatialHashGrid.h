@@ -0,0 +1,171 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include "ecs/Entity.h"
+
+namespace modulith {
+
+    /**
+     * A uniform grid of cubic cells, which allows finding the entities near a position
+     * without testing every entity.
+     * Only cells that contain entities are stored, in a hash map keyed by their cell coordinates.
+     *
+     * The grid is filled in two steps: All entities are inserted first and Build then sorts them by their cell,
+     * so the entities of a cell are contiguous in memory. Queries are only allowed after the grid was built.
+     * @see SpatialIndexSystem, which rebuilds the grid of the SpatialContext every frame
+     */
+    class CORE_API SpatialHashGrid {
+    public:
+
+        /**
+         * An entity stored in the grid together with its position at the time it was inserted
+         */
+        struct Entry {
+            Entity Owner;
+            float3 Position;
+        };
+
+        /**
+         * @param cellSize The edge length of a cell.
+         * Queries are fastest if the cell size is in the order of magnitude of the queried radii.
+         */
+        explicit SpatialHashGrid(float cellSize = 4.0f);
+
+        /**
+         * Removes all entities and sets the edge length of a cell
+         */
+        void Reset(float cellSize);
+
+        /**
+         * Removes all entities, but keeps the allocated memory for the next build.
+         * An empty grid can be queried without building it.
+         */
+        void Clear();
+
+        /**
+         * Adds an entity at the given position. The entity can only be found after the next Build.
+         */
+        void Insert(Entity entity, const float3& position);
+
+        /**
+         * Sorts all inserted entities by their cell, so they can be queried
+         */
+        void Build();
+
+        /**
+         * Calls the given function with every entity whose position is within the radius around the center.
+         * The function must have the signature void(Entity entity, const float3& position).
+         */
+        template<class TFunc>
+        void QueryRadius(const float3& center, float radius, TFunc&& func) const;
+
+        /**
+         * Calls the given function with every entity whose position is inside the axis aligned box.
+         * The function must have the signature void(Entity entity, const float3& position).
+         */
+        template<class TFunc>
+        void QueryBox(const float3& min, const float3& max, TFunc&& func) const;
+
+        /**
+         * Finds the entities closest to the given position
+         * @param center The position to search from
+         * @param count The maximum number of entities returned
+         * @param maxRadius Entities further away than this are not returned
+         * @return Returns up to count entities, sorted by their distance to the center
+         */
+        [[nodiscard]] std::vector<Entity> FindNearest(const float3& center, size_t count, float maxRadius) const;
+
+        /**
+         * @return Returns the number of entities that were contained in the grid when it was last built
+         */
+        [[nodiscard]] size_t Size() const { return _isBuilt ? _entries.size() : 0; }
+
+        [[nodiscard]] float CellSize() const { return _cellSize; }
+
+    private:
+        /**
+         * The range of _entries that belongs to one cell
+         */
+        struct CellRange {
+            uint32_t Begin;
+            uint32_t End;
+            int3 Cell;
+        };
+
+        [[nodiscard]] int3 cellOf(const float3& position) const;
+
+        /**
+         * Packs the 21 lower bits of each cell coordinate into a single key
+         */
+        [[nodiscard]] static uint64_t keyOf(const int3& cell);
+
+        float _cellSize;
+        float _inverseCellSize;
+        bool _isBuilt = true;
+
+        std::vector<Entry> _entries;
+        std::vector<uint64_t> _keys;
+        std::unordered_map<uint64_t, CellRange> _cells;
+    };
+
+    template<class TFunc>
+    void SpatialHashGrid::QueryRadius(const float3& center, float radius, TFunc&& func) const {
+        auto radiusSquared = radius * radius;
+        QueryBox(
+            center - float3(radius), center + float3(radius), [&](Entity entity, const float3& position) {
+                auto offset = position - center;
+                if (glm::dot(offset, offset) <= radiusSquared)
+                    func(entity, position);
+            }
+        );
+    }
+
+    template<class TFunc>
+    void SpatialHashGrid::QueryBox(const float3& min, const float3& max, TFunc&& func) const {
+        CoreAssert(_isBuilt, "The spatial hash grid must be built before it can be queried")
+
+        const auto isInside = [&min, &max](const float3& position) {
+            return position.x >= min.x && position.y >= min.y && position.z >= min.z
+                   && position.x <= max.x && position.y <= max.y && position.z <= max.z;
+        };
+
+        auto minCell = cellOf(min);
+        auto maxCell = cellOf(max);
+        const auto visitCell = [&](const CellRange& range) {
+            for (auto i = range.Begin; i < range.End; ++i) {
+                auto& entry = _entries[i];
+                if (isInside(entry.Position))
+                    func(entry.Owner, entry.Position);
+            }
+        };
+
+        // Boxes covering more cells than are occupied are cheaper to answer by testing the occupied cells,
+        // which still only visits the entities of cells overlapping the box
+        auto coveredCellCount = ((double) maxCell.x - minCell.x + 1) * ((double) maxCell.y - minCell.y + 1)
+                                * ((double) maxCell.z - minCell.z + 1);
+        if (coveredCellCount > (double) _cells.size()) {
+            for (auto& cell : _cells) {
+                auto& coordinates = cell.second.Cell;
+                if (coordinates.x >= minCell.x && coordinates.y >= minCell.y && coordinates.z >= minCell.z
+                    && coordinates.x <= maxCell.x && coordinates.y <= maxCell.y && coordinates.z <= maxCell.z)
+                    visitCell(cell.second);
+            }
+            return;
+        }
+
+        for (auto x = minCell.x; x <= maxCell.x; ++x) {
+            for (auto y = minCell.y; y <= maxCell.y; ++y) {
+                for (auto z = minCell.z; z <= maxCell.z; ++z) {
+                    auto cell = _cells.find(keyOf(int3(x, y, z)));
+                    if (cell != _cells.end())
+                        visitCell(cell->second);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,33 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include "CoreModule.h"
+#include "ecs/systems/System.h"
+
+namespace modulith {
+
+    /**
+     * Marks an entity to be contained in the spatial index of the SpatialContext.
+     * Only entities with a GlobalTransformData are indexed.
+     */
+    struct CORE_API SpatiallyIndexedTag {
+    };
+
+    /**
+     * Rebuilds the spatial index of the SpatialContext from the GlobalTransformData
+     * of all active entities with a SpatiallyIndexedTag each frame.
+     * It is executed after the GlobalTransformSystem.
+     */
+    class CORE_API SpatialIndexSystem : public System {
+    public:
+        explicit SpatialIndexSystem() : System("Spatial Index System") {}
+
+        ~SpatialIndexSystem() override = default;
+
+        void OnUpdate(float deltaTime) override;
+    };
+}
@@ -0,0 +1,62 @@
+/*
+ * \brief
+ * \author Daniel Götz
+ */
+
+# pragma once
+
+#include "CoreModule.h"
+#include "Window.h"
+
+namespace modulith {
+
+    /**
+     * A window that is never shown and does not create a graphics context.
+     * It is used together with the NullRendererAPI, so the engine can run on machines without a GPU.
+     * It never receives input and keeps running until Quit is called
+     */
+    class CORE_API NullWindow : public Window {
+    public:
+        explicit NullWindow(const WindowConfig& config) : _size(config.Width, config.Height), _type(config.Type) {}
+
+        void OnInitialize() override {}
+
+        void OnPreUpdate() override {}
+
+        void OnPostUpdate() override {}
+
+        void OnShutdown() override {}
+
+        InputState& GetCurrentInputState() override { return _currentInputState; }
+
+        void ToggleCursorVisibility(bool enabled) override { _isCursorVisible = enabled; }
+
+        bool IsCursorVisible() override { return _isCursorVisible; }
+
+        void SetCursorPosition(int2 position) override {}
+
+        bool HasWindowSizeChanged() override { return false; }
+
+        void InitImGui() override {}
+
+        [[nodiscard]] int GetWidth() const override { return _size.x; }
+
+        [[nodiscard]] int GetHeight() const override { return _size.y; }
+
+        bool IsRunning() override { return _isRunning; }
+
+        void Quit() override { _isRunning = false; }
+
+        [[nodiscard]] WindowType GetWindowType() const override { return _type; }
+
+        void SetWindowType(WindowType newType) override { _type = newType; }
+
+    private:
+        InputState _currentInputState{};
+        int2 _size;
+        WindowType _type;
+
+        bool _isCursorVisible = true;
+        bool _isRunning = true;
+    };
+}
@@ -9,6 +9,8 @@
 #include "ecs/transform/GlobalTransformSystem.h"
 #include "ecs/transform/ParentSystem.h"
 #include "assets/AssetContext.h"
+#include "spatial/SpatialContext.h"
+#include "spatial/SpatialIndexSystem.h"
 
 using namespace modulith;
 
@@ -17,6 +19,7 @@ void OnInitialize(ModuleResources& module){
     module.Register<SubcontextResource<ECSContext>>();
     module.Register<SubcontextResource<SerializationContext>>();
     module.Register<SubcontextResource<AssetContext>>();
+    module.Register<SubcontextResource<SpatialContext>>();
 
     module.Register<ComponentResource<DisabledTag>>("Disabled");
     module.Register<SerializerResource<DisabledTag, TrivialSerializer<DisabledTag>>>();
@@ -28,6 +31,7 @@ void OnInitialize(ModuleResources& module){
     module.Register<ComponentResource<WithParentData>>("WithParent");
     module.Register<SerializerResource<WithParentData>>();
     module.Register<ComponentResource<WithChildrenData>>("WithChildren");
+    module.Register<ComponentResource<HierarchyNodeData>>("HierarchyNode");
 
     module.Register<ComponentResource<PositionData>>("Position");
     module.Register<SerializerResource<PositionData>>();
@@ -40,6 +44,14 @@ void OnInitialize(ModuleResources& module){
     module.Register<SerializerResource<LocalTransformData>>();
     module.Register<ComponentResource<GlobalTransformData>>("GlobalTransform");
     module.Register<SerializerResource<GlobalTransformData>>();
+    module.Register<ComponentResource<InverseGlobalTransformData>>("InverseGlobalTransform");
+    module.Register<ComponentResource<DecomposedGlobalTransformData>>("DecomposedGlobalTransform");
+    module.Register<ComponentResource<LocalBoundsData>>("LocalBounds");
+    module.Register<ComponentResource<WorldBoundsData>>("WorldBounds");
+    module.Register<ComponentResource<TransformDirtyData>>("TransformDirty");
+
+    module.Register<ComponentResource<SpatiallyIndexedTag>>("SpatiallyIndexed");
+    module.Register<SerializerResource<SpatiallyIndexedTag, TrivialSerializer<SpatiallyIndexedTag>>>();
 
     module.Register<SystemsGroupResource<InputSystemsGroup>>();
     module.Register<SystemsGroupResource<TransformSystemsGroup, ExecuteAfter<InputSystemsGroup>>>();
@@ -48,6 +60,7 @@ void OnInitialize(ModuleResources& module){
     module.Register<SystemResource<LocalTransformSystem, InGroup<TransformSystemsGroup>>>();
     module.Register<SystemResource<ParentSystem, InGroup<TransformSystemsGroup>, ExecuteAfter<LocalTransformSystem>>>();
     module.Register<SystemResource<GlobalTransformSystem, InGroup<TransformSystemsGroup>, ExecuteAfter<ParentSystem>>>();
+    module.Register<SystemResource<SpatialIndexSystem, InGroup<TransformSystemsGroup>, ExecuteAfter<GlobalTransformSystem>>>();
 }
 
 void OnShutdown(ModuleResources& module){
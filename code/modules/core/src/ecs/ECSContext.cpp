@@ -32,20 +32,30 @@ namespace modulith{
     void ECSContext::OnUpdate(float deltaTime) {
         auto& ctx = Context::Instance();
         executeOnSystemsInOrder(
-            [deltaTime, &ctx](auto& system) {
+            [deltaTime, &ctx, this](auto& system) {
                 ctx.GetProfiler().BeginMeasurement(system->GetName() + ".OnUpdate()");
-                system->OnUpdate(deltaTime);
+                UpdateSystem(*system, deltaTime);
                 ctx.GetProfiler().EndMeasurement();
             }
         );
     }
 
+    void ECSContext::UpdateSystem(System& system, float deltaTime) {
+        auto changeVersion = _manager->BeginSystemUpdate(system._lastChangeVersion);
+        system.OnUpdate(deltaTime);
+        system._lastChangeVersion = changeVersion;
+        // Writes done after the update, e.g. by subcontexts, must not be stamped with the version the system has already seen
+        _manager->EndSystemUpdate();
+    }
+
     void ECSContext::OnImGui(float deltaTime, bool renderingToImguiWindow) {
         if(renderingToImguiWindow) {
             auto& ctx = Context::Instance();
             executeOnSystemsInOrder(
-                [deltaTime, &ctx](auto& system) {
+                [deltaTime, &ctx, this](auto& system) {
                     ctx.GetProfiler().BeginMeasurement(system->GetName() + ".OnImGui()");
+                    // Writes done while drawing are stamped with a new version, but the system's last update stays the same
+                    _manager->BeginSystemUpdate(system->_lastChangeVersion);
                     system->OnImGui(deltaTime);
                     ctx.GetProfiler().EndMeasurement();
                 }
@@ -74,6 +84,10 @@ namespace modulith{
 
     void ECSContext::OnAfterUnloadModules(const std::vector<Module>& modules) {
         _manager = std::make_unique<EntityManager>(ref(&_componentManager));
-        executeOnSystemsInOrder([](auto& system){ system->OnInitialize(); });
+        executeOnSystemsInOrder([](auto& system){
+            // The new entity manager starts with a new change version, so all data is considered changed
+            system->_lastChangeVersion = 0;
+            system->OnInitialize();
+        });
     }
 }
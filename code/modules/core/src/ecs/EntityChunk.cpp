@@ -7,6 +7,12 @@
 
 namespace modulith{
 
+    namespace {
+        size_t alignToColumn(size_t offset) {
+            return (offset + MODU_CHUNK_COLUMN_ALIGNMENT - 1) / MODU_CHUNK_COLUMN_ALIGNMENT * MODU_CHUNK_COLUMN_ALIGNMENT;
+        }
+    }
+
     EntityChunk::EntityChunk(
         const SignatureIdentifier& signature, const ref<ComponentManager>& componentManager
     ) : _componentManager(componentManager) {
@@ -14,7 +20,7 @@ namespace modulith{
         _identifier = signature;
         for (auto& component : signature) {
             RegisteredComponent componentInfo = componentManager->GetInfoOf(component);
-            _offsets[component] = _entitySize;
+            _columns[component] = ComponentColumn{0, componentInfo.GetSize(), 0};
             _entitySize += componentInfo.GetSize();
             _signature.set(componentInfo.GetIndex());
         }
@@ -22,14 +28,26 @@ namespace modulith{
         _aliveCount = 0;
         _deadCount = 0;
 
-        _capacity = (MODU_CHUNK_SIZE_BYTES / _entitySize) - 1; // The capacity is one less than the possible capacity: The 'last' slot is used for swapping
+        // Every column (including the entity column) may need padding for its alignment
+        auto maxPadding = (_columns.size() + 1) * MODU_CHUNK_COLUMN_ALIGNMENT;
+        auto usableBytes = MODU_CHUNK_SIZE_BYTES > maxPadding ? MODU_CHUNK_SIZE_BYTES - maxPadding : 0;
+        _capacity = (usableBytes / _entitySize) - 1; // The capacity is one less than the possible capacity: The 'last' slot is used for swapping
         CoreAssert(
-            _capacity >= 2,
+            usableBytes / _entitySize >= 3,
             "The signature of this chunks exceeded the limit of {} bytes per entity with {} bytes per entity. "
             "A chunk can only hold {} bytes of data, and there must be room for at least 2 entities",
             2 * MODU_CHUNK_SIZE_BYTES, _entitySize, MODU_CHUNK_SIZE_BYTES
         )
 
+        auto slots = _capacity + 1;
+        auto offset = alignToColumn(sizeof(Entity) * slots);
+        for (auto& component : signature) {
+            auto& column = _columns.at(component);
+            column.Offset = offset;
+            offset = alignToColumn(offset + column.Size * slots);
+        }
+        CoreAssert(offset <= MODU_CHUNK_SIZE_BYTES, "The columns of this chunk exceed its buffer size")
+
         if (_capacity < 5)
         CoreLogWarn("A chunk with only a capacity for {} entities was created, with a size of {} bytes per entity. This is very close to the limit!", _capacity, _entitySize)
     }
@@ -46,15 +64,38 @@ namespace modulith{
         return _identifier.count(componentType) > 0;
     }
 
+    uint64_t EntityChunk::GetChangeVersion(const ComponentIdentifier& component) const {
+        auto it = _columns.find(component);
+        return it != _columns.end() ? it->second.ChangeVersion : 0;
+    }
+
+    bool EntityChunk::HasChangedSince(const ComponentIdentifier& component, uint64_t version) const {
+        return _structuralVersion > version || GetChangeVersion(component) > version;
+    }
+
+    void EntityChunk::MarkChanged(const ComponentIdentifier& component, uint64_t version) {
+        // Only existing entries are updated: the identifier may be stored in the static memory of another module
+        auto it = _columns.find(component);
+        if (it != _columns.end())
+            it->second.ChangeVersion = version;
+    }
+
     void* EntityChunk::GetComponentPtr(Entity entity, ComponentIdentifier component) {
         CoreAssert(ContainsEntity(entity),
             "The entities' pointer cannot be gotten because it does not exist in this chunk!");
         // This method can be called with non-contained component so For(Any<...>) can return null for components not present
-        if (_offsets.count(component) == 0)
+        auto it = _columns.find(component);
+        if (it == _columns.end())
             return nullptr;
         auto index = _entityIndices[entity];
-        auto offset = (index * _entitySize) + _offsets[component];
-        return _buffer + offset;
+        return _buffer + it->second.Offset + (index * it->second.Size);
+    }
+
+    void* EntityChunk::GetColumn(const ComponentIdentifier& component) {
+        auto it = _columns.find(component);
+        if (it == _columns.end())
+            return nullptr;
+        return _buffer + it->second.Offset;
     }
 
 
@@ -66,11 +107,11 @@ namespace modulith{
         _aliveCount++;
 
         _entityIndices[entity] = allocatedIndex;
-        auto destination = _buffer + (_entitySize * allocatedIndex);
-        
+        memcpy(_buffer + (sizeof(Entity) * allocatedIndex), &entity, sizeof(Entity));
+
         // Zero-initialize the buffer when an entity is allocated, so any "zero-initialized" component can be safely destructed
-        memset(destination, 0, _entitySize);
-        memcpy(destination, &entity, sizeof(Entity));
+        for (auto& [component, column] : _columns)
+            memset(_buffer + column.Offset + (column.Size * allocatedIndex), 0, column.Size);
     }
 
     void EntityChunk::MoveEntity(
@@ -115,13 +156,9 @@ namespace modulith{
 
         auto entityIndex = _entityIndices.at(entity);
 
-        auto* entityPtr = _buffer + (entityIndex * _entitySize);
-        auto* lastPtr = _buffer + (lastAliveIndex * _entitySize);
-        auto* tempPtr = _buffer + (_capacity * _entitySize);
-
-        memmove(tempPtr, entityPtr, _entitySize);
-        memmove(entityPtr, lastPtr, _entitySize);
-        memmove(lastPtr, tempPtr, _entitySize);
+        swapSlots(0, sizeof(Entity), entityIndex, lastAliveIndex);
+        for (auto& [component, column] : _columns)
+            swapSlots(column.Offset, column.Size, entityIndex, lastAliveIndex);
 
         _entityIndices[entity] = lastAliveIndex;
         _entityIndices[lastEntity] = entityIndex;
@@ -130,10 +167,20 @@ namespace modulith{
         CoreAssert(entityAt(lastAliveIndex) == entity, "The makeLastAliveEntity function is not implemented correctly")
     }
 
+    void EntityChunk::swapSlots(size_t columnOffset, size_t valueSize, uint32_t index, uint32_t otherIndex) {
+        auto* indexPtr = _buffer + columnOffset + (index * valueSize);
+        auto* otherPtr = _buffer + columnOffset + (otherIndex * valueSize);
+        auto* tempPtr = _buffer + columnOffset + (_capacity * valueSize);
+
+        memmove(tempPtr, indexPtr, valueSize);
+        memmove(indexPtr, otherPtr, valueSize);
+        memmove(otherPtr, tempPtr, valueSize);
+    }
+
     Entity EntityChunk::entityAt(uint32_t index) const {
         CoreAssert(index < GetOccupied(),
             "There is no entity at index {} since there are only {} entities total in this chunk", index, GetOccupied())
-        return *reinterpret_cast<const Entity*>(_buffer + (_entitySize * index));
+        return GetEntities()[index];
     }
 
     std::vector<Entity> EntityChunk::CleanupDeadEntitiesAtEndOfFrame() {
@@ -62,6 +62,7 @@ namespace modulith{
 
         auto chunk = GetOrCreateChunkFor(identifier);
         chunk->AllocateEntity(result);
+        chunk->MarkStructureChanged(_changeVersion);
         _entityLocations[result] = chunk;
 
         return std::make_pair(result, chunk);
@@ -72,9 +73,22 @@ namespace modulith{
             "Entities cannot be destroyed while iterating over them! Use EntityManager->Defer instead!")
         CoreAssert(_entityLocations.count(entity) > 0, "You cannot destroy entity {0} since it does not exist!", entity)
 
+        // The parent of the entity would otherwise keep the destroyed entity as its child
+        auto* node = GetComponent<const HierarchyNodeData>(entity);
+        auto* parent = GetComponent<const WithParentData>(entity);
+        auto parentEntity = node != nullptr ? node->Parent : (parent != nullptr ? parent->Value : Entity::Invalid());
+        if (parentEntity != Entity::Invalid() && IsAlive(parentEntity)) {
+            auto* siblings = GetComponent<WithChildrenData>(parentEntity);
+            if (siblings != nullptr && siblings->Remove(entity) && siblings->Values.empty())
+                RemoveComponent<WithChildrenData>(parentEntity);
+        }
+
         auto* children = GetComponent<WithChildrenData>(entity);
         if (children) {
-            std::for_each(children->Values.begin(), children->Values.end(), [this](Entity child) { DestroyEntity(child); });
+            // The children are moved out, because destroying them would otherwise remove them while iterating
+            auto toDestroy = std::move(children->Values);
+            children->Values.clear();
+            std::for_each(toDestroy.begin(), toDestroy.end(), [this](Entity child) { DestroyEntity(child); });
         }
 
         auto chunk = _entityLocations[entity];
@@ -114,8 +128,12 @@ namespace modulith{
             EntityChunk::MoveEntity(entity, *currentChunk, *destinationChunk, currentIdentifier, _componentManager);
 
             _entityLocations[entity] = destinationChunk;
+            destinationChunk->MarkStructureChanged(_changeVersion);
             destPtr = destinationChunk->GetComponentPtr(entity, identifier);
         }
+        else {
+            currentChunk->MarkChanged(identifier, _changeVersion);
+        }
 
         CoreAssert(destPtr != nullptr, "The destPtr must be assigned before the method returns!")
 
@@ -155,6 +173,7 @@ namespace modulith{
         EntityChunk::MoveEntity(entity, *currentChunk, *destinationChunk, destinationIdentifier, _componentManager);
 
         _entityLocations[entity] = destinationChunk;
+        destinationChunk->MarkStructureChanged(_changeVersion);
 
         return true;
     }
@@ -170,6 +189,17 @@ namespace modulith{
         return _entityLocations.at(entity);
     }
 
+    uint64_t EntityManager::BeginSystemUpdate(uint64_t lastSystemVersion) {
+        CoreAssert(_iterationDepth == 0, "A system update cannot begin while iterating over entities!")
+        _lastSystemVersion = lastSystemVersion;
+        return ++_changeVersion;
+    }
+
+    void EntityManager::EndSystemUpdate() {
+        CoreAssert(_iterationDepth == 0, "A system update cannot end while iterating over entities!")
+        ++_changeVersion;
+    }
+
     void EntityManager::Defer(const std::function<void(ref<EntityManager>)>& deferredOperation) {
         CoreAssert(_iterationDepth > 0, "Defer should only be used while iterating. Otherwise it has no effect!")
         _deferredOperations.push_back(deferredOperation);
@@ -26,6 +26,10 @@ namespace modulith{
 
     Prefab::Prefab(const SignatureIdentifier& identifier, const ref<ComponentManager>& componentManager) : _componentManager(componentManager){
         _identifier = identifier;
+        // The hierarchy is derived from the WithParentData by the ParentSystem. Copies of it would make every instance
+        // claim the children of the original or look like it is already attached, so they are attached like new entities
+        _identifier.erase(typeid(HierarchyNodeData));
+        _identifier.erase(typeid(WithChildrenData));
         _size = 0;
         for (auto& component : _identifier) {
             RegisteredComponent componentInfo = componentManager->GetInfoOf(component);
@@ -49,6 +53,7 @@ namespace modulith{
         auto entity = Entity(++entityManager->_runningEntityId);
         auto chunk = entityManager->GetOrCreateChunkFor(_identifier);
         chunk->AllocateEntity(entity);
+        chunk->MarkStructureChanged(entityManager->_changeVersion);
         for(const auto& component : _identifier){
             auto info = _componentManager->GetInfoOf(component);
             auto* destPtr = chunk->GetComponentPtr(entity, component);
@@ -7,13 +7,41 @@
 #include <ecs/ECSContext.h>
 #include "ecs/transform/GlobalTransformSystem.h"
 #include "Context.h"
+#include <numeric>
 
 namespace modulith{
 
-    void GlobalTransformSystem::OnUpdate(float deltaTime) {
+    namespace {
+
+        /**
+         * An entity with children, whose global transform and disabled state are inherited by its children
+         */
+        struct ParentNode {
+            float4x4 ObjectToWorld;
+            bool DisablesChildren;
+        };
 
-        auto ecs = Context::GetInstance<ECSContext>()->GetEntityManager();
+        /**
+         * A child entity whose global transform is calculated from its parent's
+         */
+        struct HierarchyChild {
+            Entity Child;
+            Entity Parent;
+            uint32_t Depth;
+            const LocalTransformData* LocalTransform;
+            GlobalTransformData* GlobalTransform;
+            InverseGlobalTransformData* InverseGlobalTransform;
+            bool IsDisabled;
+            bool IsDisabledInHierarchy;
+            bool HasChildren;
+        };
+    }
+
+    void GlobalTransformSystem::OnUpdate(float deltaTime) {
+        UpdateGlobalTransforms(Context::GetInstance<ECSContext>()->GetEntityManager());
+    }
 
+    void GlobalTransformSystem::UpdateGlobalTransforms(ref<EntityManager> ecs) {
         // All components with a local transform or parent also have a global transform
         ecs->QueryAll(
             Each(),
@@ -23,10 +51,158 @@ namespace modulith{
             }
         );
 
-        // Calculate the WorldTransform of all entities
-        ecs->QueryAll(
-            Each(), None<WithParentData>(), [ecs](auto entity) {
-                updateGlobalTransformRec(ecs, entity, float4x4(1.0f), false);
+        // Entities with children are stored in a dense array, so children can read their parent's transform from it
+        std::vector<ParentNode> nodes;
+        EntityMappedTo<uint32_t> nodeIndexOf;
+
+        std::vector<Entity> becameDisabledInHierarchy;
+        std::vector<Entity> becameEnabledInHierarchy;
+
+        // Calculate the WorldTransform of all root entities
+        ecs->QueryAllChunks(
+            Each(),
+            Any<
+                GlobalTransformData, InverseGlobalTransformData, const LocalTransformData, const WithChildrenData,
+                const DisabledTag, const IndirectlyDisabledTag
+            >(),
+            None<WithParentData>(),
+            [&](
+                const Entity* entities, GlobalTransformData* globalTransforms, InverseGlobalTransformData* inverseGlobalTransforms,
+                const LocalTransformData* localTransforms, const WithChildrenData* children,
+                const DisabledTag* disabled, const IndirectlyDisabledTag* disabledInHierarchy, size_t count
+            ) {
+                for (size_t i = 0; i < count; ++i) {
+                    auto objectToWorld = localTransforms != nullptr ? localTransforms[i].Value : float4x4(1.0f);
+                    if (globalTransforms != nullptr)
+                        globalTransforms[i].Value = objectToWorld;
+                    if (inverseGlobalTransforms != nullptr)
+                        inverseGlobalTransforms[i].Value = glm::affineInverse(objectToWorld);
+                    if (children != nullptr) {
+                        nodeIndexOf.emplace(entities[i], (uint32_t) nodes.size());
+                        nodes.push_back({objectToWorld, disabled != nullptr});
+                    }
+                }
+
+                // Tags are present for all entities of a chunk or for none of them
+                auto& changedEntities = disabled != nullptr ? becameDisabledInHierarchy : becameEnabledInHierarchy;
+                if ((disabled != nullptr) != (disabledInHierarchy != nullptr))
+                    changedEntities.insert(changedEntities.end(), entities, entities + count);
+            }
+        );
+
+        // Collect all children with their depth in the hierarchy
+        std::vector<HierarchyChild> hierarchyChildren;
+        uint32_t maxDepth = 0;
+        ecs->QueryAllChunks(
+            Each<const HierarchyNodeData>(),
+            Any<
+                GlobalTransformData, InverseGlobalTransformData, const LocalTransformData, const WithChildrenData,
+                const DisabledTag, const IndirectlyDisabledTag
+            >(),
+            None(),
+            [&](
+                const Entity* entities, const HierarchyNodeData* hierarchyNodes,
+                GlobalTransformData* globalTransforms, InverseGlobalTransformData* inverseGlobalTransforms,
+                const LocalTransformData* localTransforms, const WithChildrenData* children,
+                const DisabledTag* disabled, const IndirectlyDisabledTag* disabledInHierarchy, size_t count
+            ) {
+                for (size_t i = 0; i < count; ++i) {
+                    hierarchyChildren.push_back(
+                        {
+                            entities[i], hierarchyNodes[i].Parent, hierarchyNodes[i].Depth,
+                            localTransforms != nullptr ? localTransforms + i : nullptr,
+                            globalTransforms != nullptr ? globalTransforms + i : nullptr,
+                            inverseGlobalTransforms != nullptr ? inverseGlobalTransforms + i : nullptr,
+                            disabled != nullptr, disabledInHierarchy != nullptr, children != nullptr
+                        }
+                    );
+                    maxDepth = std::max(maxDepth, hierarchyNodes[i].Depth);
+                }
+            }
+        );
+
+        // Sort the children by their depth (counting sort), so all parents are processed before their children
+        auto levelStart = std::vector<size_t>(maxDepth + 2, 0);
+        for (auto& child : hierarchyChildren)
+            ++levelStart[child.Depth + 1];
+        std::partial_sum(levelStart.begin(), levelStart.end(), levelStart.begin());
+
+        auto sortedChildren = std::vector<const HierarchyChild*>(hierarchyChildren.size());
+        auto insertAt = levelStart;
+        for (auto& child : hierarchyChildren)
+            sortedChildren[insertAt[child.Depth]++] = &child;
+
+        nodes.reserve(nodes.size() + hierarchyChildren.size());
+
+        // Calculate the WorldTransform of all children level by level
+        // The children of a level only read the nodes of previous levels and are independent of each other
+        for (uint32_t depth = 1; depth <= maxDepth; ++depth) {
+            for (auto index = levelStart[depth]; index < levelStart[depth + 1]; ++index) {
+                const auto& child = *sortedChildren[index];
+
+                // Children whose parent is not connected to a root entity are not updated
+                auto parentIndex = nodeIndexOf.find(child.Parent);
+                if (parentIndex == nodeIndexOf.end())
+                    continue;
+                auto parent = nodes[parentIndex->second];
+
+                auto objectToWorld = child.LocalTransform != nullptr
+                    ? parent.ObjectToWorld * child.LocalTransform->Value
+                    : parent.ObjectToWorld;
+                if (child.GlobalTransform != nullptr)
+                    child.GlobalTransform->Value = objectToWorld;
+                if (child.InverseGlobalTransform != nullptr)
+                    child.InverseGlobalTransform->Value = glm::affineInverse(objectToWorld);
+
+                auto disablesChildren = child.IsDisabled || parent.DisablesChildren;
+                if (disablesChildren && !child.IsDisabledInHierarchy)
+                    becameDisabledInHierarchy.push_back(child.Child);
+                else if (!disablesChildren && child.IsDisabledInHierarchy)
+                    becameEnabledInHierarchy.push_back(child.Child);
+
+                if (child.HasChildren) {
+                    nodeIndexOf.emplace(child.Child, (uint32_t) nodes.size());
+                    nodes.push_back({objectToWorld, disablesChildren});
+                }
+            }
+        }
+
+        for (auto entity : becameDisabledInHierarchy)
+            ecs->AddComponent<IndirectlyDisabledTag>(entity);
+        for (auto entity : becameEnabledInHierarchy)
+            ecs->RemoveComponent<IndirectlyDisabledTag>(entity);
+
+        // Decompose the global transforms once for the entities that cache them, instead of on every access
+        ecs->QueryAllChunks(
+            Each<const GlobalTransformData, DecomposedGlobalTransformData>(),
+            [](
+                const Entity* entities, const GlobalTransformData* globalTransforms,
+                DecomposedGlobalTransformData* decomposedTransforms, size_t count
+            ) {
+                for (size_t i = 0; i < count; ++i)
+                    decomposedTransforms[i] = DecomposedGlobalTransformData(globalTransforms[i].Value);
+            }
+        );
+
+        // Transform the bounds of entities that have them, e.g. for culling them against the view of a camera
+        ecs->QueryAllChunks(
+            Each<const GlobalTransformData, const LocalBoundsData, WorldBoundsData>(),
+            [](
+                const Entity* entities, const GlobalTransformData* globalTransforms, const LocalBoundsData* localBounds,
+                WorldBoundsData* worldBounds, size_t count
+            ) {
+                for (size_t i = 0; i < count; ++i)
+                    worldBounds[i].Value = localBounds[i].Value.TransformedBy(globalTransforms[i].Value);
+            }
+        );
+
+        // All transforms are up to date, so transforms that were marked as changed do not need to be updated anymore
+        // Only chunks in which an entity was marked since the last update can contain set flags
+        ecs->QueryAllChunks(
+            Each<TransformDirtyData>(), Any(), None(), Changed<TransformDirtyData>(),
+            [](const Entity* entities, TransformDirtyData* dirty, size_t count) {
+                for (size_t i = 0; i < count; ++i)
+                    dirty[i].IsDirty = false;
             }
         );
     }
@@ -37,17 +213,32 @@ namespace modulith{
         float4x4 currentObjectToWorld,
         bool parentDisabled
     ) {
-        auto localTransform = current.Get<LocalTransformData>(ecs);
+        auto[
+            localTransform, globalTransform, inverseGlobalTransform, decomposedGlobalTransform, localBounds, worldBounds,
+            disabled, disabledInHierarchy
+        ] = ecs->GetComponents<
+            const LocalTransformData, GlobalTransformData, InverseGlobalTransformData, DecomposedGlobalTransformData,
+            const LocalBoundsData, WorldBoundsData, const DisabledTag, const IndirectlyDisabledTag
+        >(current);
+
         if (localTransform != nullptr)
             currentObjectToWorld = currentObjectToWorld * localTransform->Value;
 
-        auto globalTransform = ecs->GetComponent<GlobalTransformData>(current);
         if (globalTransform != nullptr)
             globalTransform->Value = currentObjectToWorld;
 
-        auto isDisabled = current.Has<DisabledTag>(ecs);
+        if (inverseGlobalTransform != nullptr)
+            inverseGlobalTransform->Value = glm::affineInverse(currentObjectToWorld);
+
+        if (decomposedGlobalTransform != nullptr)
+            *decomposedGlobalTransform = DecomposedGlobalTransformData(currentObjectToWorld);
+
+        if (localBounds != nullptr && worldBounds != nullptr)
+            worldBounds->Value = localBounds->Value.TransformedBy(currentObjectToWorld);
+
+        auto isDisabled = disabled != nullptr;
 
-        auto isDisabledInHierarchy = current.Has<IndirectlyDisabledTag>(ecs);
+        auto isDisabledInHierarchy = disabledInHierarchy != nullptr;
         if((isDisabled || parentDisabled) && !isDisabledInHierarchy) {
             if(ecs->IsInsideQuery()) // this method may be called outside of a query through UpdateGlobalTransformsBelow
                 current.AddDeferred<IndirectlyDisabledTag>(ecs);
@@ -61,7 +252,7 @@ namespace modulith{
                 current.Remove<IndirectlyDisabledTag>(ecs);
         }
 
-        auto children = current.Get<WithChildrenData>(ecs);
+        auto children = current.Get<const WithChildrenData>(ecs);
         if (children != nullptr) {
             for (auto& child : children->Values)
                 updateGlobalTransformRec(ecs, child, currentObjectToWorld, (parentDisabled || isDisabled));
@@ -71,17 +262,18 @@ namespace modulith{
     void GlobalTransformSystem::UpdateGlobalTransformsBelow(ref<EntityManager> ecs, Entity entity) {
         auto transform = glm::identity<float4x4>();
 
-        auto parent = ecs->GetComponent<WithParentData>(entity);
+        auto parent = ecs->GetComponent<const WithParentData>(entity);
 
         bool parentDisabled = false;
 
         if (parent) {
-            auto parentTransform = parent->Value.Get<GlobalTransformData>(ecs);
+            auto parentEntity = parent->Value;
+            auto parentTransform = parentEntity.Get<const GlobalTransformData>(ecs);
 
             if (parentTransform)
                 transform = parentTransform->Value;
 
-            parentDisabled = parent->Value.Has<IndirectlyDisabledTag>(ecs);
+            parentDisabled = parentEntity.Has<IndirectlyDisabledTag>(ecs);
         }
 
         updateGlobalTransformRec(ecs, entity, transform, parentDisabled);
@@ -8,34 +8,324 @@
 #include <ecs/ECSContext.h>
 #include "Context.h"
 
+#if defined(_M_X64) || defined(__SSE2__)
+    #include <xmmintrin.h>
+    #define MODU_TRANSFORM_KERNEL_SSE
+#endif
+
+// Only enabled if the compiler may use AVX2 for the whole build (/arch:AVX2 or -mavx2), there is no runtime dispatch
+#if defined(MODU_TRANSFORM_KERNEL_SSE) && defined(__AVX2__)
+    #include <immintrin.h>
+    #define MODU_TRANSFORM_KERNEL_AVX
+#endif
+
 namespace modulith{
 
+    namespace {
+
+        /**
+         * Composes translation * rotation * scale directly from the quaternion, without any matrix multiplication.
+         * The result is equal to glm::translate(position) * glm::mat4_cast(rotation) * glm::scale(scale).
+         * Missing components of the archetype are treated as identity at compile time.
+         * @param from The index of the first entity to compose (inclusive)
+         * @param to The index of the last entity to compose (exclusive)
+         */
+        template<bool HasPosition, bool HasRotation, bool HasScale>
+        void composeTransformsScalar(
+            const PositionData* positions, const RotationData* rotations, const ScaleData* scales,
+            LocalTransformData* localTransforms, size_t from, size_t to
+        ) {
+            for (size_t i = from; i < to; ++i) {
+                auto position = HasPosition ? positions[i].Value : float3(0.0f);
+                auto scale = HasScale ? scales[i].Value : float3(1.0f);
+                auto& matrix = localTransforms[i].Value;
+
+                if constexpr (HasRotation) {
+                    const auto& q = rotations[i].Value;
+                    auto xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+                    auto xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+                    auto wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+                    matrix[0] = float4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f) * scale.x;
+                    matrix[1] = float4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f) * scale.y;
+                    matrix[2] = float4(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f) * scale.z;
+                } else {
+                    matrix[0] = float4(scale.x, 0.0f, 0.0f, 0.0f);
+                    matrix[1] = float4(0.0f, scale.y, 0.0f, 0.0f);
+                    matrix[2] = float4(0.0f, 0.0f, scale.z, 0.0f);
+                }
+                matrix[3] = float4(position, 1.0f);
+            }
+        }
+
+#ifdef MODU_TRANSFORM_KERNEL_SSE
+
+        static_assert(sizeof(PositionData) == 3 * sizeof(float) && sizeof(ScaleData) == 3 * sizeof(float));
+        static_assert(sizeof(RotationData) == 4 * sizeof(float));
+        static_assert(offsetof(RotationData, Value.w) == 3 * sizeof(float), "Quaternions are loaded in xyzw order");
+
+        /**
+         * Loads four consecutive float3 values with three vector loads and splits them into one register per axis
+         */
+        inline void loadFloat3x4(const float* values, __m128& x, __m128& y, __m128& z) {
+            auto a = _mm_loadu_ps(values);     // x0 y0 z0 x1
+            auto b = _mm_loadu_ps(values + 4); // y1 z1 x2 y2
+            auto c = _mm_loadu_ps(values + 8); // z2 x3 y3 z3
+
+            x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 2, 2)), _MM_SHUFFLE(3, 0, 3, 0));
+            y = _mm_shuffle_ps(
+                _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+                _MM_SHUFFLE(2, 0, 2, 0)
+            );
+            z = _mm_shuffle_ps(
+                _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+                _MM_SHUFFLE(2, 0, 2, 0)
+            );
+        }
+
+        /**
+         * Loads four consecutive quaternions with four vector loads and transposes them into one register per component
+         */
+        inline void loadQuaternions4(const RotationData* rotations, __m128& x, __m128& y, __m128& z, __m128& w) {
+            x = _mm_loadu_ps(&rotations[0].Value.x);
+            y = _mm_loadu_ps(&rotations[1].Value.x);
+            z = _mm_loadu_ps(&rotations[2].Value.x);
+            w = _mm_loadu_ps(&rotations[3].Value.x);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+        }
+
+        /**
+         * Stores a transposed matrix column for four consecutive entities
+         */
+        inline void scatterColumn4(LocalTransformData* localTransforms, int column, __m128 c0, __m128 c1, __m128 c2, __m128 c3) {
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+            _mm_storeu_ps(&localTransforms[0].Value[column][0], c0);
+            _mm_storeu_ps(&localTransforms[1].Value[column][0], c1);
+            _mm_storeu_ps(&localTransforms[2].Value[column][0], c2);
+            _mm_storeu_ps(&localTransforms[3].Value[column][0], c3);
+        }
+
+        inline __m128 add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+        inline __m128 sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+        inline __m128 mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+
+#ifdef MODU_TRANSFORM_KERNEL_AVX
+        inline __m256 add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+        inline __m256 sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+        inline __m256 mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+#endif
+
+        /**
+         * Composes the upper 3x3 part of the matrices from the quaternions and scales, the same way composeTransformsScalar does.
+         * @param matrix Receives the columns of the matrices, matrix[column * 3 + row]
+         */
+        template<class TRegister>
+        inline void composeRotationScale(
+            TRegister qx, TRegister qy, TRegister qz, TRegister qw, TRegister sx, TRegister sy, TRegister sz,
+            TRegister one, TRegister two, TRegister* matrix
+        ) {
+            auto xx = mul(qx, qx), yy = mul(qy, qy), zz = mul(qz, qz);
+            auto xy = mul(qx, qy), xz = mul(qx, qz), yz = mul(qy, qz);
+            auto wx = mul(qw, qx), wy = mul(qw, qy), wz = mul(qw, qz);
+
+            matrix[0] = mul(sub(one, mul(two, add(yy, zz))), sx);
+            matrix[1] = mul(mul(two, add(xy, wz)), sx);
+            matrix[2] = mul(mul(two, sub(xz, wy)), sx);
+
+            matrix[3] = mul(mul(two, sub(xy, wz)), sy);
+            matrix[4] = mul(sub(one, mul(two, add(xx, zz))), sy);
+            matrix[5] = mul(mul(two, add(yz, wx)), sy);
+
+            matrix[6] = mul(mul(two, add(xz, wy)), sz);
+            matrix[7] = mul(mul(two, sub(yz, wx)), sz);
+            matrix[8] = mul(sub(one, mul(two, add(xx, yy))), sz);
+        }
+
+        /**
+         * The SSE version of composeTransformsScalar. Four entities are composed at once:
+         * Their values are loaded with vector loads, split into a structure of arrays (one register per scalar),
+         * composed and transposed back into matrices.
+         * @param from The index of the first entity to compose
+         * @return Returns the index after the last composed entity, the remaining entities are fewer than four
+         */
+        template<bool HasPosition, bool HasRotation, bool HasScale>
+        size_t composeTransformsSSE(
+            const PositionData* positions, const RotationData* rotations, const ScaleData* scales,
+            LocalTransformData* localTransforms, size_t from, size_t count
+        ) {
+            const auto zero = _mm_setzero_ps();
+            const auto one = _mm_set1_ps(1.0f);
+            const auto two = _mm_set1_ps(2.0f);
+
+            size_t i = from;
+            for (; i + 4 <= count; i += 4) {
+                auto px = zero, py = zero, pz = zero;
+                if constexpr (HasPosition)
+                    loadFloat3x4(&positions[i].Value.x, px, py, pz);
+
+                auto sx = one, sy = one, sz = one;
+                if constexpr (HasScale)
+                    loadFloat3x4(&scales[i].Value.x, sx, sy, sz);
+
+                __m128 matrix[9] = {sx, zero, zero, zero, sy, zero, zero, zero, sz};
+                if constexpr (HasRotation) {
+                    __m128 qx, qy, qz, qw;
+                    loadQuaternions4(rotations + i, qx, qy, qz, qw);
+                    composeRotationScale(qx, qy, qz, qw, sx, sy, sz, one, two, matrix);
+                }
+
+                scatterColumn4(localTransforms + i, 0, matrix[0], matrix[1], matrix[2], zero);
+                scatterColumn4(localTransforms + i, 1, matrix[3], matrix[4], matrix[5], zero);
+                scatterColumn4(localTransforms + i, 2, matrix[6], matrix[7], matrix[8], zero);
+                scatterColumn4(localTransforms + i, 3, px, py, pz, one);
+            }
+            return i;
+        }
+
+#endif
+
+#ifdef MODU_TRANSFORM_KERNEL_AVX
+
+        inline __m256 combine(__m128 low, __m128 high) {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+        }
+
+        /**
+         * The AVX version of composeTransformsSSE, which composes eight entities at once.
+         * The values are loaded and stored in two halves of four entities, only the composition uses the full width.
+         * @param from The index of the first entity to compose
+         * @return Returns the index after the last composed entity, the remaining entities are fewer than eight
+         */
+        template<bool HasPosition, bool HasRotation, bool HasScale>
+        size_t composeTransformsAVX(
+            const PositionData* positions, const RotationData* rotations, const ScaleData* scales,
+            LocalTransformData* localTransforms, size_t from, size_t count
+        ) {
+            const auto zero = _mm_setzero_ps();
+            const auto one = _mm_set1_ps(1.0f);
+
+            size_t i = from;
+            for (; i + 8 <= count; i += 8) {
+                __m128 px[2] = {zero, zero}, py[2] = {zero, zero}, pz[2] = {zero, zero};
+                __m128 sx[2] = {one, one}, sy[2] = {one, one}, sz[2] = {one, one};
+                __m128 qx[2], qy[2], qz[2], qw[2];
+                for (int half = 0; half < 2; ++half) {
+                    auto first = i + 4 * half;
+                    if constexpr (HasPosition)
+                        loadFloat3x4(&positions[first].Value.x, px[half], py[half], pz[half]);
+                    if constexpr (HasScale)
+                        loadFloat3x4(&scales[first].Value.x, sx[half], sy[half], sz[half]);
+                    if constexpr (HasRotation)
+                        loadQuaternions4(rotations + first, qx[half], qy[half], qz[half], qw[half]);
+                }
+
+                // Without a rotation, the matrix only consists of the scale and does not need any arithmetic
+                __m128 matrix[2][9];
+                for (int half = 0; half < 2; ++half) {
+                    matrix[half][0] = sx[half], matrix[half][1] = zero, matrix[half][2] = zero;
+                    matrix[half][3] = zero, matrix[half][4] = sy[half], matrix[half][5] = zero;
+                    matrix[half][6] = zero, matrix[half][7] = zero, matrix[half][8] = sz[half];
+                }
+                if constexpr (HasRotation) {
+                    __m256 composed[9];
+                    composeRotationScale(
+                        combine(qx[0], qx[1]), combine(qy[0], qy[1]), combine(qz[0], qz[1]), combine(qw[0], qw[1]),
+                        combine(sx[0], sx[1]), combine(sy[0], sy[1]), combine(sz[0], sz[1]),
+                        _mm256_set1_ps(1.0f), _mm256_set1_ps(2.0f), composed
+                    );
+                    for (int element = 0; element < 9; ++element) {
+                        matrix[0][element] = _mm256_castps256_ps128(composed[element]);
+                        matrix[1][element] = _mm256_extractf128_ps(composed[element], 1);
+                    }
+                }
+
+                for (int half = 0; half < 2; ++half) {
+                    auto* halfTransforms = localTransforms + i + 4 * half;
+                    auto& m = matrix[half];
+                    scatterColumn4(halfTransforms, 0, m[0], m[1], m[2], zero);
+                    scatterColumn4(halfTransforms, 1, m[3], m[4], m[5], zero);
+                    scatterColumn4(halfTransforms, 2, m[6], m[7], m[8], zero);
+                    scatterColumn4(halfTransforms, 3, px[half], py[half], pz[half], one);
+                }
+            }
+            return i;
+        }
+
+#endif
+
+        template<bool HasPosition, bool HasRotation, bool HasScale>
+        void composeTransforms(
+            const PositionData* positions, const RotationData* rotations, const ScaleData* scales,
+            LocalTransformData* localTransforms, size_t count
+        ) {
+            size_t composed = 0;
+#ifdef MODU_TRANSFORM_KERNEL_AVX
+            composed = composeTransformsAVX<HasPosition, HasRotation, HasScale>(
+                positions, rotations, scales, localTransforms, composed, count
+            );
+#endif
+#ifdef MODU_TRANSFORM_KERNEL_SSE
+            composed = composeTransformsSSE<HasPosition, HasRotation, HasScale>(
+                positions, rotations, scales, localTransforms, composed, count
+            );
+#endif
+            composeTransformsScalar<HasPosition, HasRotation, HasScale>(
+                positions, rotations, scales, localTransforms, composed, count
+            );
+        }
+    }
+
     void LocalTransformSystem::OnUpdate(float deltaTime) {
 
         auto ecs = Context::GetInstance<ECSContext>()->GetEntityManager();
 
-        ecs->QueryAll(
-            Any<LocalTransformData, PositionData, RotationData, ScaleData>(),
-            [ecs](auto entity, auto* localTransform, auto* position, auto* rotation, auto* scale) {
-
-                auto localTransformMatrix = CalculateLocalTransform(position, rotation, scale);
+        // Chunks whose position, rotation and scale were not written to since the last update keep their local transform
+        ecs->QueryAllChunks(
+            Each(), Any<LocalTransformData, const PositionData, const RotationData, const ScaleData>(), None(),
+            Changed<PositionData, RotationData, ScaleData>(),
+            [ecs](
+                const Entity* entities, LocalTransformData* localTransforms, const PositionData* positions,
+                const RotationData* rotations, const ScaleData* scales, size_t count
+            ) {
+                if (localTransforms != nullptr) {
+                    CalculateLocalTransforms(positions, rotations, scales, localTransforms, count);
+                    return;
+                }
 
-                if (localTransform == nullptr) {
-                    entity.AddDeferred(ecs, LocalTransformData(localTransformMatrix));
-                } else {
-                    localTransform->Value = localTransformMatrix;
+                auto calculated = std::vector<LocalTransformData>(count);
+                CalculateLocalTransforms(positions, rotations, scales, calculated.data(), count);
+                for (size_t i = 0; i < count; ++i) {
+                    auto entity = entities[i];
+                    entity.AddDeferred(ecs, std::move(calculated[i]));
                 }
             }
         );
     }
 
-    float4x4 LocalTransformSystem::CalculateLocalTransform(PositionData* position, RotationData* rotation, ScaleData* scale) {
-        auto translationMatrix =
-            position != nullptr ? glm::translate(float4x4(1.0f), position->Value) : float4x4(1.0f);
-        auto rotationMatrix = rotation != nullptr ? glm::mat4_cast(rotation->Value) : float4x4(1.0f);
-        auto scaleMatrix = scale != nullptr ? glm::scale(float4x4(1.0f), scale->Value) : float4x4(1.0f);
+    float4x4 LocalTransformSystem::CalculateLocalTransform(
+        const PositionData* position, const RotationData* rotation, const ScaleData* scale
+    ) {
+        LocalTransformData localTransform;
+        CalculateLocalTransforms(position, rotation, scale, &localTransform, 1);
+        return localTransform.Value;
+    }
 
-        return translationMatrix * rotationMatrix * scaleMatrix;
+    void LocalTransformSystem::CalculateLocalTransforms(
+        const PositionData* positions, const RotationData* rotations, const ScaleData* scales,
+        LocalTransformData* localTransforms, size_t count
+    ) {
+        // Select the kernel of the chunk's archetype, so missing components cost nothing inside the loop
+        auto archetype = (positions != nullptr ? 1 : 0) | (rotations != nullptr ? 2 : 0) | (scales != nullptr ? 4 : 0);
+        switch (archetype) {
+            case 0: composeTransforms<false, false, false>(positions, rotations, scales, localTransforms, count); break;
+            case 1: composeTransforms<true, false, false>(positions, rotations, scales, localTransforms, count); break;
+            case 2: composeTransforms<false, true, false>(positions, rotations, scales, localTransforms, count); break;
+            case 3: composeTransforms<true, true, false>(positions, rotations, scales, localTransforms, count); break;
+            case 4: composeTransforms<false, false, true>(positions, rotations, scales, localTransforms, count); break;
+            case 5: composeTransforms<true, false, true>(positions, rotations, scales, localTransforms, count); break;
+            case 6: composeTransforms<false, true, true>(positions, rotations, scales, localTransforms, count); break;
+            default: composeTransforms<true, true, true>(positions, rotations, scales, localTransforms, count); break;
+        }
     }
 
 }
@@ -11,36 +11,111 @@
 namespace modulith{
 
     void ParentSystem::OnUpdate(float deltaTime) {
-        auto ecs = Context::GetInstance<ECSContext>()->GetEntityManager();
+        UpdateHierarchy(Context::GetInstance<ECSContext>()->GetEntityManager());
+    }
+
+    void ParentSystem::UpdateHierarchy(ref<EntityManager> ecs) {
+        // Structural changes to the hierarchy are collected first, because they cannot be applied while iterating
+        std::vector<std::pair<Entity, Entity>> toAttach;
+        std::vector<std::pair<Entity, Entity>> toReattach;
+        std::vector<std::pair<Entity, Entity>> toDetach;
 
-        std::unordered_multimap<Entity, Entity, EntityHasher> childrenOf;
+        // Entities that got a parent since the last update
+        ecs->QueryAll(
+            Each<const WithParentData>(), None<HierarchyNodeData>(), Changed<WithParentData>(),
+            [&toAttach](auto entity, auto& parent) { toAttach.emplace_back(entity, parent.Value); }
+        );
 
-        // Collect all the Parent's Children
+        // Entities whose parent was changed since the last update
         ecs->QueryAll(
-            Each<WithParentData>(), [&childrenOf](auto entity, auto& parent) {
-                childrenOf.emplace(parent.Value, entity);
+            Each<const WithParentData, const HierarchyNodeData>(), Changed<WithParentData>(),
+            [&toReattach](auto entity, auto& parent, auto& node) {
+                if (parent.Value != node.Parent)
+                    toReattach.emplace_back(entity, parent.Value);
             }
         );
 
-        // All entities with children have a child component
-        for (auto& withChildren : childrenOf) {
-            ecs->AddComponent<WithChildrenData>(withChildren.first);
+        // Entities whose parent was removed since the last update, which moved them into a different chunk
+        ecs->QueryAll(
+            Each<const HierarchyNodeData>(), None<WithParentData>(), Changed<HierarchyNodeData>(),
+            [&toDetach](auto entity, auto& node) { toDetach.emplace_back(entity, node.Parent); }
+        );
+
+        // The depth of all entities below a changed entity needs to be recalculated
+        std::vector<Entity> changedSubtrees;
+
+        for (auto[child, parent] : toDetach) {
+            detach(ecs, child, parent);
+            ecs->RemoveComponent<HierarchyNodeData>(child);
+            changedSubtrees.push_back(child);
         }
 
-        // Apply the children
-        ecs->QueryAll(
-            Each<WithChildrenData>(), [&childrenOf, ecs](auto entity, auto& children) {
-                children.Values.clear();
-                auto range = childrenOf.equal_range(entity);
-                auto hasChildren = range.first != range.second;
-                if (hasChildren)
-                    for_each(
-                        range.first, range.second, [&children](auto& child) { children.Values.push_back(child.second); }
-                    );
-                else
-                    entity.template RemoveDeferred<WithChildrenData>(ecs);
+        for (auto[child, parent] : toReattach) {
+            detach(ecs, child, ecs->GetComponent<const HierarchyNodeData>(child)->Parent);
+            if (!attach(ecs, child, parent))
+                ecs->RemoveComponent<HierarchyNodeData>(child);
+            changedSubtrees.push_back(child);
+        }
+
+        for (auto[child, parent] : toAttach) {
+            if (attach(ecs, child, parent))
+                changedSubtrees.push_back(child);
+        }
+
+        for (auto entity : changedSubtrees)
+            updateDepthsBelow(ecs, entity);
+    }
+
+    void ParentSystem::detach(ref<EntityManager>& ecs, Entity child, Entity parent) {
+        if (!ecs->IsAlive(parent))
+            return;
+        auto* children = ecs->GetComponent<WithChildrenData>(parent);
+        if (children != nullptr && children->Remove(child) && children->Values.empty())
+            ecs->RemoveComponent<WithChildrenData>(parent);
+    }
+
+    bool ParentSystem::attach(ref<EntityManager>& ecs, Entity child, Entity parent) {
+        if (!ecs->IsAlive(parent))
+            return false;
+
+        auto* children = ecs->GetComponent<WithChildrenData>(parent);
+        if (children == nullptr)
+            children = ecs->AddComponent<WithChildrenData>(parent);
+        children->Add(child);
+
+        // The depth is set by updateDepthsBelow, once all parents are attached
+        if (auto* node = ecs->GetComponent<HierarchyNodeData>(child))
+            node->Parent = parent;
+        else
+            ecs->AddComponent(child, HierarchyNodeData(parent, 0));
+        return true;
+    }
+
+    void ParentSystem::updateDepthsBelow(ref<EntityManager>& ecs, Entity entity) {
+        uint32_t depth = 0;
+        if (auto* node = ecs->GetComponent<HierarchyNodeData>(entity)) {
+            auto* parentNode = ecs->GetComponent<const HierarchyNodeData>(node->Parent);
+            node->Depth = parentNode != nullptr ? parentNode->Depth + 1 : 1;
+            depth = node->Depth;
+        }
+
+        std::vector<std::pair<Entity, uint32_t>> toVisit = {{entity, depth}};
+        while (!toVisit.empty()) {
+            auto[current, currentDepth] = toVisit.back();
+            toVisit.pop_back();
+
+            auto* children = ecs->GetComponent<const WithChildrenData>(current);
+            if (children == nullptr)
+                continue;
+            for (auto child : children->Values) {
+                // Every entity below has a single parent, so a parent cycle can only lead back to the given entity
+                if (child == entity)
+                    continue;
+                if (auto* node = ecs->GetComponent<HierarchyNodeData>(child))
+                    node->Depth = currentDepth + 1;
+                toVisit.emplace_back(child, currentDepth + 1);
             }
-        );
+        }
     }
 
 }
@@ -8,24 +8,41 @@
 
 namespace modulith{
 
-    float3 LocalTransformData::Right() const {
-        return glm::normalize(Value[0]);
+    namespace {
+        bool hasSmallerId(const Entity& lhs, const Entity& rhs) { return lhs.GetId() < rhs.GetId(); }
+
+        // Only the rotational part is converted, instead of building the whole unscaled 4x4 matrix
+        quat rotationOf(const float4x4& transform) {
+            return glm::quat_cast(
+                float3x3(
+                    glm::normalize(float3(transform[0])),
+                    glm::normalize(float3(transform[1])),
+                    glm::normalize(float3(transform[2]))
+                )
+            );
+        }
     }
 
-    float3 LocalTransformData::Up() const {
-        return glm::normalize(Value[1]);
+    bool WithChildrenData::Contains(Entity child) const {
+        return std::binary_search(Values.begin(), Values.end(), child, hasSmallerId);
     }
 
-    float3 LocalTransformData::Forward() const {
-        return glm::normalize(Value[2]);
+    void WithChildrenData::Add(Entity child) {
+        auto it = std::lower_bound(Values.begin(), Values.end(), child, hasSmallerId);
+        if (it == Values.end() || *it != child)
+            Values.insert(it, child);
     }
 
-    float3 LocalTransformData::Position() const {
-        return Value[3];
+    bool WithChildrenData::Remove(Entity child) {
+        auto it = std::lower_bound(Values.begin(), Values.end(), child, hasSmallerId);
+        if (it == Values.end() || *it != child)
+            return false;
+        Values.erase(it);
+        return true;
     }
 
     quat LocalTransformData::Rotation() const {
-        return glm::quat_cast(UnscaledTransform());
+        return rotationOf(Value);
     }
 
     float3 LocalTransformData::Scale() const {
@@ -42,27 +59,10 @@ namespace modulith{
         );
     }
 
-    float3 GlobalTransformData::Right() const {
-        return glm::normalize(Value[0]);
-    }
-
-    float3 GlobalTransformData::Up() const {
-        return glm::normalize(Value[1]);
-    }
-
-    float3 GlobalTransformData::Forward() const {
-        return glm::normalize(Value[2]);
-    }
-
-    float3 GlobalTransformData::Position() const {
-        return Value[3];
-    }
-
     quat GlobalTransformData::Rotation() const {
-        return glm::quat_cast(UnscaledTransform());
+        return rotationOf(Value);
     }
 
-
     float3 GlobalTransformData::Scale() const {
         return float3(
             glm::length(Value[0]), glm::length(Value[1]), glm::length(Value[2]));
@@ -76,4 +76,9 @@ namespace modulith{
             Value[3]
         );
     }
+
+    DecomposedGlobalTransformData::DecomposedGlobalTransformData(const float4x4& transform) :
+        Position(transform[3]),
+        Rotation(rotationOf(transform)),
+        Scale(glm::length(float3(transform[0])), glm::length(float3(transform[1])), glm::length(float3(transform[2]))) {}
 }
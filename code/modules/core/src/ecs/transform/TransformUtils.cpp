@@ -11,28 +11,75 @@
 namespace modulith{
 
     void TransformUtils::UpdateTransformOf(ref<EntityManager> ecs, Entity entity) {
+        updateLocalTransformOf(ecs, entity);
+        GlobalTransformSystem::UpdateGlobalTransformsBelow(ecs, entity);
+    }
+
+    void TransformUtils::MarkTransformDirty(ref<EntityManager> ecs, Entity entity) {
+        // Only entities that were never marked before are moved into another chunk
+        auto* dirty = ecs->GetComponent<TransformDirtyData>(entity);
+        if (dirty != nullptr)
+            dirty->IsDirty = true;
+        else if (ecs->IsInsideQuery())
+            entity.AddDeferred<TransformDirtyData>(ecs);
+        else
+            entity.Add<TransformDirtyData>(ecs);
+    }
 
-        // TODO DG: Get multiple components at once for more performance?
-        auto localTransform = LocalTransformSystem::CalculateLocalTransform(
-            ecs->GetComponent<PositionData>(entity),
-            ecs->GetComponent<RotationData>(entity),
-            ecs->GetComponent<ScaleData>(entity)
+    void TransformUtils::UpdateDirtyTransforms(ref<EntityManager> ecs) {
+        EntitySet dirtyEntities;
+        ecs->QueryAllChunks(
+            Each<TransformDirtyData>(), [&dirtyEntities](const Entity* entities, TransformDirtyData* dirty, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    if (dirty[i].IsDirty)
+                        dirtyEntities.insert(entities[i]);
+                    dirty[i].IsDirty = false;
+                }
+            }
         );
-        auto localTransformComponent = ecs->GetComponent<LocalTransformData>(entity);
+        if (dirtyEntities.empty())
+            return;
+
+        for (auto entity : dirtyEntities)
+            updateLocalTransformOf(ecs, entity);
 
-        if (localTransformComponent)
-            localTransformComponent->Value = localTransform;
+        // The subtrees below dirty entities are updated once, even if they contain other dirty entities
+        for (auto entity : dirtyEntities) {
+            if (!hasDirtyAncestor(ecs, entity, dirtyEntities))
+                GlobalTransformSystem::UpdateGlobalTransformsBelow(ecs, entity);
+        }
+    }
+
+    void TransformUtils::updateLocalTransformOf(ref<EntityManager>& ecs, Entity entity) {
+        auto[position, rotation, scale, localTransform] =
+            ecs->GetComponents<const PositionData, const RotationData, const ScaleData, LocalTransformData>(entity);
+        auto calculated = LocalTransformSystem::CalculateLocalTransform(position, rotation, scale);
+
+        if (localTransform)
+            localTransform->Value = calculated;
         else
-            ecs->AddComponent(entity, LocalTransformData(localTransform));
+            ecs->AddComponent(entity, LocalTransformData(calculated));
+    }
 
-        GlobalTransformSystem::UpdateGlobalTransformsBelow(ecs, entity);
+    bool TransformUtils::hasDirtyAncestor(ref<EntityManager>& ecs, Entity entity, const EntitySet& dirtyEntities) {
+        auto current = entity;
+        // Bounds the walk for entities whose ancestors form a parent cycle
+        for (size_t steps = 0; steps < ecs->EntityCount(); ++steps) {
+            auto* parent = ecs->GetComponent<const WithParentData>(current);
+            if (parent == nullptr || !ecs->IsAlive(parent->Value) || parent->Value == entity)
+                return false;
+            current = parent->Value;
+            if (dirtyEntities.count(current) > 0)
+                return true;
+        }
+        return false;
     }
 
 
     void TransformUtils::ForAllChildren(ref<EntityManager> ecs, Entity entity, const std::function<void(ref<EntityManager>, Entity)>& fn) {
         if (ecs->IsAlive(entity)) {
             fn(ecs, entity);
-            auto children = entity.Get<WithChildrenData>(ecs);
+            auto children = entity.Get<const WithChildrenData>(ecs);
             if (children) {
                 for (auto child : children->Values) {
                     ForAllChildren(ecs, child, fn);
@@ -9,7 +9,11 @@
 
 namespace modulith{
 
-    void InitializeImGui(Window& window) {
+    static bool ImGuiIsHeadless = false;
+
+    void InitializeImGui(Window& window, bool isHeadless) {
+        ImGuiIsHeadless = isHeadless;
+
         IMGUI_CHECKVERSION();
         ImGui::CreateContext();
         ImGuiIO& io = ImGui::GetIO();
@@ -83,20 +87,35 @@ namespace modulith{
 
         style->Colors[ImGuiCol_DockingPreview] = ImVec4(0.851f, 0.497f, 0.263f, 0.650f);
 
+        if (ImGuiIsHeadless) {
+            // Normally done by the OpenGL backend when it uploads the font texture
+            unsigned char* pixels;
+            int width, height;
+            io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+            return;
+        }
+
         window.InitImGui();
         ImGui_ImplOpenGL3_Init("#version 410");
     }
 
     void ShutdownImGui(Window& window) {
-        ImGui_ImplOpenGL3_Shutdown();
-        ImGui_ImplGlfw_Shutdown();
+        if (!ImGuiIsHeadless) {
+            ImGui_ImplOpenGL3_Shutdown();
+            ImGui_ImplGlfw_Shutdown();
+        }
         ImGui::DestroyContext();
     }
 
 
     void BeginImGuiRender(Window& window, bool imguiWindowsEnabled) {
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
+        if (ImGuiIsHeadless) {
+            // Normally done by the GLFW backend
+            ImGui::GetIO().DisplaySize = ImVec2((float) window.GetWidth(), (float) window.GetHeight());
+        } else {
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+        }
         ImGui::NewFrame();
 
         if(imguiWindowsEnabled){
@@ -131,7 +150,8 @@ namespace modulith{
 
         // Rendering
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        if (!ImGuiIsHeadless)
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
     }
 
 }
@@ -2,7 +2,11 @@
 
 namespace modulith{
 
-    void InitializeImGui(Window& window);
+    /**
+     * Initializes ImGui for the given window.
+     * Headless ImGui runs without its GLFW and OpenGL backends, so its frames are built but never drawn
+     */
+    void InitializeImGui(Window& window, bool isHeadless);
     void ShutdownImGui(Window& window);
 
     void BeginImGuiRender(Window& window, bool imguiWindowsEnabled);
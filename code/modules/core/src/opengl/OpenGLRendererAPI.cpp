@@ -8,6 +8,7 @@
 #include <opengl/primitives/OpenGLVertexArray.h>
 #include <opengl/primitives/OpenGLShader.h>
 #include <opengl/primitives/OpenGLTexture.h>
+#include <opengl/primitives/OpenGLFrameBuffer.h>
 #include "OpenGLRendererAPI.h"
 
 namespace modulith{
@@ -25,10 +26,20 @@ namespace modulith{
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
 
+    void OpenGLRendererAPI::SetViewport(int2 size) {
+        glViewport(0, 0, size.x, size.y);
+    }
+
     void OpenGLRendererAPI::DrawIndexed(const shared<VertexArray>& vertexArray) {
         glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
     }
 
+    void OpenGLRendererAPI::DrawIndexedInstanced(const shared<VertexArray>& vertexArray, uint32_t instanceCount) {
+        glDrawElementsInstanced(
+            GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr, instanceCount
+        );
+    }
+
     shared <VertexBuffer> OpenGLRendererAPI::CreateVertexBuffer(float* vertices, uint32_t size) {
         return std::make_shared<OpenGLVertexBuffer>(vertices, size);
     }
@@ -41,22 +52,34 @@ namespace modulith{
         return std::make_shared<OpenGLIndexBuffer>(indices, count);
     }
 
+    shared <UniformBuffer> OpenGLRendererAPI::CreateUniformBuffer(uint32_t bindingPoint) {
+        return std::make_shared<OpenGLUniformBuffer>(bindingPoint);
+    }
+
     shared <VertexArray> OpenGLRendererAPI::CreateVertexArray() {
-        return std::make_shared<OpenGLVertexArray>();
+        return std::make_shared<OpenGLVertexArray>(_stateCache);
     }
 
     shared <Shader> OpenGLRendererAPI::CreateShader(const Address& address) {
-        return std::make_shared<OpenGLShader>(Context::GetInstance<AssetContext>()->ResolveAddressOrThrow(address, "OpenGLRenderAPI.CreateShader"));
+        return std::make_shared<OpenGLShader>(
+            _stateCache, Context::GetInstance<AssetContext>()->ResolveAddressOrThrow(address, "OpenGLRenderAPI.CreateShader")
+        );
     }
 
     shared <Shader> OpenGLRendererAPI::CreateShader(
         const std::string& name, const std::string& vertexSource, const std::string& fragmentSource
     ) {
-        return std::make_shared<OpenGLShader>(name, vertexSource, fragmentSource);
+        return std::make_shared<OpenGLShader>(_stateCache, name, vertexSource, fragmentSource);
     }
 
     shared <Texture2D> OpenGLRendererAPI::CreateTexture2D(const Address& address) {
-        return std::make_shared<OpenGLTexture2D>(Context::GetInstance<AssetContext>()->ResolveAddressOrThrow(address, "OpenGLRenderAPI.CreateTexture2D"));
+        return std::make_shared<OpenGLTexture2D>(
+            _stateCache, Context::GetInstance<AssetContext>()->ResolveAddressOrThrow(address, "OpenGLRenderAPI.CreateTexture2D")
+        );
+    }
+
+    shared <FrameBuffer> OpenGLRendererAPI::CreateFrameBuffer(int2 size) {
+        return std::make_shared<OpenGLFrameBuffer>(_stateCache, size);
     }
 
 }
@@ -18,14 +18,20 @@ namespace modulith{
         void SetClearColor(const glm::vec4& color) override;
         void Clear() override;
 
+        void SetViewport(int2 size) override;
+
         void DrawIndexed(const shared<VertexArray>& vertexArray) override;
 
+        void DrawIndexedInstanced(const shared<VertexArray>& vertexArray, uint32_t instanceCount) override;
+
         shared <VertexBuffer> CreateVertexBuffer(float* vertices, uint32_t size) override;
 
         shared <VertexBuffer> CreateVertexBuffer(void* vertexData, uint32_t size) override;
 
         shared <IndexBuffer> CreateIndexBuffer(uint32_t* indices, uint32_t count) override;
 
+        shared <UniformBuffer> CreateUniformBuffer(uint32_t bindingPoint) override;
+
         shared <VertexArray> CreateVertexArray() override;
 
         shared <Shader> CreateShader(const Address& address) override;
@@ -35,6 +41,21 @@ namespace modulith{
         ) override;
 
         shared <Texture2D> CreateTexture2D(const Address& address) override;
+
+        shared <FrameBuffer> CreateFrameBuffer(int2 size) override;
+
+        void InvalidateState() override { _stateCache->Invalidate(); }
+
+        [[nodiscard]] RenderStateCounters GetStateCounters() const override { return _stateCache->GetCounters(); }
+
+        void ResetStateCounters() override { _stateCache->ResetCounters(); }
+
+    private:
+        /**
+         * Shared with every vertex array, shader and texture created by this API,
+         * so they skip binds and uploads of state that is already set
+         */
+        shared<RenderStateCache> _stateCache = std::make_shared<RenderStateCache>();
     };
 
 
@@ -33,6 +33,12 @@ namespace modulith{
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
+    void OpenGLVertexBuffer::SetData(const void* data, uint32_t size) {
+        // Respecifying the whole storage lets the driver hand out new memory instead of waiting for pending draws
+        glBindBuffer(GL_ARRAY_BUFFER, _rendererId);
+        glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
+    }
+
 
     OpenGLIndexBuffer::OpenGLIndexBuffer(uint32_t* indices, uint32_t count) : _count(count) {
         glCreateBuffers(1, &_rendererId);
@@ -54,4 +60,22 @@ namespace modulith{
 
     uint32_t OpenGLIndexBuffer::GetCount() const { return _count; }
 
+
+    OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t bindingPoint) : _bindingPoint(bindingPoint) {
+        glCreateBuffers(1, &_rendererId);
+    }
+
+    OpenGLUniformBuffer::~OpenGLUniformBuffer() {
+        glDeleteBuffers(1, &_rendererId);
+    }
+
+    void OpenGLUniformBuffer::Bind() const {
+        glBindBufferBase(GL_UNIFORM_BUFFER, _bindingPoint, _rendererId);
+    }
+
+    void OpenGLUniformBuffer::SetData(const void* data, uint32_t size) {
+        glBindBuffer(GL_UNIFORM_BUFFER, _rendererId);
+        glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW);
+    }
+
 }
@@ -25,6 +25,8 @@ namespace modulith{
 
         void SetLayout(const BufferLayout& layout) override { _layout = layout; }
 
+        void SetData(const void* data, uint32_t size) override;
+
     private:
         uint32_t _rendererId;
         BufferLayout _layout;
@@ -47,4 +49,19 @@ namespace modulith{
         uint32_t _count;
     };
 
+    class OpenGLUniformBuffer : public UniformBuffer {
+    public:
+        explicit OpenGLUniformBuffer(uint32_t bindingPoint);
+
+        ~OpenGLUniformBuffer() override;
+
+        void Bind() const override;
+
+        void SetData(const void* data, uint32_t size) override;
+
+    private:
+        uint32_t _rendererId;
+        uint32_t _bindingPoint;
+    };
+
 }
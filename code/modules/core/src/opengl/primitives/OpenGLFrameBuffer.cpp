@@ -0,0 +1,58 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "OpenGLFrameBuffer.h"
+#include "glad/glad.h"
+
+namespace modulith{
+
+    OpenGLFrameBuffer::OpenGLFrameBuffer(shared<RenderStateCache> stateCache, int2 size)
+        : _stateCache(std::move(stateCache)), _size(size) {
+        create();
+    }
+
+    OpenGLFrameBuffer::~OpenGLFrameBuffer() {
+        destroy();
+    }
+
+    void OpenGLFrameBuffer::Bind() const {
+        glBindFramebuffer(GL_FRAMEBUFFER, _rendererId);
+        glViewport(0, 0, _size.x, _size.y);
+    }
+
+    void OpenGLFrameBuffer::Unbind() const {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    void OpenGLFrameBuffer::Resize(int2 size) {
+        // The storage of the attachments is immutable, so they are recreated
+        destroy();
+        _size = size;
+        create();
+    }
+
+    void OpenGLFrameBuffer::create() {
+        glCreateFramebuffers(1, &_rendererId);
+
+        _colorAttachment = std::make_unique<OpenGLTexture2D>(_stateCache, _size.x, _size.y);
+        glNamedFramebufferTexture(_rendererId, GL_COLOR_ATTACHMENT0, _colorAttachment->_rendererId, 0);
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &_depthAttachmentId);
+        glTextureStorage2D(_depthAttachmentId, 1, GL_DEPTH_COMPONENT24, _size.x, _size.y);
+        glTextureParameteri(_depthAttachmentId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(_depthAttachmentId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glNamedFramebufferTexture(_rendererId, GL_DEPTH_ATTACHMENT, _depthAttachmentId, 0);
+
+        if (glCheckNamedFramebufferStatus(_rendererId, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            CoreLogError("The frame buffer of size {}x{} is not complete!", _size.x, _size.y)
+    }
+
+    void OpenGLFrameBuffer::destroy() {
+        _colorAttachment.reset();
+        glDeleteTextures(1, &_depthAttachmentId);
+        glDeleteFramebuffers(1, &_rendererId);
+    }
+
+}
@@ -0,0 +1,41 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#pragma once
+
+#include <renderer/primitives/FrameBuffer.h>
+#include "OpenGLTexture.h"
+
+namespace modulith{
+
+    class OpenGLFrameBuffer : public FrameBuffer {
+    public:
+        OpenGLFrameBuffer(shared<RenderStateCache> stateCache, int2 size);
+
+        ~OpenGLFrameBuffer() override;
+
+        void Bind() const override;
+
+        void Unbind() const override;
+
+        void Resize(int2 size) override;
+
+        [[nodiscard]] int2 GetSize() const override { return _size; }
+
+        [[nodiscard]] uint32_t GetColorAttachmentRendererId() const override { return _colorAttachment->_rendererId; }
+
+    private:
+        void create();
+        void destroy();
+
+        shared<RenderStateCache> _stateCache;
+        int2 _size;
+
+        uint32_t _rendererId{};
+        owned<OpenGLTexture2D> _colorAttachment;
+        uint32_t _depthAttachmentId{};
+    };
+
+}
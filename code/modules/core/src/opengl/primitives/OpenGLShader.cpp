@@ -4,6 +4,7 @@
  */
 
 #include "OpenGLShader.h"
+#include "renderer/Renderer.h"
 #include <glad/glad.h>
 #include <fstream>
 #include <array>
@@ -20,7 +21,8 @@ namespace modulith{
         return 0;
     }
 
-    OpenGLShader::OpenGLShader(const std::filesystem::path& filePath) {
+    OpenGLShader::OpenGLShader(shared<RenderStateCache> stateCache, const std::filesystem::path& filePath)
+        : _stateCache(std::move(stateCache)) {
         auto filePathAsString = filePath.generic_string();
         auto lastSlash = filePathAsString.find_last_of("/\\");
         lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
@@ -33,8 +35,9 @@ namespace modulith{
         Compile(shaderSources);
     }
 
-    OpenGLShader::OpenGLShader(std::string  name, const std::string& vertexSource, const std::string& fragmentSource)
-        : _name(std::move(name)) {
+    OpenGLShader::OpenGLShader(
+        shared<RenderStateCache> stateCache, std::string name, const std::string& vertexSource, const std::string& fragmentSource
+    ) : _stateCache(std::move(stateCache)), _name(std::move(name)) {
         ShaderSources shaderSources;
         shaderSources[GL_VERTEX_SHADER] = vertexSource;
         shaderSources[GL_FRAGMENT_SHADER] = fragmentSource;
@@ -43,6 +46,7 @@ namespace modulith{
 
     OpenGLShader::~OpenGLShader() {
         glDeleteProgram(_rendererId);
+        _stateCache->ForgetProgram(_rendererId);
     }
 
     std::string OpenGLShader::ReadFile(const std::string& filePath) {
@@ -87,6 +91,25 @@ namespace modulith{
         return result;
     }
 
+    std::string OpenGLShader::injectRendererDefines(const std::string& source) {
+        auto defines =
+            "#define MAX_LIGHTS " + std::to_string(Renderer::MaxLights) + "\n" +
+            "#define MAX_LIGHTS_PER_OBJECT " + std::to_string(Renderer::MaxLightsPerObject) + "\n";
+
+        // Nothing but comments may precede the #version directive
+        auto version = source.find("#version");
+        if (version == std::string::npos)
+            return defines + source;
+
+        auto endOfLine = source.find('\n', version);
+        if (endOfLine == std::string::npos)
+            return source + "\n" + defines;
+
+        auto result = source;
+        result.insert(endOfLine + 1, defines);
+        return result;
+    }
+
     void OpenGLShader::Compile(const ShaderSources& shaderSources) {
 
         auto program = glCreateProgram();
@@ -101,7 +124,8 @@ namespace modulith{
 
             GLuint shader = glCreateShader(shaderType);
 
-            const GLchar* sourceCode = source.c_str();
+            auto sourceWithDefines = injectRendererDefines(source);
+            const GLchar* sourceCode = sourceWithDefines.c_str();
             glShaderSource(shader, 1, &sourceCode, 0);
 
             glCompileShader(shader);
@@ -152,78 +176,217 @@ namespace modulith{
         }
 
         _rendererId = program;
+        _isInstanced = glGetAttribLocation(program, "a_M") != -1;
+
+        auto sceneBlockIndex = glGetUniformBlockIndex(program, SceneUniformBlock::Name);
+        if (sceneBlockIndex != GL_INVALID_INDEX)
+            glUniformBlockBinding(program, sceneBlockIndex, SceneUniformBlock::BindingPoint);
+
+        reflectUniforms();
+    }
+
+    void OpenGLShader::reflectUniforms() {
+        _uniformLocations.clear();
+        _locationsById.clear();
+
+        GLint uniformCount = 0;
+        GLint maxNameLength = 0;
+        glGetProgramiv(_rendererId, GL_ACTIVE_UNIFORMS, &uniformCount);
+        glGetProgramiv(_rendererId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+        std::vector<GLchar> nameBuffer(std::max(maxNameLength, 1));
+        for (GLint i = 0; i < uniformCount; ++i) {
+            GLsizei nameLength = 0;
+            GLint arraySize = 0;
+            GLenum type = 0;
+            glGetActiveUniform(_rendererId, i, maxNameLength, &nameLength, &arraySize, &type, nameBuffer.data());
+
+            auto name = std::string(nameBuffer.data(), nameLength);
+            _uniformLocations[name] = glGetUniformLocation(_rendererId, name.c_str());
+
+            // Arrays of basic types are only reported by their first element as "name[0]",
+            // but every element and the name without index can be uploaded to as well
+            const std::string firstElementSuffix = "[0]";
+            if (name.size() > firstElementSuffix.size()
+                && name.compare(name.size() - firstElementSuffix.size(), firstElementSuffix.size(), firstElementSuffix) == 0) {
+                auto arrayName = name.substr(0, name.size() - firstElementSuffix.size());
+                _uniformLocations[arrayName] = _uniformLocations[name];
+                for (GLint element = 1; element < arraySize; ++element) {
+                    auto elementName = arrayName + "[" + std::to_string(element) + "]";
+                    _uniformLocations[elementName] = glGetUniformLocation(_rendererId, elementName.c_str());
+                }
+            }
+        }
+    }
+
+    int32_t OpenGLShader::locationOf(const std::string& name) const {
+        auto location = _uniformLocations.find(name);
+        return location != _uniformLocations.end() ? location->second : -1;
+    }
+
+    int32_t OpenGLShader::locationOf(const UniformId& id) {
+        // Locations are never below -1, so this marks ids whose location was not looked up yet
+        const int32_t unresolved = -2;
+
+        auto index = id.GetIndex();
+        if (index >= _locationsById.size())
+            _locationsById.resize(index + 1, unresolved);
+        if (_locationsById[index] == unresolved)
+            _locationsById[index] = locationOf(id.GetName());
+        return _locationsById[index];
     }
 
     void OpenGLShader::Bind() const {
-        glUseProgram(_rendererId);
+        if (_stateCache->BindProgram(_rendererId))
+            glUseProgram(_rendererId);
     }
 
     void OpenGLShader::Unbind() const {
-        glUseProgram(0);
+        if (_stateCache->BindProgram(0))
+            glUseProgram(0);
     }
 
 // --- INT ---
 
 
     void OpenGLShader::UploadUniformInt1(const std::string& name, const int value) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniform1i(location, value);
+        GLint location = locationOf(name);
+        if (shouldUpload(location, value))
+            glUniform1i(location, value);
     }
 
     void OpenGLShader::UploadUniformInt2(const std::string& name, const glm::vec<2, int> value) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniform2i(location, value.x, value.y);
+        GLint location = locationOf(name);
+        if (shouldUpload(location, value))
+            glUniform2i(location, value.x, value.y);
     }
 
     void OpenGLShader::UploadUniformInt3(const std::string& name, const glm::vec<3, int> value) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniform3i(location, value.x, value.y, value.z);
+        GLint location = locationOf(name);
+        if (shouldUpload(location, value))
+            glUniform3i(location, value.x, value.y, value.z);
     }
 
     void OpenGLShader::UploadUniformInt4(const std::string& name, const glm::vec<4, int> value) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniform4i(location, value.x, value.y, value.z, value.w);
+        GLint location = locationOf(name);
+        if (shouldUpload(location, value))
+            glUniform4i(location, value.x, value.y, value.z, value.w);
     }
 
 // --- FLOAT ---
 
     void OpenGLShader::UploadUniformFloat1(const std::string& name, const float value) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniform1f(location, value);
+        GLint location = locationOf(name);
+        if (shouldUpload(location, value))
+            glUniform1f(location, value);
     }
 
     void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& value) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniform2f(location, value.x, value.y);
+        GLint location = locationOf(name);
+        if (shouldUpload(location, value))
+            glUniform2f(location, value.x, value.y);
     }
 
     void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& value) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniform3f(location, value.x, value.y, value.z);
+        GLint location = locationOf(name);
+        if (shouldUpload(location, value))
+            glUniform3f(location, value.x, value.y, value.z);
     }
 
     void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& value) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniform4f(location, value.x, value.y, value.z, value.w);
+        GLint location = locationOf(name);
+        if (shouldUpload(location, value))
+            glUniform4f(location, value.x, value.y, value.z, value.w);
     }
 
 // --- MAT ---
 
     void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        GLint location = locationOf(name);
+        if (shouldUpload(location, matrix))
+            glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
     }
 
     void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        GLint location = locationOf(name);
+        if (shouldUpload(location, matrix))
+            glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
     }
 
 // --- BOOL ---
 
     void OpenGLShader::UploadUniformBool(const std::string& name, bool value) {
-        GLint location = glGetUniformLocation(_rendererId, name.c_str());
-        glUniform1i(location, value);
+        GLint location = locationOf(name);
+        if (shouldUpload(location, value))
+            glUniform1i(location, value);
+    }
+
+// --- BY ID ---
+
+    void OpenGLShader::UploadUniformInt1(const UniformId& id, int value) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, value))
+            glUniform1i(location, value);
+    }
+
+    void OpenGLShader::UploadUniformInt2(const UniformId& id, glm::vec<2, int> value) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, value))
+            glUniform2i(location, value.x, value.y);
+    }
+
+    void OpenGLShader::UploadUniformInt3(const UniformId& id, glm::vec<3, int> value) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, value))
+            glUniform3i(location, value.x, value.y, value.z);
+    }
+
+    void OpenGLShader::UploadUniformInt4(const UniformId& id, glm::vec<4, int> value) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, value))
+            glUniform4i(location, value.x, value.y, value.z, value.w);
+    }
+
+    void OpenGLShader::UploadUniformFloat1(const UniformId& id, float value) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, value))
+            glUniform1f(location, value);
+    }
+
+    void OpenGLShader::UploadUniformFloat2(const UniformId& id, const glm::vec2& value) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, value))
+            glUniform2f(location, value.x, value.y);
+    }
+
+    void OpenGLShader::UploadUniformFloat3(const UniformId& id, const glm::vec3& value) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, value))
+            glUniform3f(location, value.x, value.y, value.z);
+    }
+
+    void OpenGLShader::UploadUniformFloat4(const UniformId& id, const glm::vec4& value) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, value))
+            glUniform4f(location, value.x, value.y, value.z, value.w);
+    }
+
+    void OpenGLShader::UploadUniformMat3(const UniformId& id, const glm::mat3& matrix) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, matrix))
+            glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+    }
+
+    void OpenGLShader::UploadUniformMat4(const UniformId& id, const glm::mat4& matrix) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, matrix))
+            glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+    }
+
+    void OpenGLShader::UploadUniformBool(const UniformId& id, bool value) {
+        GLint location = locationOf(id);
+        if (shouldUpload(location, value))
+            glUniform1i(location, value);
     }
 
 }
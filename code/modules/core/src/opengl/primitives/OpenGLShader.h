@@ -7,6 +7,7 @@
 
 #include "CoreModule.h"
 #include <renderer/primitives/Shader.h>
+#include <renderer/RenderStateCache.h>
 #include <filesystem>
 
 namespace modulith{
@@ -16,9 +17,12 @@ namespace modulith{
 
     class OpenGLShader : public Shader {
     public:
-        explicit OpenGLShader(const std::filesystem::path& filePath);
+        OpenGLShader(shared<RenderStateCache> stateCache, const std::filesystem::path& filePath);
 
-        OpenGLShader(std::string  name, const std::string& vertexSource, const std::string& fragmentSource);
+        OpenGLShader(
+            shared<RenderStateCache> stateCache, std::string name, const std::string& vertexSource,
+            const std::string& fragmentSource
+        );
 
         ~OpenGLShader() override;
 
@@ -28,6 +32,8 @@ namespace modulith{
 
         [[nodiscard]] const std::string& GetName() const override { return _name; }
 
+        [[nodiscard]] bool IsInstanced() const override { return _isInstanced; }
+
         void UploadUniformInt1(const std::string& name, const int value) override;
 
         void UploadUniformInt2(const std::string& name, const glm::vec<2, int> value) override;
@@ -50,6 +56,28 @@ namespace modulith{
 
         void UploadUniformBool(const std::string& name, bool value) override;
 
+        void UploadUniformInt1(const UniformId& id, int value) override;
+
+        void UploadUniformInt2(const UniformId& id, glm::vec<2, int> value) override;
+
+        void UploadUniformInt3(const UniformId& id, glm::vec<3, int> value) override;
+
+        void UploadUniformInt4(const UniformId& id, glm::vec<4, int> value) override;
+
+        void UploadUniformFloat1(const UniformId& id, float value) override;
+
+        void UploadUniformFloat2(const UniformId& id, const glm::vec2& value) override;
+
+        void UploadUniformFloat3(const UniformId& id, const glm::vec3& value) override;
+
+        void UploadUniformFloat4(const UniformId& id, const glm::vec4& value) override;
+
+        void UploadUniformMat3(const UniformId& id, const glm::mat3& matrix) override;
+
+        void UploadUniformMat4(const UniformId& id, const glm::mat4& matrix) override;
+
+        void UploadUniformBool(const UniformId& id, bool value) override;
+
     private:
         std::string ReadFile(const std::string& filePath);
 
@@ -57,8 +85,40 @@ namespace modulith{
 
         void Compile(const ShaderSources& shaderSources);
 
+        /**
+         * Defines MAX_LIGHTS and MAX_LIGHTS_PER_OBJECT right after the #version directive of the source,
+         * so the light arrays and loops of shaders match the limits of the Renderer
+         */
+        static std::string injectRendererDefines(const std::string& source);
+
+        /**
+         * Queries the locations of all active uniforms once, so uploading a uniform never asks the driver
+         */
+        void reflectUniforms();
+
+        /**
+         * @return Returns the location of the uniform or -1, which is ignored by OpenGL, if the shader does not use it
+         */
+        [[nodiscard]] int32_t locationOf(const std::string& name) const;
+        [[nodiscard]] int32_t locationOf(const UniformId& id);
+
+        /**
+         * @return Returns whether the value differs from the one last uploaded to the location.
+         * Uploads go to the bound program, so this shader has to be bound.
+         */
+        template<class TValue>
+        bool shouldUpload(int32_t location, const TValue& value) {
+            return _stateCache->SetUniform(_rendererId, location, &value, sizeof(TValue));
+        }
+
+        shared<RenderStateCache> _stateCache;
         uint32_t _rendererId;
         std::string _name;
+        bool _isInstanced = false;
+
+        std::unordered_map<std::string, int32_t> _uniformLocations{};
+        // Indexed by the index of a UniformId, filled whenever an id is used the first time
+        std::vector<int32_t> _locationsById{};
     };
 
 }
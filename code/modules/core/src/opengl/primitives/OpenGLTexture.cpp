@@ -10,7 +10,8 @@
 
 namespace modulith{
 
-    OpenGLTexture2D::OpenGLTexture2D(const fs::path& filePath) : _path(filePath) {
+    OpenGLTexture2D::OpenGLTexture2D(shared<RenderStateCache> stateCache, const fs::path& filePath)
+        : _stateCache(std::move(stateCache)), _path(filePath) {
         int width, height, channels;
         stbi_set_flip_vertically_on_load(1);
         auto* data = stbi_load(filePath.generic_string().c_str(), &width, &height, &channels, 0);
@@ -44,22 +45,24 @@ namespace modulith{
     }
 
 
-    OpenGLTexture2D::OpenGLTexture2D(int width, int height) : _width(width), _height(height) {
-        glGenTextures(1, &_rendererId);
-        glBindTexture(GL_TEXTURE_2D, _rendererId);
-
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    OpenGLTexture2D::OpenGLTexture2D(shared<RenderStateCache> stateCache, int width, int height)
+        : _stateCache(std::move(stateCache)), _width(width), _height(height) {
+        // Created without binding it, so the texture units shadowed by the state cache stay valid
+        glCreateTextures(GL_TEXTURE_2D, 1, &_rendererId);
+        glTextureStorage2D(_rendererId, 1, GL_RGB8, width, height);
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTextureParameteri(_rendererId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(_rendererId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     }
 
     OpenGLTexture2D::~OpenGLTexture2D() {
         glDeleteTextures(1, &_rendererId);
+        _stateCache->ForgetTexture(_rendererId);
     }
 
     void OpenGLTexture2D::Bind(uint32_t slot) const {
-        glBindTextureUnit(slot, _rendererId);
+        if (_stateCache->BindTexture(slot, _rendererId))
+            glBindTextureUnit(slot, _rendererId);
     }
 
 
@@ -8,6 +8,7 @@
 
 #include "CoreModule.h"
 #include <renderer/primitives/Texture.h>
+#include <renderer/RenderStateCache.h>
 
 namespace modulith{
 
@@ -16,8 +17,8 @@ namespace modulith{
     class OpenGLTexture2D : public Texture2D {
         friend class OpenGLFrameBuffer;
     public:
-        explicit OpenGLTexture2D(const fs::path& filePath);
-        OpenGLTexture2D(int width, int height);
+        OpenGLTexture2D(shared<RenderStateCache> stateCache, const fs::path& filePath);
+        OpenGLTexture2D(shared<RenderStateCache> stateCache, int width, int height);
 
         ~OpenGLTexture2D() override;
 
@@ -28,6 +29,7 @@ namespace modulith{
         void Bind(uint32_t slot) const override;
 
     private:
+        shared<RenderStateCache> _stateCache;
         uint32_t _width;
         uint32_t _height;
         fs::path _path;
@@ -25,6 +25,12 @@ namespace modulith{
                 return GL_INT;
             case ShaderDataType::Bool:
                 return GL_BOOL;
+            case ShaderDataType::Half4:
+                return GL_HALF_FLOAT;
+            case ShaderDataType::Short2:
+                return GL_SHORT;
+            case ShaderDataType::UShort2:
+                return GL_UNSIGNED_SHORT;
             default:
             CoreAssert(false, "Unknown ShaderDataType {0}", type);
                 return 0;
@@ -33,24 +39,27 @@ namespace modulith{
 
     }
 
-    OpenGLVertexArray::OpenGLVertexArray() {
+    OpenGLVertexArray::OpenGLVertexArray(shared<RenderStateCache> stateCache) : _stateCache(std::move(stateCache)) {
         glCreateVertexArrays(1, &_rendererId);
     }
 
     OpenGLVertexArray::~OpenGLVertexArray() {
         glDeleteVertexArrays(1, &_rendererId);
+        _stateCache->ForgetVertexArray(_rendererId);
     }
 
     void OpenGLVertexArray::Bind() const {
-        glBindVertexArray(_rendererId);
+        if (_stateCache->BindVertexArray(_rendererId))
+            glBindVertexArray(_rendererId);
     }
 
     void OpenGLVertexArray::Unbind() const {
-        glBindVertexArray(0);
+        if (_stateCache->BindVertexArray(0))
+            glBindVertexArray(0);
     }
 
     void OpenGLVertexArray::AddVertexBuffer(const shared<VertexBuffer>& vertexBuffer) {
-        glBindVertexArray(_rendererId);
+        Bind();
         vertexBuffer->Bind();
 
         CoreAssert(
@@ -59,26 +68,37 @@ namespace modulith{
         );
 
 
-        uint32_t index = 0;
+        // Attributes of later buffers continue after those of the earlier ones
         const auto& layout = vertexBuffer->GetLayout();
         for (const auto& element : layout.GetElements()) {
-            glEnableVertexAttribArray(index);
-            glVertexAttribPointer(
-                index,
-                element.GetComponentCount(),
-                ShaderDataTypeToOpenGLBaseType(element.Type),
-                element.ShouldBeNormalized ? GL_TRUE : GL_FALSE,
-                layout.GetStride(),
-                (const void*) element.Offset
-            );
-            index++;
+            // Matrices occupy one attribute per column
+            auto columns = 1u;
+            if (element.Type == ShaderDataType::Mat3)
+                columns = 3;
+            else if (element.Type == ShaderDataType::Mat4)
+                columns = 4;
+            auto columnComponents = element.GetComponentCount() / columns;
+
+            for (uint32_t column = 0; column < columns; ++column) {
+                auto index = _nextAttributeIndex++;
+                glEnableVertexAttribArray(index);
+                glVertexAttribPointer(
+                    index,
+                    columnComponents,
+                    ShaderDataTypeToOpenGLBaseType(element.Type),
+                    element.ShouldBeNormalized ? GL_TRUE : GL_FALSE,
+                    layout.GetStride(),
+                    (const void*) (element.Offset + column * columnComponents * sizeof(float))
+                );
+                glVertexAttribDivisor(index, layout.IsPerInstance() ? 1 : 0);
+            }
         }
 
         _vertexBuffers.push_back(vertexBuffer);
     }
 
     void OpenGLVertexArray::SetIndexBuffer(const shared<IndexBuffer>& indexBuffer) {
-        glBindVertexArray(_rendererId);
+        Bind();
         indexBuffer->Bind();
 
         _indexBuffer = indexBuffer;
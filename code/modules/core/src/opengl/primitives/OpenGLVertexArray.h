@@ -9,12 +9,13 @@
 #include "CoreModule.h"
 #include <renderer/primitives/Buffers.h>
 #include <renderer/primitives/VertexArray.h>
+#include <renderer/RenderStateCache.h>
 
 namespace modulith{
 
     class OpenGLVertexArray : public VertexArray {
     public:
-        OpenGLVertexArray();
+        explicit OpenGLVertexArray(shared<RenderStateCache> stateCache);
 
         ~OpenGLVertexArray() override;
 
@@ -31,7 +32,9 @@ namespace modulith{
         [[nodiscard]] const shared<IndexBuffer>& GetIndexBuffer() const override;
 
     private:
+        shared<RenderStateCache> _stateCache;
         uint32_t _rendererId;
+        uint32_t _nextAttributeIndex = 0;
 
         std::vector<shared<VertexBuffer>> _vertexBuffers;
         shared<IndexBuffer> _indexBuffer;
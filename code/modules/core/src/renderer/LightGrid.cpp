@@ -0,0 +1,157 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "renderer/LightGrid.h"
+
+namespace modulith {
+
+    void LightGrid::Build(const Renderer::PointLight* lights, size_t count) {
+        _lights.assign(lights, lights + count);
+        _unboundedLights.clear();
+        _cellLights.clear();
+        _cells.clear();
+        _lightMarks.assign(count, 0);
+        _currentMark = 0;
+
+        // The median range fits most lights into few cells, while a single large light cannot make the cells huge
+        auto ranges = std::vector<float>();
+        ranges.reserve(count);
+        for (auto& light : _lights)
+            if (light.Range > 0.0f)
+                ranges.push_back(light.Range);
+        auto cellSize = 1.0f;
+        if (!ranges.empty()) {
+            std::nth_element(ranges.begin(), ranges.begin() + ranges.size() / 2, ranges.end());
+            cellSize = ranges[ranges.size() / 2];
+        }
+        _inverseCellSize = 1.0f / cellSize;
+
+        for (uint32_t i = 0; i < (uint32_t) count; ++i) {
+            auto& light = _lights[i];
+            if (light.Range <= 0.0f || light.Range > LargeLightCellCount * cellSize) {
+                _unboundedLights.push_back(i);
+                continue;
+            }
+
+            auto minCell = cellOf(light.Position - float3(light.Range));
+            auto maxCell = cellOf(light.Position + float3(light.Range));
+            for (auto x = minCell.x; x <= maxCell.x; ++x)
+                for (auto y = minCell.y; y <= maxCell.y; ++y)
+                    for (auto z = minCell.z; z <= maxCell.z; ++z)
+                        _cellLights.emplace_back(keyOf(int3(x, y, z)), i);
+        }
+
+        // Lights of the same cell are adjacent after sorting, so every cell only stores its range
+        std::sort(_cellLights.begin(), _cellLights.end());
+        for (uint32_t begin = 0; begin < _cellLights.size();) {
+            auto end = begin + 1;
+            while (end < _cellLights.size() && _cellLights[end].first == _cellLights[begin].first)
+                ++end;
+            _cells.emplace(_cellLights[begin].first, CellRange{begin, end, cellOfKey(_cellLights[begin].first)});
+            begin = end;
+        }
+    }
+
+    size_t LightGrid::Assign(const Bounds& bounds, uint32_t* indices, size_t maxCount) {
+        if (_lights.empty() || maxCount == 0)
+            return 0;
+
+        CoreAssert(
+            maxCount <= Renderer::MaxLightsPerObject, "At most {0} lights can be assigned to an object, but {1} were requested",
+            Renderer::MaxLightsPerObject, maxCount
+        );
+
+        auto count = size_t(0);
+        float distances[Renderer::MaxLightsPerObject];
+
+        for (auto light : _unboundedLights)
+            testLight(light, bounds, indices, distances, count, maxCount);
+
+        _currentMark += 1;
+        auto minCell = cellOf(bounds.Min());
+        auto maxCell = cellOf(bounds.Max());
+        const auto visitCell = [&](const CellRange& range) {
+            for (auto i = range.Begin; i < range.End; ++i) {
+                auto light = _cellLights[i].second;
+                if (_lightMarks[light] == _currentMark)
+                    continue;
+                _lightMarks[light] = _currentMark;
+                testLight(light, bounds, indices, distances, count, maxCount);
+            }
+        };
+
+        // Bounds covering more cells than are occupied are cheaper to answer by testing the occupied cells,
+        // which still only tests the lights of cells overlapping the bounds
+        auto coveredCellCount = ((double) maxCell.x - minCell.x + 1) * ((double) maxCell.y - minCell.y + 1)
+                                * ((double) maxCell.z - minCell.z + 1);
+        if (coveredCellCount > (double) _cells.size()) {
+            for (auto& cell : _cells) {
+                auto& coordinates = cell.second.Cell;
+                if (coordinates.x >= minCell.x && coordinates.y >= minCell.y && coordinates.z >= minCell.z
+                    && coordinates.x <= maxCell.x && coordinates.y <= maxCell.y && coordinates.z <= maxCell.z)
+                    visitCell(cell.second);
+            }
+            return count;
+        }
+
+        for (auto x = minCell.x; x <= maxCell.x; ++x) {
+            for (auto y = minCell.y; y <= maxCell.y; ++y) {
+                for (auto z = minCell.z; z <= maxCell.z; ++z) {
+                    auto cell = _cells.find(keyOf(int3(x, y, z)));
+                    if (cell != _cells.end())
+                        visitCell(cell->second);
+                }
+            }
+        }
+
+        return count;
+    }
+
+    void LightGrid::testLight(
+        uint32_t light, const Bounds& bounds, uint32_t* indices, float* distances, size_t& count, size_t maxCount
+    ) {
+        auto& pointLight = _lights[light];
+
+        if (pointLight.Range > 0.0f) {
+            // The distance from the light to the closest point of the box
+            auto offset = glm::max(glm::abs(pointLight.Position - bounds.Center) - bounds.Extents, float3(0.0f));
+            if (glm::dot(offset, offset) > pointLight.Range * pointLight.Range)
+                return;
+        }
+
+        auto toCenter = pointLight.Position - bounds.Center;
+        auto distance = glm::dot(toCenter, toCenter);
+        if (count == maxCount && distance >= distances[count - 1])
+            return;
+
+        // Insertion sort into the few closest lights found so far
+        auto position = count < maxCount ? count++ : count - 1;
+        while (position > 0 && distances[position - 1] > distance) {
+            distances[position] = distances[position - 1];
+            indices[position] = indices[position - 1];
+            --position;
+        }
+        distances[position] = distance;
+        indices[position] = light;
+    }
+
+    int3 LightGrid::cellOf(const float3& position) const {
+        return int3(
+            (int) std::floor(position.x * _inverseCellSize),
+            (int) std::floor(position.y * _inverseCellSize),
+            (int) std::floor(position.z * _inverseCellSize)
+        );
+    }
+
+    uint64_t LightGrid::keyOf(const int3& cell) {
+        const uint64_t mask = (1u << 21u) - 1u;
+        return ((uint64_t) cell.x & mask) | (((uint64_t) cell.y & mask) << 21u) | (((uint64_t) cell.z & mask) << 42u);
+    }
+    int3 LightGrid::cellOfKey(uint64_t key) {
+        // Sign extends the 21 bits of every coordinate
+        const auto coordinate = [key](uint32_t shift) { return (int) ((int64_t) (key << (43u - shift)) >> 43); };
+        return int3(coordinate(0), coordinate(21), coordinate(42));
+    }
+}
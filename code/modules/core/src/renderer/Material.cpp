@@ -8,7 +8,7 @@
 #define SetShaderUniform(type, uploadFunction)  Assert(std::holds_alternative<type>(uniformData.Data),\
         "The uniform data of {0} was not set up properly: "\
         "A {1} was expected, but none found!", uniformData.UniformName, #type);\
-        _shader->uploadFunction(uniformData.UniformName, std::get<type>(uniformData.Data));
+        _shader->uploadFunction(uniformData.Id, std::get<type>(uniformData.Data));
 
 namespace modulith{
 
@@ -57,6 +57,11 @@ namespace modulith{
                 SetShaderUniform(bool, UploadUniformBool);
                     Assert(false, "Material properties of type bool are not supported yet!");
                     break;
+                case ShaderDataType::Half4:
+                case ShaderDataType::Short2:
+                case ShaderDataType::UShort2:
+                Assert(false, "Packed vertex attribute types are not supported as material properties!");
+                    break;
             }
         }
     }
@@ -65,62 +70,62 @@ namespace modulith{
 
     template<>
     void Material::AddUniformValue<int1>(const std::string& propertyName, int1 data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Int, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Int, data});
     }
 
     template<>
     void Material::AddUniformValue<int2>(const std::string& propertyName, int2 data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Int2, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Int2, data});
     }
 
     template<>
     void Material::AddUniformValue<int3>(const std::string& propertyName, int3 data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Int3, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Int3, data});
     }
 
     template<>
     void Material::AddUniformValue<int4>(const std::string& propertyName, int4 data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Int4, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Int4, data});
     }
 
 // Float Specializations
 
     template<>
     void Material::AddUniformValue<float1>(const std::string& propertyName, float1 data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Float, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Float, data});
     }
 
     template<>
     void Material::AddUniformValue<float2>(const std::string& propertyName, float2 data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Float2, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Float2, data});
     }
 
     template<>
     void Material::AddUniformValue<float3>(const std::string& propertyName, float3 data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Float3, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Float3, data});
     }
 
     template<>
     void Material::AddUniformValue<float4>(const std::string& propertyName, float4 data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Float4, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Float4, data});
     }
 
 // Matrix Specializations
 
     template<>
     void Material::AddUniformValue<float3x3>(const std::string& propertyName, float3x3 data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Mat3, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Mat3, data});
     }
 
     template<>
     void Material::AddUniformValue<float4x4>(const std::string& propertyName, float4x4 data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Mat4, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Mat4, data});
     }
 
 // Bool Specialization
 
     template<>
     void Material::AddUniformValue<bool>(const std::string& propertyName, bool data) {
-        _data.push_back(ShaderUniform{propertyName, ShaderDataType::Bool, data});
+        _data.push_back(ShaderUniform{propertyName, UniformId(propertyName), ShaderDataType::Bool, data});
     }
 }
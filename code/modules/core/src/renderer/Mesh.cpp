@@ -5,6 +5,7 @@
 
 #include "renderer/Mesh.h"
 #include <renderer/ModelLoaderUtils.h>
+#include <renderer/MeshSimplifier.h>
 #include "Context.h"
 #include "renderer/RenderContext.h"
 
@@ -13,59 +14,252 @@ namespace modulith{
     shared<Mesh> Mesh::_standardCube = nullptr;
 
 
-    Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
-        _vertices = vertices;
-        _indices = indices;
+    Mesh::Mesh(
+        const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, MeshResidency residency, VertexFormat format
+    ) : Mesh(Context::GetInstance<RenderContext>()->RendererAPI(), vertices, indices, residency, format) {}
 
-        generateVertexArray();
+    Mesh::Mesh(
+        const shared<RendererAPI>& rendererAPI, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+        MeshResidency residency, VertexFormat format
+    ) : _residency(residency), _format(format) {
+        generateVertexArray(rendererAPI, vertices, indices);
+
+        if (residency == MeshResidency::CpuReadable) {
+            _vertices = vertices;
+            _indices = indices;
+        }
     }
 
-    Mesh::Mesh(const std::vector<float3>& positions, const std::vector<glm::vec3>& normals, std::vector<uint32_t> indices) {
+    Mesh::Mesh(
+        const std::vector<float3>& positions, const std::vector<glm::vec3>& normals, std::vector<uint32_t> indices,
+        MeshResidency residency
+    ) : _residency(residency) {
+        auto vertices = std::vector<Vertex>();
+        vertices.reserve(positions.size());
         for (int i = 0; i < positions.size(); ++i) {
             if (normals.size() > i) {
-                _vertices.push_back(Vertex{positions[i], normals[i]});
+                vertices.push_back(Vertex{positions[i], normals[i]});
             } else {
-                _vertices.push_back(Vertex{positions[i]});
+                vertices.push_back(Vertex{positions[i]});
             }
         }
-        _indices = std::move(indices);
-
-        generateVertexArray();
-    }
 
-    Mesh::Mesh(const shared<Mesh>& other) {
-        for (auto vertex : other->_vertices)
-            _vertices.push_back(vertex);
-        for (auto index : other->_indices)
-            _indices.push_back(index);
+        generateVertexArray(Context::GetInstance<RenderContext>()->RendererAPI(), vertices, indices);
 
-        generateVertexArray();
+        if (residency == MeshResidency::CpuReadable) {
+            _vertices = std::move(vertices);
+            _indices = std::move(indices);
+        }
     }
 
+    Mesh::Mesh(const shared<Mesh>& other)
+        : _residency(other->_residency), _format(other->_format), _texCoordTransform(other->_texCoordTransform),
+          _vertexCount(other->_vertexCount), _indexCount(other->_indexCount),
+          _vertices(other->_vertices), _indices(other->_indices), _localBounds(other->_localBounds), _lods(other->_lods),
+          _vertexArray(other->_vertexArray) {}
+
     Mesh::~Mesh() = default;
 
-    void Mesh::generateVertexArray() {
-        auto renderingAPI = Context::GetInstance<RenderContext>()->RendererAPI();
+    void Mesh::generateVertexArray(
+        const shared<RendererAPI>& renderingAPI, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices
+    ) {
+        // Only the bounds and counts are needed after the upload, unless the mesh is CPU readable
+        _vertexCount = vertices.size();
+        _indexCount = indices.size();
+        if (!vertices.empty())
+            _localBounds = Bounds::FromPoints(&vertices[0].Position, vertices.size(), sizeof(Vertex));
 
         _vertexArray = renderingAPI->CreateVertexArray();
 
-        auto vertexBuffer = renderingAPI->CreateVertexBuffer(&_vertices[0], _vertices.size() * sizeof(Vertex));
+        auto vertexBuffer = shared<VertexBuffer>();
+        if (_format == VertexFormat::Compact) {
+            vertexBuffer = createCompactVertexBuffer(renderingAPI, vertices);
+        } else {
+            vertexBuffer = renderingAPI->CreateVertexBuffer(
+                const_cast<Vertex*>(vertices.data()), vertices.size() * sizeof(Vertex)
+            );
+            vertexBuffer->SetLayout(
+                {
+                    {ShaderDataType::Float3, "a_Position"},
+                    {ShaderDataType::Float3, "a_Normal"},
+                    {ShaderDataType::Float2, "a_TexCoord"}
+                }
+            );
+        }
+
+        _vertexArray->AddVertexBuffer(vertexBuffer);
+
+        auto indexBuffer = renderingAPI->CreateIndexBuffer(const_cast<uint32_t*>(indices.data()), indices.size());
+        _vertexArray->SetIndexBuffer(indexBuffer);
+
+        _vertexArray->Unbind();
+    }
+
+    shared<VertexBuffer> Mesh::createCompactVertexBuffer(
+        const shared<RendererAPI>& renderingAPI, const std::vector<Vertex>& vertices
+    ) {
+        // The tex coords are quantized to their range, so tiling tex coords outside of [0, 1] keep working
+        auto texCoordMin = vertices.empty() ? float2(0.0f) : vertices[0].TexCoords;
+        auto texCoordMax = texCoordMin;
+        for (auto& vertex : vertices) {
+            texCoordMin = glm::min(texCoordMin, vertex.TexCoords);
+            texCoordMax = glm::max(texCoordMax, vertex.TexCoords);
+        }
+        auto texCoordRange = texCoordMax - texCoordMin;
+        _texCoordTransform = float4(texCoordRange.x, texCoordRange.y, texCoordMin.x, texCoordMin.y);
+
+        const auto quantize = [](float value, float min, float range) {
+            return (uint16_t) std::round(range > 0.0f ? (value - min) / range * 65535.0f : 0.0f);
+        };
+
+        auto compactVertices = std::vector<CompactVertex>(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            auto& vertex = vertices[i];
+            auto& compact = compactVertices[i];
+
+            // Flat axes of the bounds have no extents, their positions are all at the center
+            auto offset = vertex.Position - _localBounds.Center;
+            auto relative = float3(
+                _localBounds.Extents.x > 0.0f ? offset.x / _localBounds.Extents.x : 0.0f,
+                _localBounds.Extents.y > 0.0f ? offset.y / _localBounds.Extents.y : 0.0f,
+                _localBounds.Extents.z > 0.0f ? offset.z / _localBounds.Extents.z : 0.0f
+            );
+            auto packedXY = glm::packHalf2x16(float2(relative.x, relative.y));
+            auto packedZW = glm::packHalf2x16(float2(relative.z, 1.0f));
+            compact.Position[0] = (uint16_t) (packedXY & 0xFFFFu);
+            compact.Position[1] = (uint16_t) (packedXY >> 16u);
+            compact.Position[2] = (uint16_t) (packedZW & 0xFFFFu);
+            compact.Position[3] = (uint16_t) (packedZW >> 16u);
+
+            CompactVertex::EncodeNormal(vertex.Normal, compact.Normal);
+
+            compact.TexCoords[0] = quantize(vertex.TexCoords.x, texCoordMin.x, texCoordRange.x);
+            compact.TexCoords[1] = quantize(vertex.TexCoords.y, texCoordMin.y, texCoordRange.y);
+        }
+
+        auto vertexBuffer = renderingAPI->CreateVertexBuffer(
+            static_cast<void*>(compactVertices.data()), compactVertices.size() * sizeof(CompactVertex)
+        );
         vertexBuffer->SetLayout(
             {
-                {ShaderDataType::Float3, "a_Position"},
-                {ShaderDataType::Float3, "a_Normal"},
-                {ShaderDataType::Float2, "a_TexCoord"}
+                {ShaderDataType::Half4, "a_Position"},
+                {ShaderDataType::Short2, "a_Normal", true},
+                {ShaderDataType::UShort2, "a_TexCoord", true}
             }
         );
+        return vertexBuffer;
+    }
 
-        _vertexArray->AddVertexBuffer(vertexBuffer);
+    float4x4 Mesh::GetPositionDequantization() const {
+        if (_format != VertexFormat::Compact)
+            return float4x4(1.0f);
 
-        auto indexBuffer = renderingAPI->CreateIndexBuffer(&_indices[0], _indices.size());
-        _vertexArray->SetIndexBuffer(indexBuffer);
+        // Scales the quantized positions by the extents of the bounds and moves them to its center
+        auto dequantization = float4x4(1.0f);
+        dequantization[0][0] = _localBounds.Extents.x;
+        dequantization[1][1] = _localBounds.Extents.y;
+        dequantization[2][2] = _localBounds.Extents.z;
+        dequantization[3] = float4(_localBounds.Center, 1.0f);
+        return dequantization;
+    }
 
-        _vertexArray->Unbind();
+    void CompactVertex::EncodeNormal(const float3& normal, int16_t* encoded) {
+        auto length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        if (length <= 0.0f) {
+            encoded[0] = 0;
+            encoded[1] = 0;
+            return;
+        }
+
+        auto octahedron = float3(normal.x / length, normal.y / length, normal.z / length);
+        auto x = octahedron.x;
+        auto y = octahedron.y;
+        // The lower half is folded over the diagonals onto the corners of the square
+        if (octahedron.z < 0.0f) {
+            x = (1.0f - std::abs(octahedron.y)) * (octahedron.x >= 0.0f ? 1.0f : -1.0f);
+            y = (1.0f - std::abs(octahedron.x)) * (octahedron.y >= 0.0f ? 1.0f : -1.0f);
+        }
+
+        encoded[0] = (int16_t) std::round(glm::clamp(x, -1.0f, 1.0f) * 32767.0f);
+        encoded[1] = (int16_t) std::round(glm::clamp(y, -1.0f, 1.0f) * 32767.0f);
+    }
+
+    float3 CompactVertex::DecodeNormal(const int16_t* encoded) {
+        auto x = std::max(encoded[0] / 32767.0f, -1.0f);
+        auto y = std::max(encoded[1] / 32767.0f, -1.0f);
+
+        auto normal = float3(x, y, 1.0f - std::abs(x) - std::abs(y));
+        auto fold = std::max(-normal.z, 0.0f);
+        normal.x += normal.x >= 0.0f ? -fold : fold;
+        normal.y += normal.y >= 0.0f ? -fold : fold;
+        return glm::normalize(normal);
+    }
+
+    const std::vector<Vertex>& Mesh::GetVertices() const {
+        CoreAssert(IsCpuReadable(), "The vertices of a mesh can only be read if it was created as CPU readable")
+        return _vertices;
+    }
+
+    const std::vector<uint32_t>& Mesh::GetIndices() const {
+        CoreAssert(IsCpuReadable(), "The indices of a mesh can only be read if it was created as CPU readable")
+        return _indices;
+    }
+
+    void Mesh::ReleaseCpuData() {
+        _residency = MeshResidency::GpuOnly;
+
+        // Swapping with empty vectors frees the memory, unlike clear
+        std::vector<Vertex>().swap(_vertices);
+        std::vector<uint32_t>().swap(_indices);
+    }
+
+    void Mesh::AddLod(const shared<Mesh>& mesh, float screenSize) {
+        CoreAssert(mesh->_lods.empty(), "The lod of a mesh must not have lods itself")
+        _lods.push_back({mesh, screenSize});
+
+        // Selection walks the lods from the most detailed one until the screen size is too small
+        std::sort(_lods.begin(), _lods.end(), [](const Lod& lhs, const Lod& rhs) { return lhs.ScreenSize > rhs.ScreenSize; });
+    }
+
+    void Mesh::GenerateLods(int levelCount, float firstScreenSize) {
+        GenerateLods(Context::GetInstance<RenderContext>()->RendererAPI(), levelCount, firstScreenSize);
+    }
+
+    void Mesh::GenerateLods(const shared<RendererAPI>& rendererAPI, int levelCount, float firstScreenSize) {
+        CoreAssert(IsCpuReadable(), "Lods can only be generated for meshes that were created as CPU readable")
+        auto longestSide = 2.0f * std::max(_localBounds.Extents.x, std::max(_localBounds.Extents.y, _localBounds.Extents.z));
+
+        // The finest clustering has about 32 cells along the longest side of the mesh
+        auto cellSize = longestSide / 32.0f;
+        auto screenSize = firstScreenSize;
+        auto previousIndexCount = _indices.size();
+        auto vertices = std::vector<Vertex>();
+        auto indices = std::vector<uint32_t>();
+        while ((int) _lods.size() < levelCount && cellSize < longestSide) {
+            MeshSimplifier::ClusterVertices(_vertices, _indices, cellSize, vertices, indices);
+            if (indices.empty())
+                break;
+
+            // A lod is only worth a vertex array if it removes a quarter of the triangles of the previous level,
+            // otherwise the clustering is coarsened further
+            if (indices.size() * 4 <= previousIndexCount * 3) {
+                AddLod(std::make_shared<Mesh>(rendererAPI, vertices, indices, MeshResidency::GpuOnly, _format), screenSize);
+                previousIndexCount = indices.size();
+                screenSize *= 0.5f;
+            }
+            cellSize *= 2.0f;
+        }
     }
 
+    const Mesh& Mesh::SelectLod(float screenSize) const {
+        const Mesh* selected = this;
+        for (auto& lod : _lods) {
+            if (screenSize >= lod.ScreenSize)
+                break;
+            selected = lod.LodMesh.get();
+        }
+        return *selected;
+    }
 
     shared<Mesh> Mesh::CreateCube() {
         if (_standardCube == nullptr)
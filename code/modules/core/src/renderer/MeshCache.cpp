@@ -0,0 +1,267 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "renderer/MeshCache.h"
+#include <cstring>
+#include <iomanip>
+
+namespace modulith {
+
+    namespace {
+
+        constexpr char Magic[4] = {'M', 'M', 'S', 'H'};
+
+        /**
+         * Written at the start of every cooked file, followed by the dependency table, the material table,
+         * the submesh table and the vertex and index data of every submesh
+         */
+        struct FileHeader {
+            char Magic[4];
+            uint32_t Version;
+            uint32_t VertexSize;
+            uint32_t SubmeshCount;
+            uint32_t MaterialCount;
+            uint32_t DependencyCount;
+            uint64_t SourceStamp;
+        };
+
+        struct DependencyEntry {
+            uint64_t Stamp;
+            uint32_t PathLength;
+            uint32_t Padding;
+        };
+
+        struct MaterialEntry {
+            float4 DiffuseColor;
+            float4 SpecularColor;
+            uint32_t DiffuseTextureLength;
+            uint32_t SpecularTextureLength;
+        };
+
+        struct SubmeshEntry {
+            uint32_t VertexCount;
+            uint32_t IndexCount;
+            uint32_t MaterialIndex;
+        };
+
+        uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+            // FNV-1a, which is stable across runs and platforms unlike std::hash
+            auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        constexpr uint64_t HashSeed = 14695981039346656037ull;
+
+        /**
+         * Reads values from the bytes of a cooked file, failing instead of reading past its end
+         */
+        class BufferReader {
+        public:
+            explicit BufferReader(const std::vector<char>& buffer) : _buffer(buffer) {}
+
+            bool Read(void* destination, size_t size) {
+                if (size > _buffer.size() - _offset)
+                    return false;
+                std::memcpy(destination, _buffer.data() + _offset, size);
+                _offset += size;
+                return true;
+            }
+
+            bool ReadString(std::string& destination, size_t length) {
+                if (length > _buffer.size() - _offset)
+                    return false;
+                destination.assign(_buffer.data() + _offset, length);
+                _offset += length;
+                return true;
+            }
+
+            /**
+             * @return Returns whether the file has enough bytes left for the given amount of elements,
+             * which is checked before allocating memory for counts read from a damaged file
+             */
+            [[nodiscard]] bool HasRemaining(uint64_t count, size_t elementSize) const {
+                return count <= (_buffer.size() - _offset) / elementSize;
+            }
+
+            [[nodiscard]] bool IsAtEnd() const { return _offset == _buffer.size(); }
+
+        private:
+            const std::vector<char>& _buffer;
+            size_t _offset = 0;
+        };
+    }
+
+    uint64_t MeshCache::SourceStamp(const std::filesystem::path& sourcePath, uint64_t importKey) {
+        std::error_code error;
+        auto size = (uint64_t) std::filesystem::file_size(sourcePath, error);
+        if (error)
+            return 0;
+        auto writeTime = (int64_t) std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count();
+        if (error)
+            return 0;
+
+        auto hash = hashBytes(HashSeed, &size, sizeof(size));
+        hash = hashBytes(hash, &writeTime, sizeof(writeTime));
+        hash = hashBytes(hash, &importKey, sizeof(importKey));
+        // 0 is reserved for sources that do not exist
+        return hash != 0 ? hash : 1;
+    }
+
+    std::filesystem::path MeshCache::CachePathFor(const std::filesystem::path& sourcePath) {
+        // Models with the same name in different modules get different files
+        auto absolutePath = std::filesystem::absolute(sourcePath).generic_string();
+        auto pathHash = hashBytes(HashSeed, absolutePath.data(), absolutePath.size());
+
+        auto fileName = std::stringstream();
+        fileName << sourcePath.stem().string() << "-" << std::hex << std::setw(16) << std::setfill('0') << pathHash << ".mesh";
+        return std::filesystem::current_path() / "cache" / "meshes" / fileName.str();
+    }
+
+    std::optional<CookedModel> MeshCache::Read(const std::filesystem::path& cachePath, uint64_t sourceStamp) {
+        std::ifstream in(cachePath, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!in)
+            return std::nullopt;
+
+        // The whole file is read at once, the data of the submeshes is then only copied into their vectors
+        auto buffer = std::vector<char>((size_t) in.tellg());
+        in.seekg(0, std::ios::beg);
+        if (!in.read(buffer.data(), (std::streamsize) buffer.size()))
+            return std::nullopt;
+
+        auto reader = BufferReader(buffer);
+        auto header = FileHeader();
+        if (!reader.Read(&header, sizeof(header))
+            || std::memcmp(header.Magic, Magic, sizeof(Magic)) != 0
+            || header.Version != FormatVersion
+            || header.VertexSize != sizeof(Vertex)
+            || header.SourceStamp != sourceStamp)
+            return std::nullopt;
+
+        if (!reader.HasRemaining(header.DependencyCount, sizeof(DependencyEntry)))
+            return std::nullopt;
+
+        auto model = CookedModel();
+        model.Dependencies.resize(header.DependencyCount);
+        for (auto& dependency : model.Dependencies) {
+            auto entry = DependencyEntry();
+            auto path = std::string();
+            if (!reader.Read(&entry, sizeof(entry)) || !reader.ReadString(path, entry.PathLength))
+                return std::nullopt;
+
+            // A changed dependency makes the whole file stale, even though its own data is intact
+            dependency = path;
+            if (SourceStamp(dependency, 0) != entry.Stamp)
+                return std::nullopt;
+        }
+
+        if (!reader.HasRemaining(header.MaterialCount, sizeof(MaterialEntry))
+            || !reader.HasRemaining(header.SubmeshCount, sizeof(SubmeshEntry)))
+            return std::nullopt;
+
+        model.Materials.resize(header.MaterialCount);
+        for (auto& material : model.Materials) {
+            auto entry = MaterialEntry();
+            if (!reader.Read(&entry, sizeof(entry))
+                || !reader.ReadString(material.DiffuseTexture, entry.DiffuseTextureLength)
+                || !reader.ReadString(material.SpecularTexture, entry.SpecularTextureLength))
+                return std::nullopt;
+            material.DiffuseColor = entry.DiffuseColor;
+            material.SpecularColor = entry.SpecularColor;
+        }
+
+        auto submeshEntries = std::vector<SubmeshEntry>(header.SubmeshCount);
+        if (!reader.Read(submeshEntries.data(), submeshEntries.size() * sizeof(SubmeshEntry)))
+            return std::nullopt;
+
+        model.Submeshes.resize(header.SubmeshCount);
+        for (size_t i = 0; i < submeshEntries.size(); ++i) {
+            auto& entry = submeshEntries[i];
+            auto& submesh = model.Submeshes[i];
+            submesh.MaterialIndex = entry.MaterialIndex;
+            if (!reader.HasRemaining(entry.VertexCount, sizeof(Vertex)) || !reader.HasRemaining(entry.IndexCount, sizeof(uint32_t)))
+                return std::nullopt;
+
+            submesh.Vertices.resize(entry.VertexCount);
+            submesh.Indices.resize(entry.IndexCount);
+            if (!reader.Read(submesh.Vertices.data(), submesh.Vertices.size() * sizeof(Vertex))
+                || !reader.Read(submesh.Indices.data(), submesh.Indices.size() * sizeof(uint32_t)))
+                return std::nullopt;
+        }
+
+        // Trailing bytes mean that the file was not written by this version
+        if (!reader.IsAtEnd())
+            return std::nullopt;
+
+        return model;
+    }
+
+    bool MeshCache::Write(const std::filesystem::path& cachePath, uint64_t sourceStamp, const CookedModel& model) {
+        std::error_code error;
+        std::filesystem::create_directories(cachePath.parent_path(), error);
+        if (error)
+            return false;
+
+        // Written to a temporary file first, so a failed write never leaves a damaged file at the cache path
+        auto temporaryPath = cachePath;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream out(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!out)
+                return false;
+
+            auto header = FileHeader{
+                {Magic[0], Magic[1], Magic[2], Magic[3]}, FormatVersion, (uint32_t) sizeof(Vertex),
+                (uint32_t) model.Submeshes.size(), (uint32_t) model.Materials.size(), (uint32_t) model.Dependencies.size(),
+                sourceStamp
+            };
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            for (const auto& dependency : model.Dependencies) {
+                auto path = dependency.generic_string();
+                auto entry = DependencyEntry{SourceStamp(dependency, 0), (uint32_t) path.size(), 0};
+                out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+                out.write(path.data(), (std::streamsize) path.size());
+            }
+
+            for (const auto& material : model.Materials) {
+                auto entry = MaterialEntry{
+                    material.DiffuseColor, material.SpecularColor,
+                    (uint32_t) material.DiffuseTexture.size(), (uint32_t) material.SpecularTexture.size()
+                };
+                out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+                out.write(material.DiffuseTexture.data(), (std::streamsize) material.DiffuseTexture.size());
+                out.write(material.SpecularTexture.data(), (std::streamsize) material.SpecularTexture.size());
+            }
+
+            for (const auto& submesh : model.Submeshes) {
+                auto entry = SubmeshEntry{
+                    (uint32_t) submesh.Vertices.size(), (uint32_t) submesh.Indices.size(), submesh.MaterialIndex
+                };
+                out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+            }
+
+            for (const auto& submesh : model.Submeshes) {
+                out.write(
+                    reinterpret_cast<const char*>(submesh.Vertices.data()),
+                    (std::streamsize) (submesh.Vertices.size() * sizeof(Vertex))
+                );
+                out.write(
+                    reinterpret_cast<const char*>(submesh.Indices.data()),
+                    (std::streamsize) (submesh.Indices.size() * sizeof(uint32_t))
+                );
+            }
+
+            if (!out.flush())
+                return false;
+        }
+
+        std::filesystem::rename(temporaryPath, cachePath, error);
+        return !error;
+    }
+}
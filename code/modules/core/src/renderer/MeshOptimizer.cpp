@@ -0,0 +1,218 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "renderer/MeshOptimizer.h"
+
+namespace modulith {
+
+    namespace {
+
+        constexpr uint32_t NoTriangle = UINT32_MAX;
+
+        /**
+         * The score of a vertex in Forsyth's algorithm, where triangles with the highest sum of their vertex scores are added first
+         */
+        float vertexScore(int cachePosition, uint32_t remainingTriangles) {
+            if (remainingTriangles == 0)
+                return -1.0f;
+
+            auto score = 0.0f;
+            if (cachePosition >= 0) {
+                // The vertices of the last triangle get a fixed score, so the next triangle does not always share an edge with it
+                if (cachePosition < 3)
+                    score = 0.75f;
+                else
+                    score = std::pow(1.0f - (float) (cachePosition - 3) / (float) (MeshOptimizer::CacheSize - 3), 1.5f);
+            }
+
+            // Vertices with few remaining triangles are preferred, so they are finished instead of being left isolated
+            return score + 2.0f * std::pow((float) remainingTriangles, -0.5f);
+        }
+    }
+
+    float MeshOptimizer::CalculateAcmr(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize) {
+        auto triangleCount = indices.size() / 3;
+        if (triangleCount == 0)
+            return 0.0f;
+
+        // A vertex is in the FIFO cache if less than cacheSize misses happened since it was added
+        auto addedAt = std::vector<uint32_t>(vertexCount, 0);
+        auto time = cacheSize + 1;
+        auto misses = 0u;
+        for (auto index : indices) {
+            if (time - addedAt[index] > cacheSize) {
+                addedAt[index] = time++;
+                misses += 1;
+            }
+        }
+        return (float) misses / (float) triangleCount;
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+        auto triangleCount = (uint32_t) (indices.size() / 3);
+        if (triangleCount == 0)
+            return;
+
+        // The triangles of every vertex, where the first remainingTriangles entries are the ones not added yet
+        auto remainingTriangles = std::vector<uint32_t>(vertexCount, 0);
+        for (auto index : indices)
+            remainingTriangles[index] += 1;
+
+        auto adjacencyOffsets = std::vector<uint32_t>(vertexCount + 1, 0);
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+            adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + remainingTriangles[vertex];
+
+        auto adjacency = std::vector<uint32_t>(indices.size());
+        auto fillCounts = std::vector<uint32_t>(vertexCount, 0);
+        for (uint32_t i = 0; i < (uint32_t) indices.size(); ++i) {
+            auto vertex = indices[i];
+            adjacency[adjacencyOffsets[vertex] + fillCounts[vertex]++] = i / 3;
+        }
+
+        auto cachePositions = std::vector<int>(vertexCount, -1);
+        auto vertexScores = std::vector<float>(vertexCount);
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex)
+            vertexScores[vertex] = vertexScore(-1, remainingTriangles[vertex]);
+
+        const auto triangleScore = [&indices, &vertexScores](uint32_t triangle) {
+            return vertexScores[indices[3 * triangle]] + vertexScores[indices[3 * triangle + 1]]
+                   + vertexScores[indices[3 * triangle + 2]];
+        };
+
+        auto isAdded = std::vector<bool>(triangleCount, false);
+        auto bestTriangle = uint32_t(0);
+        auto bestScore = triangleScore(0);
+        for (uint32_t triangle = 1; triangle < triangleCount; ++triangle) {
+            auto score = triangleScore(triangle);
+            if (score > bestScore) {
+                bestScore = score;
+                bestTriangle = triangle;
+            }
+        }
+
+        auto result = std::vector<uint32_t>();
+        result.reserve(indices.size());
+        auto cache = std::vector<uint32_t>();
+        auto nextCache = std::vector<uint32_t>();
+        auto nextUnaddedTriangle = uint32_t(0);
+
+        for (uint32_t added = 0; added < triangleCount; ++added) {
+            // If no triangle in the cache is left, continue with the first triangle that was not added yet
+            if (bestTriangle == NoTriangle) {
+                while (isAdded[nextUnaddedTriangle])
+                    ++nextUnaddedTriangle;
+                bestTriangle = nextUnaddedTriangle;
+            }
+
+            auto triangle = bestTriangle;
+            isAdded[triangle] = true;
+
+            nextCache.clear();
+            for (uint32_t corner = 0; corner < 3; ++corner) {
+                auto vertex = indices[3 * triangle + corner];
+                result.push_back(vertex);
+
+                // Removes the triangle from the not yet added triangles of the vertex
+                auto* triangles = &adjacency[adjacencyOffsets[vertex]];
+                auto& remaining = remainingTriangles[vertex];
+                auto position = std::find(triangles, triangles + remaining, triangle);
+                std::swap(*position, triangles[remaining - 1]);
+                remaining -= 1;
+
+                if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end())
+                    nextCache.push_back(vertex);
+            }
+
+            // The vertices of the triangle move to the front of the cache, the others move back
+            auto triangleVertices = nextCache.size();
+            for (auto vertex : cache)
+                if (std::find(nextCache.begin(), nextCache.begin() + triangleVertices, vertex) == nextCache.begin() + triangleVertices)
+                    nextCache.push_back(vertex);
+
+            for (size_t position = 0; position < nextCache.size(); ++position) {
+                auto vertex = nextCache[position];
+                cachePositions[vertex] = position < CacheSize ? (int) position : -1;
+                vertexScores[vertex] = vertexScore(cachePositions[vertex], remainingTriangles[vertex]);
+            }
+
+            // Only the triangles of vertices whose score changed need a new score, the best of them is added next
+            bestTriangle = NoTriangle;
+            bestScore = -1.0f;
+            for (auto vertex : nextCache) {
+                auto* triangles = &adjacency[adjacencyOffsets[vertex]];
+                for (uint32_t i = 0; i < remainingTriangles[vertex]; ++i) {
+                    auto score = triangleScore(triangles[i]);
+                    if (score > bestScore) {
+                        bestScore = score;
+                        bestTriangle = triangles[i];
+                    }
+                }
+            }
+
+            if (nextCache.size() > CacheSize)
+                nextCache.resize(CacheSize);
+            std::swap(cache, nextCache);
+        }
+
+        indices = std::move(result);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(const std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, uint32_t clusterSize) {
+        CoreAssert(clusterSize > 0, "The cluster size of an overdraw optimization must be positive")
+        auto triangleCount = (uint32_t) (indices.size() / 3);
+        if (triangleCount <= clusterSize)
+            return;
+
+        auto center = Bounds::FromPoints(&vertices[0].Position, vertices.size(), sizeof(Vertex)).Center;
+
+        // Clusters on the outside that face outwards likely occlude the rest of the mesh, so they are drawn first
+        auto clusters = std::vector<std::pair<float, uint32_t>>();
+        for (uint32_t first = 0; first < triangleCount; first += clusterSize) {
+            auto last = std::min(first + clusterSize, triangleCount);
+
+            auto centroid = float3(0.0f);
+            auto normal = float3(0.0f);
+            for (auto triangle = first; triangle < last; ++triangle) {
+                auto& a = vertices[indices[3 * triangle]].Position;
+                auto& b = vertices[indices[3 * triangle + 1]].Position;
+                auto& c = vertices[indices[3 * triangle + 2]].Position;
+                centroid += (a + b + c) / 3.0f;
+                // Not normalized, so larger triangles have more influence
+                normal += glm::cross(b - a, c - a);
+            }
+            centroid /= (float) (last - first);
+
+            auto normalLength = glm::length(normal);
+            auto facing = normalLength > 0.0f ? glm::dot(centroid - center, normal / normalLength) : 0.0f;
+            clusters.emplace_back(-facing, first);
+        }
+        std::stable_sort(
+            clusters.begin(), clusters.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }
+        );
+
+        auto result = std::vector<uint32_t>();
+        result.reserve(indices.size());
+        for (auto& cluster : clusters) {
+            auto last = std::min(cluster.second + clusterSize, triangleCount);
+            result.insert(result.end(), indices.begin() + 3 * cluster.second, indices.begin() + 3 * last);
+        }
+        indices = std::move(result);
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+        auto remap = std::vector<uint32_t>(vertices.size(), UINT32_MAX);
+        auto orderedVertices = std::vector<Vertex>();
+        orderedVertices.reserve(vertices.size());
+
+        for (auto& index : indices) {
+            if (remap[index] == UINT32_MAX) {
+                remap[index] = (uint32_t) orderedVertices.size();
+                orderedVertices.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+        vertices = std::move(orderedVertices);
+    }
+}
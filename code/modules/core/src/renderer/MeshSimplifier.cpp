@@ -0,0 +1,170 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "renderer/MeshSimplifier.h"
+#include <numeric>
+
+namespace modulith {
+
+    namespace {
+
+        /**
+         * A vertex cluster is identified by its cell and the UV chart of its vertices
+         */
+        struct ClusterKey {
+            uint64_t Cell;
+            uint32_t Chart;
+
+            bool operator==(const ClusterKey& other) const { return Cell == other.Cell && Chart == other.Chart; }
+        };
+
+        struct ClusterKeyHash {
+            size_t operator()(const ClusterKey& key) const {
+                return std::hash<uint64_t>{}(key.Cell ^ ((uint64_t) key.Chart * 0x9E3779B97F4A7C15ull));
+            }
+        };
+
+        uint32_t findRoot(std::vector<uint32_t>& parents, uint32_t vertex) {
+            while (parents[vertex] != vertex) {
+                parents[vertex] = parents[parents[vertex]];
+                vertex = parents[vertex];
+            }
+            return vertex;
+        }
+
+        void unite(std::vector<uint32_t>& parents, uint32_t a, uint32_t b) {
+            a = findRoot(parents, a);
+            b = findRoot(parents, b);
+            if (a != b)
+                parents[std::max(a, b)] = std::min(a, b);
+        }
+
+        /**
+         * Assigns every vertex to a UV chart, a region of the mesh whose texture coordinates are continuous.
+         * Vertices of a chart are connected by triangles, or only differ in their normal, e.g. at hard edges.
+         * Vertices that share their position, but not their texture coordinates, lie on a UV seam and belong to different charts.
+         * @return Returns the chart of every vertex
+         */
+        std::vector<uint32_t> findUVCharts(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+            auto charts = std::vector<uint32_t>(vertices.size());
+            std::iota(charts.begin(), charts.end(), 0u);
+
+            for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                unite(charts, indices[i], indices[i + 1]);
+                unite(charts, indices[i + 1], indices[i + 2]);
+            }
+
+            // Sorting brings vertices with the same position and texture coordinates next to each other
+            auto attributesOf = [&vertices](uint32_t vertex) {
+                auto& position = vertices[vertex].Position;
+                auto& texCoords = vertices[vertex].TexCoords;
+                return std::make_tuple(position.x, position.y, position.z, texCoords.x, texCoords.y);
+            };
+            auto sorted = std::vector<uint32_t>(vertices.size());
+            std::iota(sorted.begin(), sorted.end(), 0u);
+            std::sort(
+                sorted.begin(), sorted.end(),
+                [&attributesOf](uint32_t a, uint32_t b) { return attributesOf(a) < attributesOf(b); }
+            );
+            for (size_t i = 1; i < sorted.size(); ++i) {
+                if (attributesOf(sorted[i - 1]) == attributesOf(sorted[i]))
+                    unite(charts, sorted[i - 1], sorted[i]);
+            }
+
+            for (uint32_t vertex = 0; vertex < (uint32_t) charts.size(); ++vertex)
+                charts[vertex] = findRoot(charts, vertex);
+            return charts;
+        }
+    }
+
+    void MeshSimplifier::ClusterVertices(
+        const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, float cellSize,
+        std::vector<Vertex>& outVertices, std::vector<uint32_t>& outIndices
+    ) {
+        CoreAssert(cellSize > 0, "The cell size of a mesh simplification must be positive, but is {0}", cellSize)
+        outVertices.clear();
+        outIndices.clear();
+        if (vertices.empty())
+            return;
+
+        auto bounds = Bounds::FromPoints(&vertices[0].Position, vertices.size(), sizeof(Vertex));
+        auto inverseCellSize = 1.0f / cellSize;
+        auto charts = findUVCharts(vertices, indices);
+
+        // The vertices of a cluster are summed up first and divided by their count afterwards
+        // Positions are averaged per cell, so the clusters of different charts in a cell do not open a crack along the seam
+        auto clusterCounts = std::vector<uint32_t>();
+        auto clusterCells = std::vector<uint32_t>();
+        auto cellPositions = std::vector<float3>();
+        auto cellCounts = std::vector<uint32_t>();
+        auto cells = std::unordered_map<uint64_t, uint32_t>();
+        auto clusters = std::unordered_map<ClusterKey, uint32_t, ClusterKeyHash>();
+        auto vertexClusters = std::vector<uint32_t>(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            auto& vertex = vertices[i];
+            auto cell = glm::floor((vertex.Position - bounds.Min()) * inverseCellSize);
+            // Each axis is masked to its 21 bits, so huge meshes wrap around instead of overwriting the other axes
+            auto key = ((uint64_t) cell.x & 0x1FFFFFu)
+                | (((uint64_t) cell.y & 0x1FFFFFu) << 21u)
+                | (((uint64_t) cell.z & 0x1FFFFFu) << 42u);
+
+            auto cellIndex = cells.emplace(key, (uint32_t) cellPositions.size());
+            if (cellIndex.second) {
+                cellPositions.emplace_back(0.0f);
+                cellCounts.push_back(0);
+            }
+            cellPositions[cellIndex.first->second] += vertex.Position;
+            cellCounts[cellIndex.first->second] += 1;
+
+            auto cluster = clusters.emplace(ClusterKey{key, charts[i]}, (uint32_t) outVertices.size());
+            if (cluster.second) {
+                outVertices.push_back({float3(0.0f), float3(0.0f), float2(0.0f)});
+                clusterCounts.push_back(0);
+                clusterCells.push_back(cellIndex.first->second);
+            }
+
+            auto index = cluster.first->second;
+            outVertices[index].Normal += vertex.Normal;
+            outVertices[index].TexCoords += vertex.TexCoords;
+            clusterCounts[index] += 1;
+            vertexClusters[i] = index;
+        }
+
+        for (size_t i = 0; i < outVertices.size(); ++i) {
+            auto& vertex = outVertices[i];
+            auto cell = clusterCells[i];
+            vertex.Position = cellPositions[cell] / (float) cellCounts[cell];
+            vertex.TexCoords /= (float) clusterCounts[i];
+            // Opposing normals of thin details cancel out, those vertices keep any valid normal
+            vertex.Normal = glm::dot(vertex.Normal, vertex.Normal) > 0.0f ? glm::normalize(vertex.Normal) : float3(0.0f, 1.0f, 0.0f);
+        }
+
+        // Triangles with two corners in the same cell have collapsed to a line or a point, even if the corners are in different charts
+        outIndices.reserve(indices.size());
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            auto a = vertexClusters[indices[i]];
+            auto b = vertexClusters[indices[i + 1]];
+            auto c = vertexClusters[indices[i + 2]];
+            if (clusterCells[a] == clusterCells[b] || clusterCells[b] == clusterCells[c] || clusterCells[a] == clusterCells[c])
+                continue;
+
+            outIndices.push_back(a);
+            outIndices.push_back(b);
+            outIndices.push_back(c);
+        }
+
+        // Clusters whose triangles all collapsed are not referenced anymore and are removed
+        auto remap = std::vector<uint32_t>(outVertices.size(), UINT32_MAX);
+        auto usedVertices = std::vector<Vertex>();
+        for (auto& index : outIndices) {
+            if (remap[index] == UINT32_MAX) {
+                remap[index] = (uint32_t) usedVertices.size();
+                usedVertices.push_back(outVertices[index]);
+            }
+            index = remap[index];
+        }
+        outVertices = std::move(usedVertices);
+    }
+}
@@ -8,14 +8,36 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/mesh.h>
+#include <assimp/DefaultIOSystem.h>
 #include <renderer/StandardMaterial.h>
+#include <renderer/MeshOptimizer.h>
+#include <renderer/MeshCache.h>
 #include "Context.h"
 #include "renderer/RenderContext.h"
 
 namespace modulith{
 
-    shared<Mesh> createMeshFromAssimp(const shared<RenderContext>& renderCtx, const aiMesh* assimpMesh, aiMatrix4x4 sceneToMesh) {
-        auto vertices = std::vector<Vertex>();
+    /**
+     * Opens files like assimp's default IO system, but remembers every file that was opened,
+     * so the files a model references, e.g. its material libraries, are known to the MeshCache
+     */
+    class RecordingIOSystem : public Assimp::DefaultIOSystem {
+    public:
+        Assimp::IOStream* Open(const char* file, const char* mode) override {
+            auto* stream = DefaultIOSystem::Open(file, mode);
+            if (stream != nullptr)
+                OpenedFiles.emplace_back(std::filesystem::absolute(file).lexically_normal());
+            return stream;
+        }
+
+        std::vector<std::filesystem::path> OpenedFiles{};
+    };
+
+    CookedSubmesh cookSubmeshFromAssimp(const aiMesh* assimpMesh, aiMatrix4x4 sceneToMesh, const MeshImportSettings& settings) {
+        auto submesh = CookedSubmesh();
+        submesh.MaterialIndex = assimpMesh->mMaterialIndex;
+
+        auto& vertices = submesh.Vertices;
         vertices.reserve(assimpMesh->mNumVertices);
         for (unsigned int i = 0; i < assimpMesh->mNumVertices; ++i) {
             aiVector3D position = sceneToMesh * assimpMesh->mVertices[i];
@@ -38,8 +60,8 @@ namespace modulith{
             vertices.push_back(vertex);
         }
 
-        auto indices = std::vector<uint32_t>();
-        vertices.reserve(assimpMesh->mNumFaces);
+        auto& indices = submesh.Indices;
+        indices.reserve(3 * assimpMesh->mNumFaces);
 
         for (unsigned int i = 0; i < assimpMesh->mNumFaces; ++i) {
             aiFace face = assimpMesh->mFaces[i];
@@ -51,48 +73,71 @@ namespace modulith{
             indices.push_back(face.mIndices[2]);
         }
 
-        return std::make_shared<Mesh>(vertices, indices);
+        // Assimp keeps the order of the faces in the file, which is rarely good for the post transform cache
+        if (settings.OptimizeVertexCache) {
+            auto originalAcmr = MeshOptimizer::CalculateAcmr(indices, vertices.size());
+            MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+            if (settings.OptimizeOverdraw)
+                MeshOptimizer::OptimizeOverdraw(vertices, indices);
+            MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+
+            CoreLogInfo(
+                "Optimized mesh '{}' with {} triangles, ACMR {:.3f} -> {:.3f}", assimpMesh->mName.C_Str(), indices.size() / 3,
+                originalAcmr, MeshOptimizer::CalculateAcmr(indices, vertices.size())
+            )
+        }
+
+        return submesh;
     }
 
-    void traverseAssimpSceneAndAddMeshesRec(
-        const shared<RenderContext>& renderCtx,
-        const aiScene* scene, aiNode* current, aiMatrix4x4 sceneToParent, std::vector<std::pair<shared<Mesh>, unsigned int>>& result
+    shared<Mesh> createMesh(const shared<RendererAPI>& api, const CookedSubmesh& submesh, const MeshImportSettings& settings) {
+        if (settings.LodLevels <= 0)
+            return std::make_shared<Mesh>(api, submesh.Vertices, submesh.Indices, MeshResidency::GpuOnly, settings.Format);
+
+        // The lods are generated once while loading, so simplifying never costs time during rendering.
+        // Only the simplification needs the vertices in main memory, so they are released afterwards.
+        auto mesh = std::make_shared<Mesh>(api, submesh.Vertices, submesh.Indices, MeshResidency::CpuReadable, settings.Format);
+        mesh->GenerateLods(api, settings.LodLevels);
+        mesh->ReleaseCpuData();
+        return mesh;
+    }
+
+    void traverseAssimpSceneAndCookMeshesRec(
+        const aiScene* scene, aiNode* current, aiMatrix4x4 sceneToParent, const MeshImportSettings& settings,
+        std::vector<CookedSubmesh>& result
     ) {
         auto sceneToNode = sceneToParent * current->mTransformation;
 
         for (unsigned int i = 0; i < current->mNumMeshes; ++i) {
-            auto* mesh = scene->mMeshes[current->mMeshes[i]];
-            result.emplace_back(createMeshFromAssimp(renderCtx, mesh, sceneToNode), mesh->mMaterialIndex);
+            result.push_back(cookSubmeshFromAssimp(scene->mMeshes[current->mMeshes[i]], sceneToNode, settings));
         }
 
         for (unsigned int i = 0; i < current->mNumChildren; ++i) {
-            traverseAssimpSceneAndAddMeshesRec(renderCtx, scene, current->mChildren[i], sceneToNode, result);
+            traverseAssimpSceneAndCookMeshesRec(scene, current->mChildren[i], sceneToNode, settings, result);
         }
     }
 
-    std::vector<shared<Material>> collectAssimpMaterials(const shared<RenderContext>& renderCtx, const aiScene* scene, const Address& address){
-        std::vector<shared<Material>> res{};
-        auto shader = renderCtx->RendererAPI()->CreateShader(Address(std::filesystem::path("shaders") / "PhongShader.glsl"));
+    std::vector<CookedMaterial> cookAssimpMaterials(const aiScene* scene){
+        std::vector<CookedMaterial> res{};
         for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
-
-            auto mat = std::make_shared<StandardMaterial>(shader);
+            CookedMaterial mat{};
 
             aiColor3D diffuseColor (0.f,0.f,0.f);
             scene->mMaterials[i]->Get(AI_MATKEY_COLOR_DIFFUSE,diffuseColor);
-            mat->DiffuseColor = float4(diffuseColor.r, diffuseColor.g, diffuseColor.b, 1.0f);
+            mat.DiffuseColor = float4(diffuseColor.r, diffuseColor.g, diffuseColor.b, 1.0f);
 
             aiString diffuseTex;
             if(scene->mMaterials[i]->Get(AI_MATKEY_TEXTURE_DIFFUSE(0), diffuseTex) == aiReturn_SUCCESS){
-                mat->DiffuseTexture = renderCtx->RendererAPI()->CreateTexture2D(address.ParentAddress() / diffuseTex.C_Str());
+                mat.DiffuseTexture = diffuseTex.C_Str();
             }
 
             aiColor3D specularColor (0.f,0.f,0.f);
             scene->mMaterials[i]->Get(AI_MATKEY_COLOR_SPECULAR,specularColor);
-            mat->SpecularColor = float4(specularColor.r, specularColor.g, specularColor.b, 1.0f);
+            mat.SpecularColor = float4(specularColor.r, specularColor.g, specularColor.b, 1.0f);
 
             aiString specularTex;
-            if(scene->mMaterials[i]->Get(AI_MATKEY_TEXTURE_SPECULAR(0), diffuseTex) == aiReturn_SUCCESS){
-                mat->SpecularTexture = renderCtx->RendererAPI()->CreateTexture2D(address.ParentAddress() / specularTex.C_Str());
+            if(scene->mMaterials[i]->Get(AI_MATKEY_TEXTURE_SPECULAR(0), specularTex) == aiReturn_SUCCESS){
+                mat.SpecularTexture = specularTex.C_Str();
             }
 
             res.push_back(mat);
@@ -100,12 +145,32 @@ namespace modulith{
         return res;
     }
 
-    std::vector<Model> loadFromAssimpScene(const Address& address, bool importMaterials){
-        auto& ctx = Context::Instance();
-        auto assetCtx = ctx.Get<AssetContext>();
-        auto path = assetCtx->ResolveAddressOrThrow(address, "ModelLoaderUtils");
+    std::vector<shared<Material>> createMaterials(
+        const shared<RendererAPI>& api, const std::vector<CookedMaterial>& cookedMaterials, const Address& address
+    ){
+        std::vector<shared<Material>> res{};
+        auto shader = api->CreateShader(Address(std::filesystem::path("shaders") / "PhongShader.glsl"));
+        for (const auto& cooked : cookedMaterials) {
+            auto mat = std::make_shared<StandardMaterial>(shader);
+            mat->DiffuseColor = cooked.DiffuseColor;
+            mat->SpecularColor = cooked.SpecularColor;
+
+            if(!cooked.DiffuseTexture.empty())
+                mat->DiffuseTexture = api->CreateTexture2D(address.ParentAddress() / cooked.DiffuseTexture);
+
+            if(!cooked.SpecularTexture.empty())
+                mat->SpecularTexture = api->CreateTexture2D(address.ParentAddress() / cooked.SpecularTexture);
 
+            res.push_back(mat);
+        }
+        return res;
+    }
+
+    CookedModel cookFromAssimpScene(const std::filesystem::path& path, const MeshImportSettings& settings){
         Assimp::Importer importer;
+        // The importer owns and deletes its IO handler
+        auto* ioSystem = new RecordingIOSystem();
+        importer.SetIOHandler(ioSystem);
 
         const aiScene* scene = importer.ReadFile(
             path.generic_string(),
@@ -117,34 +182,68 @@ namespace modulith{
 
         CoreAssert(scene != nullptr, "Importing of mesh at {} failed. Error: {}", path.generic_string(), importer.GetErrorString());
 
-        auto renderCtx = ctx.Get<RenderContext>();
+        CookedModel model{};
+        traverseAssimpSceneAndCookMeshesRec(scene, scene->mRootNode, aiMatrix4x4(), settings, model.Submeshes);
+        if (scene->HasMaterials())
+            model.Materials = cookAssimpMaterials(scene);
 
-        std::vector<std::pair<shared<Mesh>, unsigned int>> meshes;
-        traverseAssimpSceneAndAddMeshesRec(renderCtx, scene, scene->mRootNode, aiMatrix4x4(), meshes);
+        auto sourcePath = std::filesystem::absolute(path).lexically_normal();
+        for (auto& file : ioSystem->OpenedFiles)
+            if (file != sourcePath && std::find(model.Dependencies.begin(), model.Dependencies.end(), file) == model.Dependencies.end())
+                model.Dependencies.push_back(file);
+        return model;
+    }
+
+    CookedModel cookOrLoadFromCache(const std::filesystem::path& path, const MeshImportSettings& settings){
+        if (!settings.UseCache)
+            return cookFromAssimpScene(path, settings);
+
+        // Lods and the vertex format are applied after loading, so only the optimizations change the cooked data
+        auto importKey = (uint64_t) settings.OptimizeVertexCache | (uint64_t) settings.OptimizeOverdraw << 1u;
+        auto stamp = MeshCache::SourceStamp(path, importKey);
+        auto cachePath = MeshCache::CachePathFor(path);
+
+        if (auto cached = MeshCache::Read(cachePath, stamp))
+            return std::move(*cached);
+
+        auto model = cookFromAssimpScene(path, settings);
+        if (MeshCache::Write(cachePath, stamp, model))
+            CoreLogInfo("Cooked model {} into {}", path.generic_string(), cachePath.generic_string())
+        else
+            CoreLogWarn("Could not write the cooked model {} into {}", path.generic_string(), cachePath.generic_string())
+        return model;
+    }
+
+    std::vector<Model> loadFromAssimpScene(const Address& address, bool importMaterials, const MeshImportSettings& settings){
+        auto& ctx = Context::Instance();
+        auto assetCtx = ctx.Get<AssetContext>();
+        auto path = assetCtx->ResolveAddressOrThrow(address, "ModelLoaderUtils");
+
+        auto cooked = cookOrLoadFromCache(path, settings);
+
+        // Meshes, shaders and textures are all created with the API of the renderer
+        auto api = ctx.Get<RenderContext>()->RendererAPI();
+
+        std::vector<shared<Material>> materials{};
+        if (importMaterials && !cooked.Materials.empty())
+            materials = createMaterials(api, cooked.Materials, address);
 
         std::vector<Model> res{};
-        if (scene->HasMaterials() && importMaterials) {
-            auto materials = collectAssimpMaterials(renderCtx, scene, address);
-
-            for (const auto& mesh : meshes) {
-                auto materialIdx = mesh.second;
-                if (materialIdx >= 0 && materialIdx < materials.size()) {
-                    res.emplace_back(mesh.first, materials[materialIdx]);
-                } else {
-                    res.emplace_back(mesh.first, nullptr);
-                }
+        for (const auto& submesh : cooked.Submeshes) {
+            auto mesh = createMesh(api, submesh, settings);
+            auto materialIdx = submesh.MaterialIndex;
+            if (materialIdx < materials.size()) {
+                res.emplace_back(mesh, materials[materialIdx]);
+            } else {
+                res.emplace_back(mesh, nullptr);
             }
-
-        } else {
-            for (const auto& mesh : meshes)
-                res.emplace_back(mesh.first, nullptr);
         }
 
         return res;
     }
 
-    shared<Mesh> ModelLoaderUtils::LoadSingleFromFile(const Address& address) {
-        auto loadedMeshes = LoadMeshesFromFile(address);
+    shared<Mesh> ModelLoaderUtils::LoadSingleFromFile(const Address& address, const MeshImportSettings& settings) {
+        auto loadedMeshes = LoadMeshesFromFile(address, settings);
         CoreAssert(!loadedMeshes.empty(), "There were no meshes to load at address {}", address.AsString())
 
         if(loadedMeshes.size() > 1)
@@ -153,16 +252,16 @@ namespace modulith{
         return loadedMeshes[0];
     }
 
-    std::vector<shared<Mesh>> ModelLoaderUtils::LoadMeshesFromFile(const Address& address) {
+    std::vector<shared<Mesh>> ModelLoaderUtils::LoadMeshesFromFile(const Address& address, const MeshImportSettings& settings) {
         std::vector<shared<Mesh>> res{};
-        for(const auto& model : loadFromAssimpScene(address, false)){
+        for(const auto& model : loadFromAssimpScene(address, false, settings)){
             res.push_back(model.Mesh);
         }
         return res;
     }
 
-    std::vector<Model> ModelLoaderUtils::LoadSceneFromFile(const Address& address) {
-        return loadFromAssimpScene(address, true);
+    std::vector<Model> ModelLoaderUtils::LoadSceneFromFile(const Address& address, const MeshImportSettings& settings) {
+        return loadFromAssimpScene(address, true, settings);
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,382 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "renderer/NullRendererAPI.h"
+#include <unordered_set>
+
+namespace modulith {
+
+    /**
+     * The state shared by a NullRendererAPI and all primitives it created
+     */
+    struct NullRendererState {
+        NullRendererStats Stats{};
+        RenderStateCache StateCache{};
+
+        // Ids of every kind of primitive, zero is the unbound state like in other APIs
+        uint32_t NextId = 1;
+    };
+
+    namespace {
+
+        bool isIdentifierCharacter(char character) {
+            return std::isalnum((unsigned char) character) || character == '_';
+        }
+
+        std::string readIdentifier(const std::string& source, size_t& position) {
+            while (position < source.size() && std::isspace((unsigned char) source[position]))
+                position += 1;
+            auto start = position;
+            while (position < source.size() && isIdentifierCharacter(source[position]))
+                position += 1;
+            return source.substr(start, position - start);
+        }
+
+        /**
+         * Adds the names of the uniform variables declared in the source to the given set,
+         * including every element of arrays like the OpenGL shader reflection does.
+         * Uniform blocks are not variables and are skipped.
+         */
+        void addDeclaredUniforms(const std::string& source, std::unordered_set<std::string>& names) {
+            const std::string keyword = "uniform";
+            size_t position = 0;
+            while ((position = source.find(keyword, position)) != std::string::npos) {
+                auto start = position;
+                position += keyword.size();
+                // Only the keyword itself, not names that contain it
+                if ((start > 0 && isIdentifierCharacter(source[start - 1]))
+                    || (position < source.size() && isIdentifierCharacter(source[position])))
+                    continue;
+
+                auto type = readIdentifier(source, position);
+                auto name = readIdentifier(source, position);
+                if (type.empty() || name.empty())
+                    continue;
+                names.insert(name);
+
+                while (position < source.size() && std::isspace((unsigned char) source[position]))
+                    position += 1;
+                if (position < source.size() && source[position] == '[') {
+                    auto size = std::atoi(source.c_str() + position + 1);
+                    for (int element = 0; element < size; ++element)
+                        names.insert(name + "[" + std::to_string(element) + "]");
+                }
+            }
+        }
+
+        class NullVertexBuffer : public VertexBuffer {
+        public:
+            NullVertexBuffer(shared<NullRendererState> state, uint32_t size) : _state(std::move(state)) {
+                _state->Stats.CreatedVertexBuffers += 1;
+                _state->Stats.VertexBufferBytes += size;
+            }
+
+            void Bind() const override {}
+
+            void Unbind() const override {}
+
+            [[nodiscard]] const BufferLayout& GetLayout() const override { return _layout; }
+
+            void SetLayout(const BufferLayout& layout) override { _layout = layout; }
+
+            void SetData(const void* data, uint32_t size) override { _state->Stats.VertexBufferBytes += size; }
+
+        private:
+            shared<NullRendererState> _state;
+            BufferLayout _layout{};
+        };
+
+        class NullIndexBuffer : public IndexBuffer {
+        public:
+            NullIndexBuffer(shared<NullRendererState> state, uint32_t count) : _state(std::move(state)), _count(count) {
+                _state->Stats.CreatedIndexBuffers += 1;
+                _state->Stats.IndexBufferBytes += count * sizeof(uint32_t);
+            }
+
+            void Bind() const override {}
+
+            void Unbind() const override {}
+
+            [[nodiscard]] uint32_t GetCount() const override { return _count; }
+
+        private:
+            shared<NullRendererState> _state;
+            uint32_t _count;
+        };
+
+        class NullUniformBuffer : public UniformBuffer {
+        public:
+            explicit NullUniformBuffer(shared<NullRendererState> state) : _state(std::move(state)) {
+                _state->Stats.CreatedUniformBuffers += 1;
+            }
+
+            void Bind() const override {}
+
+            void SetData(const void* data, uint32_t size) override { _state->Stats.UniformBufferBytes += size; }
+
+        private:
+            shared<NullRendererState> _state;
+        };
+
+        class NullVertexArray : public VertexArray {
+        public:
+            explicit NullVertexArray(shared<NullRendererState> state) : _state(std::move(state)), _id(_state->NextId++) {
+                _state->Stats.CreatedVertexArrays += 1;
+            }
+
+            ~NullVertexArray() override { _state->StateCache.ForgetVertexArray(_id); }
+
+            void Bind() const override { _state->StateCache.BindVertexArray(_id); }
+
+            void Unbind() const override { _state->StateCache.BindVertexArray(0); }
+
+            void AddVertexBuffer(const shared<VertexBuffer>& vertexBuffer) override {
+                CoreAssert(
+                    !vertexBuffer->GetLayout().GetElements().empty(),
+                    "The vertex buffer does not have a layout! AddVertexBuffer should be called after setting the layout"
+                );
+                _vertexBuffers.push_back(vertexBuffer);
+            }
+
+            void SetIndexBuffer(const shared<IndexBuffer>& indexBuffer) override { _indexBuffer = indexBuffer; }
+
+            [[nodiscard]] const std::vector<shared<VertexBuffer>>& GetVertexBuffers() const override { return _vertexBuffers; }
+
+            [[nodiscard]] const shared<IndexBuffer>& GetIndexBuffer() const override { return _indexBuffer; }
+
+        private:
+            shared<NullRendererState> _state;
+            uint32_t _id;
+
+            std::vector<shared<VertexBuffer>> _vertexBuffers{};
+            shared<IndexBuffer> _indexBuffer{};
+        };
+
+        class NullShader : public Shader {
+        public:
+            /**
+             * @param declaredUniforms The names of the uniforms that can be uploaded to, or nothing if every name is assumed to be declared
+             */
+            NullShader(
+                shared<NullRendererState> state, std::string name, bool isInstanced,
+                std::optional<std::unordered_set<std::string>> declaredUniforms
+            ) : _state(std::move(state)), _id(_state->NextId++), _name(std::move(name)), _isInstanced(isInstanced),
+                _declaredUniforms(std::move(declaredUniforms)) {
+                _state->Stats.CreatedShaders += 1;
+            }
+
+            ~NullShader() override { _state->StateCache.ForgetProgram(_id); }
+
+            void Bind() const override { _state->StateCache.BindProgram(_id); }
+
+            void Unbind() const override { _state->StateCache.BindProgram(0); }
+
+            [[nodiscard]] const std::string& GetName() const override { return _name; }
+
+            [[nodiscard]] bool IsInstanced() const override { return _isInstanced; }
+
+            void UploadUniformInt1(const std::string& name, int value) override { upload(UniformId(name), value); }
+
+            void UploadUniformInt2(const std::string& name, glm::vec<2, int> value) override { upload(UniformId(name), value); }
+
+            void UploadUniformInt3(const std::string& name, glm::vec<3, int> value) override { upload(UniformId(name), value); }
+
+            void UploadUniformInt4(const std::string& name, glm::vec<4, int> value) override { upload(UniformId(name), value); }
+
+            void UploadUniformFloat1(const std::string& name, float value) override { upload(UniformId(name), value); }
+
+            void UploadUniformFloat2(const std::string& name, const glm::vec2& value) override { upload(UniformId(name), value); }
+
+            void UploadUniformFloat3(const std::string& name, const glm::vec3& value) override { upload(UniformId(name), value); }
+
+            void UploadUniformFloat4(const std::string& name, const glm::vec4& value) override { upload(UniformId(name), value); }
+
+            void UploadUniformMat3(const std::string& name, const glm::mat3& matrix) override { upload(UniformId(name), matrix); }
+
+            void UploadUniformMat4(const std::string& name, const glm::mat4& matrix) override { upload(UniformId(name), matrix); }
+
+            void UploadUniformBool(const std::string& name, bool value) override { upload(UniformId(name), value); }
+
+            void UploadUniformInt1(const UniformId& id, int value) override { upload(id, value); }
+
+            void UploadUniformInt2(const UniformId& id, glm::vec<2, int> value) override { upload(id, value); }
+
+            void UploadUniformInt3(const UniformId& id, glm::vec<3, int> value) override { upload(id, value); }
+
+            void UploadUniformInt4(const UniformId& id, glm::vec<4, int> value) override { upload(id, value); }
+
+            void UploadUniformFloat1(const UniformId& id, float value) override { upload(id, value); }
+
+            void UploadUniformFloat2(const UniformId& id, const glm::vec2& value) override { upload(id, value); }
+
+            void UploadUniformFloat3(const UniformId& id, const glm::vec3& value) override { upload(id, value); }
+
+            void UploadUniformFloat4(const UniformId& id, const glm::vec4& value) override { upload(id, value); }
+
+            void UploadUniformMat3(const UniformId& id, const glm::mat3& matrix) override { upload(id, matrix); }
+
+            void UploadUniformMat4(const UniformId& id, const glm::mat4& matrix) override { upload(id, matrix); }
+
+            void UploadUniformBool(const UniformId& id, bool value) override { upload(id, value); }
+
+        private:
+            /**
+             * Declared uniforms are located at the index of their id, uploads to other names are ignored like in OpenGL
+             */
+            template<class TValue>
+            void upload(const UniformId& id, const TValue& value) {
+                if (_state->StateCache.SetUniform(_id, locationOf(id), &value, sizeof(TValue)))
+                    _state->Stats.UniformBytes += sizeof(TValue);
+            }
+
+            int32_t locationOf(const UniformId& id) {
+                if (!_declaredUniforms.has_value())
+                    return (int32_t) id.GetIndex();
+
+                // Locations are never below -1, so this marks ids whose location was not looked up yet
+                const int32_t unresolved = -2;
+
+                auto index = id.GetIndex();
+                if (index >= _locationsById.size())
+                    _locationsById.resize(index + 1, unresolved);
+                if (_locationsById[index] == unresolved)
+                    _locationsById[index] = _declaredUniforms->count(id.GetName()) > 0 ? (int32_t) index : -1;
+                return _locationsById[index];
+            }
+
+            shared<NullRendererState> _state;
+            uint32_t _id;
+            std::string _name;
+            bool _isInstanced;
+
+            std::optional<std::unordered_set<std::string>> _declaredUniforms;
+            // Indexed by the index of a UniformId, filled whenever an id is used the first time
+            std::vector<int32_t> _locationsById{};
+        };
+
+        class NullTexture2D : public Texture2D {
+        public:
+            explicit NullTexture2D(shared<NullRendererState> state) : _state(std::move(state)), _id(_state->NextId++) {
+                _state->Stats.CreatedTextures += 1;
+            }
+
+            ~NullTexture2D() override { _state->StateCache.ForgetTexture(_id); }
+
+            [[nodiscard]] uint32_t GetWidth() const override { return 1; }
+
+            [[nodiscard]] uint32_t GetHeight() const override { return 1; }
+
+            void Bind(uint32_t slot) const override { _state->StateCache.BindTexture(slot, _id); }
+
+        private:
+            shared<NullRendererState> _state;
+            uint32_t _id;
+        };
+
+        class NullFrameBuffer : public FrameBuffer {
+        public:
+            NullFrameBuffer(shared<NullRendererState> state, int2 size)
+                : _state(std::move(state)), _colorAttachmentId(_state->NextId++), _size(size) {
+                _state->Stats.CreatedFrameBuffers += 1;
+            }
+
+            void Bind() const override {}
+
+            void Unbind() const override {}
+
+            void Resize(int2 size) override { _size = size; }
+
+            [[nodiscard]] int2 GetSize() const override { return _size; }
+
+            [[nodiscard]] uint32_t GetColorAttachmentRendererId() const override { return _colorAttachmentId; }
+
+        private:
+            shared<NullRendererState> _state;
+            uint32_t _colorAttachmentId;
+            int2 _size;
+        };
+    }
+
+    NullRendererAPI::NullRendererAPI(bool shadersFromFilesAreInstanced)
+        : _shadersFromFilesAreInstanced(shadersFromFilesAreInstanced), _state(std::make_shared<NullRendererState>()) {}
+
+    void NullRendererAPI::DrawIndexed(const shared<VertexArray>& vertexArray) {
+        _state->Stats.DrawCalls += 1;
+        _state->Stats.DrawnInstances += 1;
+        _state->Stats.DrawnIndices += vertexArray->GetIndexBuffer()->GetCount();
+    }
+
+    void NullRendererAPI::DrawIndexedInstanced(const shared<VertexArray>& vertexArray, uint32_t instanceCount) {
+        _state->Stats.DrawCalls += 1;
+        _state->Stats.InstancedDrawCalls += 1;
+        _state->Stats.DrawnInstances += instanceCount;
+        _state->Stats.DrawnIndices += (uint64_t) vertexArray->GetIndexBuffer()->GetCount() * instanceCount;
+    }
+
+    shared<VertexBuffer> NullRendererAPI::CreateVertexBuffer(float* vertices, uint32_t size) {
+        return std::make_shared<NullVertexBuffer>(_state, size);
+    }
+
+    shared<VertexBuffer> NullRendererAPI::CreateVertexBuffer(void* vertexData, uint32_t size) {
+        return std::make_shared<NullVertexBuffer>(_state, size);
+    }
+
+    shared<IndexBuffer> NullRendererAPI::CreateIndexBuffer(uint32_t* indices, uint32_t count) {
+        return std::make_shared<NullIndexBuffer>(_state, count);
+    }
+
+    shared<UniformBuffer> NullRendererAPI::CreateUniformBuffer(uint32_t bindingPoint) {
+        return std::make_shared<NullUniformBuffer>(_state);
+    }
+
+    shared<VertexArray> NullRendererAPI::CreateVertexArray() {
+        return std::make_shared<NullVertexArray>(_state);
+    }
+
+    shared<Shader> NullRendererAPI::CreateShader(const Address& address) {
+        return std::make_shared<NullShader>(
+            _state, address.AsRelativePath().stem().string(), _shadersFromFilesAreInstanced, std::nullopt
+        );
+    }
+
+    shared<Shader> NullRendererAPI::CreateShader(
+        const std::string& name, const std::string& vertexSource, const std::string& fragmentSource
+    ) {
+        auto declaredUniforms = std::unordered_set<std::string>();
+        addDeclaredUniforms(vertexSource, declaredUniforms);
+        addDeclaredUniforms(fragmentSource, declaredUniforms);
+        return std::make_shared<NullShader>(
+            _state, name, vertexSource.find("a_M;") != std::string::npos, std::move(declaredUniforms)
+        );
+    }
+
+    shared<Texture2D> NullRendererAPI::CreateTexture2D(const Address& address) {
+        return std::make_shared<NullTexture2D>(_state);
+    }
+
+    shared<FrameBuffer> NullRendererAPI::CreateFrameBuffer(int2 size) {
+        return std::make_shared<NullFrameBuffer>(_state, size);
+    }
+
+    void NullRendererAPI::InvalidateState() {
+        _state->StateCache.Invalidate();
+    }
+
+    RenderStateCounters NullRendererAPI::GetStateCounters() const {
+        return _state->StateCache.GetCounters();
+    }
+
+    void NullRendererAPI::ResetStateCounters() {
+        _state->StateCache.ResetCounters();
+    }
+
+    const NullRendererStats& NullRendererAPI::GetStats() const {
+        return _state->Stats;
+    }
+
+    void NullRendererAPI::ResetStats() {
+        _state->Stats = {};
+    }
+}
@@ -0,0 +1,168 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "renderer/RenderCommandList.h"
+
+namespace modulith {
+
+    void RenderCommandList::Begin(
+        const float4x4& projectionMatrix, const float4x4& viewMatrix, const float3& cameraPosition,
+        const std::optional<Renderer::DirectionalLight>& directionalLight, std::vector<Renderer::PointLight> pointLights
+    ) {
+        _viewMatrix = viewMatrix;
+        _inverseViewMatrix = glm::affineInverse(viewMatrix);
+        _cameraPosition = cameraPosition;
+        _lodScale = projectionMatrix[1][1];
+        _isPerspective = projectionMatrix[2][3] != 0.0f;
+        _stats = {};
+
+        _renderQueue.Clear();
+        _deferredDraws.clear();
+        _commands.clear();
+        _instances.clear();
+
+        // Only scenes with more lights than the uniform block holds drop the lights farthest from the camera
+        if (pointLights.size() > Renderer::MaxLights) {
+            std::nth_element(
+                pointLights.begin(), pointLights.begin() + Renderer::MaxLights, pointLights.end(),
+                [cameraPosition](const auto& first, const auto& second) {
+                    return glm::distance(first.Position, cameraPosition) < glm::distance(second.Position, cameraPosition);
+                }
+            );
+            pointLights.resize(Renderer::MaxLights);
+        }
+        auto lightCount = (int) pointLights.size();
+
+        // The lights are assigned to the objects in world space, but their indices match the view space lights
+        _lightGrid.Build(pointLights.data(), pointLights.size());
+
+        Renderer::PointLight viewSpaceLights[Renderer::MaxLights];
+        for (int i = 0; i < lightCount; ++i) {
+            viewSpaceLights[i] = pointLights[i];
+            viewSpaceLights[i].Position = viewMatrix * float4(pointLights[i].Position, 1.0f);
+        }
+
+        // Uploaded once per scene instead of once per material
+        Renderer::PackSceneUniforms(_sceneUniforms, projectionMatrix, viewMatrix, directionalLight, viewSpaceLights, lightCount);
+    }
+
+    RenderCommandList::InstanceData RenderCommandList::makeInstance(
+        const Mesh& mesh, const float4x4& matrix, const float4x4& inverseMatrix, const float4& color, const float4& lightIndices
+    ) const {
+        // The normals are not quantized, so the normal matrix does not include the dequantization of the positions
+        auto model = mesh.GetVertexFormat() == VertexFormat::Compact ? matrix * mesh.GetPositionDequantization() : matrix;
+
+        // inverse(View * Model) = inverse(Model) * inverse(View), so no matrix needs to be inverted per draw
+        return {model, glm::transpose(inverseMatrix * _inverseViewMatrix), color, lightIndices};
+    }
+
+    float4 RenderCommandList::assignLights(const Bounds& worldBounds) {
+        auto lightIndices = float4(-1.0f);
+        if (_lightGrid.Size() == 0)
+            return lightIndices;
+
+        uint32_t indices[Renderer::MaxLightsPerObject];
+        auto count = _lightGrid.Assign(worldBounds, indices, Renderer::MaxLightsPerObject);
+        for (size_t i = 0; i < count; ++i)
+            lightIndices[(int) i] = (float) indices[i];
+
+        return lightIndices;
+    }
+
+    const Mesh& RenderCommandList::selectLod(const Mesh& mesh, const Bounds& worldBounds) {
+        if (mesh.GetLods().empty())
+            return mesh;
+
+        // The fraction of the screen height covered by the bounding sphere of the object
+        auto screenSize = worldBounds.SphereRadius() * _lodScale;
+        if (_isPerspective)
+            screenSize /= std::max(glm::distance(worldBounds.Center, _cameraPosition), 0.0001f);
+
+        auto& lod = mesh.SelectLod(screenSize);
+        if (&lod != &mesh)
+            _stats.LodDraws += 1;
+        return lod;
+    }
+
+    void RenderCommandList::SubmitImmediately(const shared<Material>& material, const shared<Mesh>& mesh, const float4x4& transform) {
+        auto worldBounds = mesh->LocalBounds().TransformedBy(transform);
+        auto& drawMesh = selectLod(*mesh, worldBounds);
+
+        auto& baseMaterial = material->GetBaseMaterial();
+        _commands.push_back(
+            {&baseMaterial, &drawMesh, (uint32_t) _instances.size(), 1, baseMaterial.GetShader()->IsInstanced()}
+        );
+        _instances.push_back(
+            makeInstance(
+                drawMesh, transform, glm::affineInverse(transform), material->GetInstanceColor(), assignLights(worldBounds)
+            )
+        );
+
+        _stats.ImmediateSubmits += 1;
+        _stats.Vertices += drawMesh.VertexCount();
+        _stats.Triangles += drawMesh.IndexCount() / 3;
+    }
+
+    void RenderCommandList::SubmitDeferred(
+        const shared<Material>& material, const shared<Mesh>& mesh, const float4x4& transform, const float4x4& inverseTransform
+    ) {
+        auto worldBounds = mesh->LocalBounds().TransformedBy(transform);
+        auto& drawMesh = selectLod(*mesh, worldBounds);
+
+        // Opaque geometry is sorted front to back by the view space depth of its origin
+        auto depth = -(_viewMatrix[0][2] * transform[3][0] + _viewMatrix[1][2] * transform[3][1]
+                       + _viewMatrix[2][2] * transform[3][2] + _viewMatrix[3][2]);
+        // Instances of the same base material only differ in per instance data, so they are sorted into one batch
+        auto& baseMaterial = material->GetBaseMaterial();
+        auto key = RenderQueue::MakeKey(
+            baseMaterial.GetShader()->GetSortId(), baseMaterial.GetSortId(), drawMesh._vertexArray->GetSortId(), depth
+        );
+
+        _renderQueue.Push(key, (uint32_t) _deferredDraws.size());
+        _deferredDraws.push_back(
+            {&baseMaterial, &drawMesh, transform, inverseTransform, material->GetInstanceColor(), assignLights(worldBounds)}
+        );
+
+        _stats.DeferredSubmits += 1;
+        _stats.Vertices += drawMesh.VertexCount();
+        _stats.Triangles += drawMesh.IndexCount() / 3;
+    }
+
+    void RenderCommandList::Finish() {
+        // Draws sharing a material or vertex array are adjacent after sorting
+        _renderQueue.Sort();
+
+        const auto& entries = _renderQueue.GetEntries();
+        for (size_t begin = 0; begin < entries.size();) {
+            auto& first = _deferredDraws[entries[begin].Payload];
+            const auto& vertexArray = first.DrawMesh->_vertexArray;
+
+            // The following draws with the same material and vertex array form a batch
+            auto end = begin + 1;
+            while (end < entries.size()) {
+                auto& draw = _deferredDraws[entries[end].Payload];
+                if (draw.DrawMaterial != first.DrawMaterial || draw.DrawMesh->_vertexArray != vertexArray)
+                    break;
+                ++end;
+            }
+
+            _commands.push_back(
+                {
+                    first.DrawMaterial, first.DrawMesh, (uint32_t) _instances.size(), (uint32_t) (end - begin),
+                    first.DrawMaterial->GetShader()->IsInstanced()
+                }
+            );
+            for (auto i = begin; i < end; ++i) {
+                auto& draw = _deferredDraws[entries[i].Payload];
+                _instances.push_back(makeInstance(*draw.DrawMesh, draw.Matrix, draw.InverseMatrix, draw.Color, draw.LightIndices));
+            }
+
+            begin = end;
+        }
+
+        _renderQueue.Clear();
+        _deferredDraws.clear();
+    }
+}
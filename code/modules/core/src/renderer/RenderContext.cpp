@@ -5,6 +5,9 @@
 
 #include "renderer/RenderContext.h"
 #include "Context.h"
+#include "renderer/NullRendererAPI.h"
+#include <window/NullWindow.h>
+#include <utils/PreferencesContext.h>
 
 // Headers below cannot be in a "public" header, since this header is not public itself
 #include <opengl/OpenGLRendererAPI.h>
@@ -12,9 +15,37 @@
 
 namespace modulith{
 
+    namespace {
+
+        /**
+         * @return Returns whether the "RendererAPI" preference is "Null", which is OpenGL otherwise.
+         * The null API does not draw anything, which allows profiling the renderer without the cost of the GPU.
+         */
+        bool usesNullRendererAPI() {
+            return Context::Instance().Get<PreferencesContext>()->TryGet("RendererAPI") == "Null";
+        }
+
+        shared<RendererAPI> createRendererAPI(bool isHeadless) {
+            if (isHeadless) {
+                CoreLogInfo("The null renderer API is used, so nothing will be drawn")
+                return std::make_shared<NullRendererAPI>();
+            }
+            return std::make_shared<OpenGLRendererAPI>();
+        }
+
+        /**
+         * Creates the main window. Headless windows are never shown and do not create a graphics context
+         */
+        owned<Window> createWindow(bool isHeadless, const WindowConfig& config) {
+            if (isHeadless)
+                return std::make_unique<NullWindow>(config);
+            return Window::Create(config);
+        }
+    }
+
     void RenderContext::OnInitialize() {
         _imguiWindow->OnInitialize();
-        InitializeImGui(*_mainWindow);
+        InitializeImGui(*_mainWindow, _isHeadless);
         _renderer->initialize();
     }
 
@@ -69,7 +100,7 @@ namespace modulith{
                 _imguiWindow->setIsFocused(ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows));
 
                 ImGui::GetWindowDrawList()->AddImage(
-                    (void*) _renderer->_colorTex,
+                    (void*) (intptr_t) _renderer->_frameBuffer->GetColorAttachmentRendererId(),
                     ImVec2(imguiCursorPos.x, imguiCursorPos.y),
                     ImVec2(imguiCursorPos.x + size.x, imguiCursorPos.y + size.y), ImVec2(0, 1),
                     ImVec2(1, 0));
@@ -99,9 +130,10 @@ namespace modulith{
     }
 
     RenderContext::RenderContext() : Subcontext("Render Context"),
+                                     _isHeadless(usesNullRendererAPI()),
                                      _shaderLibrary(std::make_unique<ShaderLibrary>()),
-                                     _renderer(std::make_unique<Renderer>(std::make_shared<OpenGLRendererAPI>())),
-                                     _mainWindow(Window::Create({"Modulith", 1280, 720, WindowType::Default })),
+                                     _renderer(std::make_unique<Renderer>(createRendererAPI(_isHeadless))),
+                                     _mainWindow(createWindow(_isHeadless, {"Modulith", 1280, 720, WindowType::Default })),
                                      _currentWindow(ref(&_mainWindow)){
 
         _imguiWindow = std::make_unique<SubWindow>(_currentWindow);
@@ -0,0 +1,86 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "renderer/RenderQueue.h"
+#include <atomic>
+#include <cstring>
+
+namespace modulith {
+
+    namespace {
+        constexpr uint64_t depthBits = 20;
+        constexpr uint64_t vertexArrayBits = 20;
+        constexpr uint64_t materialBits = 14;
+        constexpr uint64_t shaderBits = 10;
+
+        constexpr uint64_t mask(uint64_t bits) { return (uint64_t(1) << bits) - 1; }
+
+        /**
+         * The bits of a non-negative float are ordered like the float itself,
+         * so its upper bits are a quantization that keeps more precision close to the camera
+         */
+        uint64_t quantizeDepth(float depth) {
+            depth = std::max(depth, 0.0f);
+            uint32_t bits;
+            std::memcpy(&bits, &depth, sizeof(bits));
+            return (bits >> (31u - depthBits)) & mask(depthBits);
+        }
+    }
+
+    uint32_t RenderQueue::NextSortId(SortIdKind kind) {
+        static std::atomic<uint32_t> nextShaderId{0};
+        static std::atomic<uint32_t> nextMaterialId{0};
+        static std::atomic<uint32_t> nextVertexArrayId{0};
+
+        switch (kind) {
+            case SortIdKind::Shader:
+                return (uint32_t) (nextShaderId++ & mask(shaderBits));
+            case SortIdKind::Material:
+                return (uint32_t) (nextMaterialId++ & mask(materialBits));
+            case SortIdKind::VertexArray:
+                return (uint32_t) (nextVertexArrayId++ & mask(vertexArrayBits));
+        }
+        return 0;
+    }
+
+    uint64_t RenderQueue::MakeKey(uint32_t shaderId, uint32_t materialId, uint32_t vertexArrayId, float depth) {
+        return ((shaderId & mask(shaderBits)) << (materialBits + vertexArrayBits + depthBits))
+               | ((materialId & mask(materialBits)) << (vertexArrayBits + depthBits))
+               | ((vertexArrayId & mask(vertexArrayBits)) << depthBits)
+               | quantizeDepth(depth);
+    }
+
+    void RenderQueue::Sort() {
+        constexpr size_t passes = sizeof(uint64_t);
+        constexpr size_t buckets = 256;
+
+        // The histograms of all passes are built at once, so the keys are only read one extra time
+        size_t histograms[passes][buckets]{};
+        for (auto& entry : _entries)
+            for (size_t pass = 0; pass < passes; ++pass)
+                ++histograms[pass][(entry.Key >> (pass * 8)) & 0xFF];
+
+        _sortBuffer.resize(_entries.size());
+        for (size_t pass = 0; pass < passes; ++pass) {
+            auto& histogram = histograms[pass];
+            auto shift = pass * 8;
+
+            // All keys share this byte, so this pass would not change the order
+            if (histogram[(_entries.empty() ? 0 : _entries[0].Key >> shift) & 0xFF] == _entries.size())
+                continue;
+
+            size_t offset = 0;
+            for (auto& count : histogram) {
+                auto bucketSize = count;
+                count = offset;
+                offset += bucketSize;
+            }
+
+            for (auto& entry : _entries)
+                _sortBuffer[histogram[(entry.Key >> shift) & 0xFF]++] = entry;
+            _entries.swap(_sortBuffer);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "renderer/RenderStateCache.h"
+#include <cstring>
+
+namespace modulith {
+
+    bool RenderStateCache::BindProgram(uint32_t program) {
+        if (_program == program) {
+            _counters.SkippedProgramBinds += 1;
+            return false;
+        }
+        _program = program;
+        _counters.ProgramBinds += 1;
+        return true;
+    }
+
+    bool RenderStateCache::BindVertexArray(uint32_t vertexArray) {
+        if (_vertexArray == vertexArray) {
+            _counters.SkippedVertexArrayBinds += 1;
+            return false;
+        }
+        _vertexArray = vertexArray;
+        _counters.VertexArrayBinds += 1;
+        return true;
+    }
+
+    bool RenderStateCache::BindTexture(uint32_t unit, uint32_t texture) {
+        if (unit < MaxTextureUnits) {
+            if (_textures[unit] == texture) {
+                _counters.SkippedTextureBinds += 1;
+                return false;
+            }
+            _textures[unit] = texture;
+        }
+        _counters.TextureBinds += 1;
+        return true;
+    }
+
+    bool RenderStateCache::SetUniform(uint32_t program, int32_t location, const void* value, uint32_t size) {
+        if (location < 0)
+            return false;
+
+        if (size > MaxUniformSize) {
+            _counters.UniformUploads += 1;
+            return true;
+        }
+
+        auto& values = _uniforms[program];
+        if ((size_t) location >= values.size())
+            values.resize(location + 1);
+
+        auto& shadowed = values[location];
+        if (shadowed.Size == size && std::memcmp(shadowed.Bytes.data(), value, size) == 0) {
+            _counters.SkippedUniformUploads += 1;
+            return false;
+        }
+
+        shadowed.Size = size;
+        std::memcpy(shadowed.Bytes.data(), value, size);
+        _counters.UniformUploads += 1;
+        return true;
+    }
+
+    void RenderStateCache::ForgetProgram(uint32_t program) {
+        _uniforms.erase(program);
+        if (_program == program)
+            _program = unknown;
+    }
+
+    void RenderStateCache::ForgetVertexArray(uint32_t vertexArray) {
+        // Deleting a bound vertex array binds the default one
+        if (_vertexArray == vertexArray)
+            _vertexArray = 0;
+    }
+
+    void RenderStateCache::ForgetTexture(uint32_t texture) {
+        // Deleting a bound texture binds the default one to its units
+        for (auto& bound : _textures)
+            if (bound == texture)
+                bound = 0;
+    }
+
+    void RenderStateCache::Invalidate() {
+        _program = unknown;
+        _vertexArray = unknown;
+        _textures.fill(unknown);
+    }
+}
@@ -4,148 +4,193 @@
  */
 
 #include <renderer/Renderer.h>
+#include <renderer/RenderCommandList.h>
 #include "Context.h"
-#include <glad/glad.h>
 #include "renderer/RenderContext.h"
 
 #include <utility>
 
 namespace modulith{
 
-// TODO temp for performance
-    const std::string _uniformP = "u_P";
-    const std::string _uniformV = "u_V";
-    const std::string _uniformM = "u_M";
-    const std::string _uniformN = "u_N";
+    const UniformId _uniformM("u_M");
+    const UniformId _uniformN("u_N");
+    const UniformId _uniformInstanceColor("u_InstanceColor");
+    const UniformId _uniformInstanceLightIndices("u_InstanceLightIndices");
+    const UniformId _uniformOctahedralNormals("u_OctahedralNormals");
+    const UniformId _uniformTexCoordTransform("u_TexCoordTransform");
 
-    const std::string _uniformCameraPosition = "u_CameraPosition";
-    const std::string _uniformLightCount = "u_LightCount";
+    Renderer::Renderer(const shared<RendererAPI>& rendererAPI)
+        : _commandList(std::make_unique<RenderCommandList>()), _api(rendererAPI) {}
 
-    std::string _uniformLightField(int index, const std::string& fieldName) {
-        return "u_Lights["+ std::to_string(index) + "]." + fieldName;
-    }
+    Renderer::~Renderer() = default;
 
     void Renderer::initialize() {
         _api->Init();
 
         auto window = Context::GetInstance<RenderContext>()->GetWindow();
-        initTex(int2(window->GetWidth(), window->GetHeight()));
+        _frameBuffer = _api->CreateFrameBuffer(window->GetSize());
     }
 
     void Renderer::shutdown() {
-        destroyTex();
+        _frameBuffer.reset();
     }
 
 
-    void Renderer::bindMaterial(const shared<Material>& material){
-        const auto& shader = material->GetShader();
-        material->Bind();
+    void Renderer::bindMaterial(Material& material){
+        // The camera and lights are provided by the scene uniform buffer, which was bound before the first command
+        material.Bind();
+    }
 
-        shader->UploadUniformMat4(_uniformP, _sceneData->ProjectionMatrix);
-        shader->UploadUniformMat4(_uniformV, _sceneData->ViewMatrix);
+    void Renderer::bindMesh(const shared<Shader>& activeShader, const Mesh& mesh){
+        mesh._vertexArray->Bind();
 
-        // Camera is always at origin, since lighting is calculated in view space
-        shader->UploadUniformFloat3(_uniformCameraPosition, float3(0.0f));
+        // Positions are dequantized by the model matrix, but normals and tex coords are decoded by the shader
+        activeShader->UploadUniformBool(_uniformOctahedralNormals, mesh.GetVertexFormat() == VertexFormat::Compact);
+        activeShader->UploadUniformFloat4(_uniformTexCoordTransform, mesh.GetTexCoordTransform());
+    }
 
-        shader->UploadUniformBool("u_DirectionalLight.Exists", _sceneData->CurrentDirectionalLight.has_value());
-        if(_sceneData->CurrentDirectionalLight.has_value()){
-            shader->UploadUniformFloat3("u_DirectionalLight.Direction", _sceneData->ViewMatrix * float4(_sceneData->CurrentDirectionalLight->Direction, 0.0f));
-            shader->UploadUniformFloat3("u_DirectionalLight.Color", _sceneData->CurrentDirectionalLight->Color);
-            shader->UploadUniformFloat1("u_DirectionalLight.AmbientFactor", _sceneData->CurrentDirectionalLight->AmbientFactor);
-        }
+    void Renderer::drawVertexArray(
+        const shared<Shader>& activeShader, const shared<VertexArray>& vertexArray, const float4x4& matrix,
+        const float4x4& normalMatrix, const float4& color, const float4& lightIndices
+    ){
+        activeShader->UploadUniformMat4(_uniformM, matrix);
+        activeShader->UploadUniformMat4(_uniformN, normalMatrix);
+        activeShader->UploadUniformFloat4(_uniformInstanceColor, color);
+        activeShader->UploadUniformFloat4(_uniformInstanceLightIndices, lightIndices);
 
+        _api->DrawIndexed(vertexArray);
+    }
 
-        shader->UploadUniformInt1(_uniformLightCount, _sceneData->CurrentLightCount);
-        for(int i = 0; i < _sceneData->CurrentLightCount; ++i){
-            auto light = _sceneData->CurrentCameraLights[i];
-            shader->UploadUniformFloat3(_uniformLightField(i, "Position"), light.Position);
-            shader->UploadUniformFloat3(_uniformLightField(i, "Color"), light.Color);
+    void Renderer::drawInstances(const shared<VertexArray>& vertexArray, const void* instances, uint32_t instanceCount){
+        if(_instanceBuffer == nullptr){
+            _instanceBuffer = _api->CreateVertexBuffer(static_cast<void*>(nullptr), 0);
+            _instanceBuffer->SetLayout(
+                BufferLayout(
+                    {
+                        {ShaderDataType::Mat4, "a_M"},
+                        {ShaderDataType::Mat4, "a_N"},
+                        {ShaderDataType::Float4, "a_Color"},
+                        {ShaderDataType::Float4, "a_LightIndices"}
+                    }, true
+                )
+            );
+        }
 
-            // Quadratic falloff, so the light has 10% of its power at its range
-            shader->UploadUniformFloat1(_uniformLightField(i, "Constant"), 1.0f);
-            shader->UploadUniformFloat1(_uniformLightField(i, "Linear"), 0.0f);
-            auto quadratic = 10.0f / std::pow(light.Range, 2);
-            shader->UploadUniformFloat1(_uniformLightField(i, "Quadratic"), quadratic);
-            shader->UploadUniformFloat1(_uniformLightField(i, "AmbientFactor"), 0.0f);
+        // Every vertex array reads its instances from the same buffer, which is attached the first time it is drawn instanced
+        const auto& vertexBuffers = vertexArray->GetVertexBuffers();
+        if(std::find(vertexBuffers.begin(), vertexBuffers.end(), _instanceBuffer) == vertexBuffers.end()){
+            vertexArray->AddVertexBuffer(_instanceBuffer);
+            vertexArray->Bind();
         }
 
+        _instanceBuffer->SetData(instances, (uint32_t) (instanceCount * sizeof(RenderCommandList::InstanceData)));
+        _api->DrawIndexedInstanced(vertexArray, instanceCount);
     }
 
-    void Renderer::bindVertexArray(const shared<VertexArray>& vertexArray){
-        vertexArray->Bind();
-    }
+    Renderer::SceneStats Renderer::Execute(const RenderCommandList& commandList) {
+        auto stats = commandList.GetStats();
+        _api->ResetStateCounters();
+
+        const auto& sceneUniforms = commandList.GetSceneUniforms();
+        if(_sceneUniformBuffer == nullptr)
+            _sceneUniformBuffer = _api->CreateUniformBuffer(SceneUniformBlock::BindingPoint);
+        _sceneUniformBuffer->SetData(sceneUniforms.GetData(), (uint32_t) sceneUniforms.GetSize());
+        _sceneUniformBuffer->Bind();
+
+        const auto& instances = commandList.GetInstances();
+        Material* boundMaterial = nullptr;
+        const VertexArray* boundVertexArray = nullptr;
+        for(const auto& command : commandList.GetCommands()){
+            const auto& vertexArray = command.DrawMesh->_vertexArray;
+
+            if(command.DrawMaterial != boundMaterial){
+                bindMaterial(*command.DrawMaterial);
+                boundMaterial = command.DrawMaterial;
+                boundVertexArray = nullptr;
+                stats.MaterialBatches += 1;
+            }
+            if(vertexArray.get() != boundVertexArray){
+                bindMesh(boundMaterial->GetShader(), *command.DrawMesh);
+                boundVertexArray = vertexArray.get();
+                stats.VertexArrayBatches += 1;
+            }
 
-    void Renderer::drawVertexArray(const shared<Shader>& activeShader, const shared<VertexArray>& vertexArray, float4x4 matrix){
-        activeShader->UploadUniformMat4(_uniformM, matrix);
-        auto normalMatrix = glm::transpose(glm::inverse(_sceneData->ViewMatrix * matrix));
-        activeShader->UploadUniformMat4(_uniformN, normalMatrix);
+            if(command.IsInstanced){
+                drawInstances(vertexArray, instances.data() + command.FirstInstance, command.InstanceCount);
+                stats.BatchedDrawCalls += 1;
+                stats.InstancedDrawCalls += 1;
+            }
+            else{
+                const auto& shader = boundMaterial->GetShader();
+                for(auto i = command.FirstInstance; i < command.FirstInstance + command.InstanceCount; ++i){
+                    auto& instance = instances[i];
+                    drawVertexArray(shader, vertexArray, instance.Model, instance.Normal, instance.Color, instance.LightIndices);
+                    stats.BatchedDrawCalls += 1;
+                }
+            }
+        }
 
-        _api->DrawIndexed(vertexArray);
+        stats.StateChanges = _api->GetStateCounters();
+        return stats;
     }
 
     void Renderer::BeginScene(glm::mat4 projectionMatrix, float4x4 viewMatrix, float3 cameraPosition, std::optional<DirectionalLight> directionalLight, std::vector<PointLight> pointLights) {
-        _sceneData = std::make_unique<SceneData>();
+        _commandList->Begin(projectionMatrix, viewMatrix, cameraPosition, directionalLight, std::move(pointLights));
+    }
 
-        _sceneData->ProjectionMatrix = projectionMatrix;
-        _sceneData->ViewMatrix = viewMatrix;
+    void Renderer::PackSceneUniforms(
+        Std140Writer& writer, const float4x4& projectionMatrix, const float4x4& viewMatrix,
+        const std::optional<DirectionalLight>& directionalLight, const PointLight* viewSpaceLights, int lightCount
+    ){
+        writer.Clear();
+        writer.Write(projectionMatrix);
+        writer.Write(viewMatrix);
 
-        _sceneData->CurrentDirectionalLight = directionalLight;
-        _sceneData->Lights = std::move(pointLights);
+        // Camera is always at origin, since lighting is calculated in view space
+        writer.Write(float3(0.0f));
+        writer.Write((int32_t) lightCount);
 
-        std::sort(_sceneData->Lights.begin(), _sceneData->Lights.end(), [cameraPosition](const PointLight& first, const PointLight& second){
-            return glm::distance(first.Position, cameraPosition) < glm::distance(second.Position, cameraPosition);
-        });
+        writer.BeginStruct();
+        writer.Write(directionalLight.has_value());
+        writer.Write(directionalLight ? float3(viewMatrix * float4(directionalLight->Direction, 0.0f)) : float3(0.0f));
+        writer.Write(directionalLight ? directionalLight->Color : float3(0.0f));
+        writer.Write(directionalLight ? directionalLight->AmbientFactor : 0.0f);
+        writer.EndStruct();
 
-        _sceneData->CurrentLightCount = std::min<int>(4, _sceneData->Lights.size());
-        for(int i = 0; i < _sceneData->CurrentLightCount; ++i){
-            auto light = _sceneData->Lights[i];
-            light.Position = _sceneData->ViewMatrix * float4(light.Position, 1.0f);
-            _sceneData->CurrentCameraLights[i] = light;
-        }
-    }
+        // The whole array is always written, so the size of the buffer matches the block
+        for(int i = 0; i < MaxLights; ++i){
+            auto light = i < lightCount ? viewSpaceLights[i] : PointLight();
 
+            writer.BeginStruct();
+            writer.Write(light.Position);
+            writer.Write(light.Color);
+            writer.Write(0.0f);
 
-    Renderer::SceneStats Renderer::EndScene() {
-        // Copy is needed because scene data is destroyed!
-        Renderer::SceneStats stats = _sceneData->Stats;
-
-        for(auto& materialKvp : _sceneData->_batches){
-            bindMaterial(materialKvp.first);
-            stats.MaterialBatches += 1;
-            for(auto& vertexArrayKvp : materialKvp.second._vertexArrayBatch){
-                bindVertexArray(vertexArrayKvp.first);
-                stats.VertexArrayBatches += 1;
-                for(auto& drawTransform : vertexArrayKvp.second._matrices){
-                    drawVertexArray(materialKvp.first->GetShader(), vertexArrayKvp.first, drawTransform);
-                    stats.BatchedDrawCalls += 1;
-                }
-            }
+            // Quadratic falloff, so the light has 10% of its power at its range
+            writer.Write(1.0f);
+            writer.Write(0.0f);
+            writer.Write(light.Range > 0.0f ? 10.0f / std::pow(light.Range, 2.0f) : 0.0f);
+            writer.EndStruct();
         }
+    }
 
-        _sceneData.reset();
-        return stats;
+    Renderer::SceneStats Renderer::EndScene() {
+        _commandList->Finish();
+        return Execute(*_commandList);
     }
 
     void Renderer::SubmitImmediately(const shared<Material>& material, const shared<Mesh>& mesh, glm::mat4 transform) {
-        bindMaterial(material);
-        bindVertexArray(mesh->_vertexArray);
-        drawVertexArray(material->GetShader(), mesh->_vertexArray, transform);
-
-        auto& stats = _sceneData->Stats;
-        stats.ImmediateSubmits += 1;
-        stats.Vertices += mesh->VertexCount();
-        stats.Triangles += mesh->IndexCount() / 3;
+        _commandList->SubmitImmediately(material, mesh, transform);
     }
 
     void Renderer::SubmitDeferred(const shared<Material> &material, const shared<Mesh> &mesh, glm::mat4 transform) {
-        auto& materialBatch = _sceneData->_batches[material];
-        auto& vertexArrayBatch = materialBatch._vertexArrayBatch[mesh->_vertexArray];
-        vertexArrayBatch._matrices.push_back(transform);
-
-        auto& stats = _sceneData->Stats;
-        stats.DeferredSubmits += 1;
-        stats.Vertices += mesh->VertexCount();
-        stats.Triangles += mesh->IndexCount() / 3;
+        _commandList->SubmitDeferred(material, mesh, transform, glm::affineInverse(transform));
+    }
+
+    void Renderer::SubmitDeferred(
+        const shared<Material>& material, const shared<Mesh>& mesh, const glm::mat4& transform, const glm::mat4& inverseTransform
+    ) {
+        _commandList->SubmitDeferred(material, mesh, transform, inverseTransform);
     }
 
 
@@ -153,18 +198,14 @@ namespace modulith{
         auto& ctx = Context::Instance();
         if(ctx.IsImGuiEnabled()){
             auto window = ctx.Get<RenderContext>()->GetWindow();
-            auto renderSize = int2(window->GetWidth(), window->GetHeight());
-
-            if(renderSize != _currentImGuiFramebufferSize){
-                resize(renderSize);
-                _currentImGuiFramebufferSize = renderSize;
-            }
-
-            glBindTexture(GL_TEXTURE_2D, _colorTex);
-            glBindFramebuffer(GL_FRAMEBUFFER, _frameBuffer);
-            glViewport(0, 0, renderSize.x, renderSize.y);
+            if(window->GetSize() != _frameBuffer->GetSize())
+                _frameBuffer->Resize(window->GetSize());
+            _frameBuffer->Bind();
         }
 
+        // ImGui binds state without the renderer API
+        _api->InvalidateState();
+
         _api->SetClearColor({0.0f, 0.0f, 0.0f, 1.0f});
         _api->Clear();
     }
@@ -174,62 +215,12 @@ namespace modulith{
         if(ctx.IsImGuiEnabled())
         {
             auto window = ctx.Get<RenderContext>()->GetWindow();
-            glViewport(0, 0, window->GetWidth(), window->GetHeight());
-
-            glBindTexture(GL_TEXTURE_2D, 0);
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            _frameBuffer->Unbind();
+            _api->SetViewport(window->GetSize());
 
             _api->SetClearColor({0.0f, 0.0f, 0.0f, 1.0f});
             _api->Clear();
         }
     }
 
-
-    void Renderer::initTex(int2 initialTextureSize) {
-
-        glGenFramebuffers(1, &_frameBuffer);
-        glBindFramebuffer(GL_FRAMEBUFFER, _frameBuffer);
-
-        glGenTextures(1, &_colorTex);
-        glBindTexture(GL_TEXTURE_2D, _colorTex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, initialTextureSize.x, initialTextureSize.y, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-// attach it to currently bound framebuffer object
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _colorTex, 0);
-
-        glGenTextures(1, &_depthTex);
-        glBindTexture(GL_TEXTURE_2D, _depthTex);
-        glTexImage2D(GL_TEXTURE_2D, 0,  GL_DEPTH_COMPONENT, initialTextureSize.x, initialTextureSize.y, 0,   GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-
-        glFramebufferTexture2D(GL_FRAMEBUFFER, 	GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, _depthTex, 0);
-
-        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-            std::cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!" << std::endl;
-
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-    }
-
-    void Renderer::resize(int2 newTextureSize){
-        glBindTexture(GL_TEXTURE_2D, _colorTex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, newTextureSize.x, newTextureSize.y, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-
-        glBindTexture(GL_TEXTURE_2D, _depthTex);
-        glTexImage2D(GL_TEXTURE_2D, 0,  GL_DEPTH_COMPONENT, newTextureSize.x, newTextureSize.y, 0,   GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
-
-    void Renderer::destroyTex() {
-        glDeleteTextures(1, &_colorTex);
-        glDeleteTextures(1, &_depthTex);
-        glDeleteFramebuffers(1, &_frameBuffer);
-    }
-
 }
@@ -7,6 +7,16 @@
 
 namespace modulith{
 
+    namespace {
+        const UniformId _uniformDiffuseColor("u_Material.DiffuseColor");
+        const UniformId _uniformHasDiffuseTex("u_Material.HasDiffuseTex");
+        const UniformId _uniformDiffuseTex("u_Material.DiffuseTex");
+        const UniformId _uniformSpecularColor("u_Material.SpecularColor");
+        const UniformId _uniformHasSpecularTex("u_Material.HasSpecularTex");
+        const UniformId _uniformSpecularTex("u_Material.SpecularTex");
+        const UniformId _uniformShininess("u_Material.Shininess");
+    }
+
     StandardMaterial::StandardMaterial(
         shared<Shader> shader, shared<Texture> diffuseTexture, shared<Texture> specularTexture,
         float shininess
@@ -17,20 +27,20 @@ namespace modulith{
     void StandardMaterial::UploadUniforms() {
         Material::UploadUniforms();
 
-        _shader->UploadUniformFloat3("u_Material.DiffuseColor", DiffuseColor);
-        _shader->UploadUniformBool("u_Material.HasDiffuseTex", DiffuseTexture != nullptr);
+        _shader->UploadUniformFloat3(_uniformDiffuseColor, DiffuseColor);
+        _shader->UploadUniformBool(_uniformHasDiffuseTex, DiffuseTexture != nullptr);
         if (DiffuseTexture) {
-            _shader->UploadUniformInt1("u_Material.DiffuseTex", 0);
+            _shader->UploadUniformInt1(_uniformDiffuseTex, 0);
             DiffuseTexture->Bind(0);
         }
 
-        _shader->UploadUniformFloat3("u_Material.SpecularColor", SpecularColor);
-        _shader->UploadUniformBool("u_Material.HasSpecularTex", SpecularTexture != nullptr);
+        _shader->UploadUniformFloat3(_uniformSpecularColor, SpecularColor);
+        _shader->UploadUniformBool(_uniformHasSpecularTex, SpecularTexture != nullptr);
         if (SpecularTexture) {
-            _shader->UploadUniformInt1("u_Material.SpecularTex", 1);
+            _shader->UploadUniformInt1(_uniformSpecularTex, 1);
             SpecularTexture->Bind(1);
         }
-        _shader->UploadUniformFloat1("u_Material.Shininess", Shininess);
+        _shader->UploadUniformFloat1(_uniformShininess, Shininess);
     }
 
 
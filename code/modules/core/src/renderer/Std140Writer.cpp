@@ -0,0 +1,67 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "renderer/Std140Writer.h"
+#include <cstring>
+
+namespace modulith {
+
+    size_t Std140Writer::Write(float value) {
+        return write(&value, sizeof(float), 4);
+    }
+
+    size_t Std140Writer::Write(int32_t value) {
+        return write(&value, sizeof(int32_t), 4);
+    }
+
+    size_t Std140Writer::Write(bool value) {
+        return Write((int32_t) (value ? 1 : 0));
+    }
+
+    size_t Std140Writer::Write(const float2& value) {
+        const float components[] = {value.x, value.y};
+        return write(components, sizeof(components), 8);
+    }
+
+    size_t Std140Writer::Write(const float3& value) {
+        // Only 12 bytes are used, so a following scalar can be packed into the fourth component
+        const float components[] = {value.x, value.y, value.z};
+        return write(components, sizeof(components), 16);
+    }
+
+    size_t Std140Writer::Write(const float4& value) {
+        const float components[] = {value.x, value.y, value.z, value.w};
+        return write(components, sizeof(components), 16);
+    }
+
+    size_t Std140Writer::Write(const float4x4& value) {
+        auto offset = Write(float4(value[0]));
+        for (int column = 1; column < 4; ++column)
+            Write(float4(value[column]));
+        return offset;
+    }
+
+    void Std140Writer::BeginStruct() {
+        align(16);
+    }
+
+    void Std140Writer::EndStruct() {
+        align(16);
+    }
+
+    size_t Std140Writer::write(const void* value, size_t size, size_t alignment) {
+        align(alignment);
+        auto offset = _data.size();
+        _data.resize(offset + size);
+        std::memcpy(_data.data() + offset, value, size);
+        return offset;
+    }
+
+    void Std140Writer::align(size_t alignment) {
+        auto remainder = _data.size() % alignment;
+        if (remainder != 0)
+            _data.resize(_data.size() + alignment - remainder, 0);
+    }
+}
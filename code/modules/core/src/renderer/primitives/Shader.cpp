@@ -7,9 +7,43 @@
 #include <renderer/Renderer.h>
 #include <opengl/primitives/OpenGLShader.h>
 #include "renderer/RenderContext.h"
+#include <deque>
+#include <mutex>
 
 namespace modulith{
 
+    namespace {
+        /**
+         * The names of all uniform ids. A deque is used, so the names are never moved when new ones are added.
+         */
+        struct UniformNames {
+            std::mutex Mutex;
+            std::unordered_map<std::string, uint32_t> Indices;
+            std::deque<std::string> Names;
+        };
+
+        UniformNames& uniformNames() {
+            static UniformNames names;
+            return names;
+        }
+    }
+
+    UniformId::UniformId(const std::string& name) {
+        auto& names = uniformNames();
+        std::lock_guard<std::mutex> lock(names.Mutex);
+
+        auto result = names.Indices.emplace(name, (uint32_t) names.Names.size());
+        if (result.second)
+            names.Names.push_back(name);
+        _index = result.first->second;
+    }
+
+    const std::string& UniformId::GetName() const {
+        auto& names = uniformNames();
+        std::lock_guard<std::mutex> lock(names.Mutex);
+        return names.Names[_index];
+    }
+
     void ShaderLibrary::Add(const shared<Shader>& shader) {
         auto& name = shader->GetName();
         Add(name, shader);
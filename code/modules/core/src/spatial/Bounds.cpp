@@ -0,0 +1,35 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "spatial/Bounds.h"
+
+namespace modulith {
+
+    Bounds Bounds::FromPoints(const float3* points, size_t count, size_t stride) {
+        if (count == 0)
+            return Bounds();
+
+        const auto pointAt = [points, stride](size_t index) -> const float3& {
+            return *reinterpret_cast<const float3*>(reinterpret_cast<const uint8_t*>(points) + index * stride);
+        };
+
+        auto min = pointAt(0);
+        auto max = pointAt(0);
+        for (size_t i = 1; i < count; ++i) {
+            min = glm::min(min, pointAt(i));
+            max = glm::max(max, pointAt(i));
+        }
+        return Bounds((min + max) * 0.5f, (max - min) * 0.5f);
+    }
+
+    Bounds Bounds::TransformedBy(const float4x4& transform) const {
+        // The extents along each world axis are the sum of the absolute projections of the box's axes (Arvo's method)
+        auto center = float3(transform * float4(Center, 1.0f));
+        auto extents = glm::abs(float3(transform[0])) * Extents.x
+                       + glm::abs(float3(transform[1])) * Extents.y
+                       + glm::abs(float3(transform[2])) * Extents.z;
+        return Bounds(center, extents);
+    }
+}
@@ -0,0 +1,115 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "spatial/Frustum.h"
+
+#if defined(_M_X64) || defined(__SSE2__)
+    #include <xmmintrin.h>
+    #define MODU_FRUSTUM_KERNEL_SSE
+#endif
+
+namespace modulith {
+
+    namespace {
+
+        /**
+         * @return Returns the signed distance of the box's furthest point in the direction of the plane's normal.
+         * The box is completely behind the plane if this is negative.
+         */
+        inline float furthestDistanceTo(const float4& plane, const Bounds& bounds) {
+            return plane.x * bounds.Center.x + plane.y * bounds.Center.y + plane.z * bounds.Center.z + plane.w
+                   + std::abs(plane.x) * bounds.Extents.x + std::abs(plane.y) * bounds.Extents.y
+                   + std::abs(plane.z) * bounds.Extents.z;
+        }
+
+#ifdef MODU_FRUSTUM_KERNEL_SSE
+
+        /**
+         * Loads a value of four consecutive bounds into a single register
+         */
+        template<class TGetter>
+        inline __m128 gather4(const WorldBoundsData* bounds, TGetter get) {
+            return _mm_setr_ps(get(bounds[0].Value), get(bounds[1].Value), get(bounds[2].Value), get(bounds[3].Value));
+        }
+
+        /**
+         * The SSE version of the plane test. Four bounds are tested against all planes at once.
+         * @return Returns the amount of bounds that were tested, which is a multiple of four
+         */
+        size_t cullSSE(const std::array<float4, 6>& planes, const WorldBoundsData* bounds, size_t count, uint8_t* visible) {
+            const auto zero = _mm_setzero_ps();
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                auto cx = gather4(bounds + i, [](const Bounds& b) { return b.Center.x; });
+                auto cy = gather4(bounds + i, [](const Bounds& b) { return b.Center.y; });
+                auto cz = gather4(bounds + i, [](const Bounds& b) { return b.Center.z; });
+                auto ex = gather4(bounds + i, [](const Bounds& b) { return b.Extents.x; });
+                auto ey = gather4(bounds + i, [](const Bounds& b) { return b.Extents.y; });
+                auto ez = gather4(bounds + i, [](const Bounds& b) { return b.Extents.z; });
+
+                auto inside = _mm_cmpeq_ps(zero, zero);
+                for (const auto& plane : planes) {
+                    auto distance = _mm_add_ps(
+                        _mm_add_ps(
+                            _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), cx), _mm_mul_ps(_mm_set1_ps(plane.y), cy)),
+                            _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), cz), _mm_set1_ps(plane.w))
+                        ),
+                        _mm_add_ps(
+                            _mm_add_ps(
+                                _mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), ex), _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), ey)
+                            ),
+                            _mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), ez)
+                        )
+                    );
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, zero));
+                }
+
+                auto mask = _mm_movemask_ps(inside);
+                for (int lane = 0; lane < 4; ++lane)
+                    visible[i + lane] = (uint8_t) ((mask >> lane) & 1);
+            }
+            return i;
+        }
+
+#endif
+    }
+
+    Frustum::Frustum(const float4x4& viewProjection) {
+        // Gribb & Hartmann: Every plane is the sum or difference of the fourth row and one of the other rows
+        const auto row = [&viewProjection](int index) {
+            return float4(viewProjection[0][index], viewProjection[1][index], viewProjection[2][index], viewProjection[3][index]);
+        };
+
+        _planes = {
+            row(3) + row(0), row(3) - row(0),
+            row(3) + row(1), row(3) - row(1),
+            row(3) + row(2), row(3) - row(2)
+        };
+
+        for (auto& plane : _planes)
+            plane /= glm::length(float3(plane));
+    }
+
+    bool Frustum::Intersects(const Bounds& bounds) const {
+        for (const auto& plane : _planes)
+            if (furthestDistanceTo(plane, bounds) < 0)
+                return false;
+        return true;
+    }
+
+    size_t Frustum::Cull(const WorldBoundsData* bounds, size_t count, uint8_t* visible) const {
+        size_t tested = 0;
+#ifdef MODU_FRUSTUM_KERNEL_SSE
+        tested = cullSSE(_planes, bounds, count, visible);
+#endif
+        for (auto i = tested; i < count; ++i)
+            visible[i] = Intersects(bounds[i].Value) ? 1 : 0;
+
+        size_t visibleCount = 0;
+        for (size_t i = 0; i < count; ++i)
+            visibleCount += visible[i];
+        return visibleCount;
+    }
+}
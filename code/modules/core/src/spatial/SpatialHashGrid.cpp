@@ -0,0 +1,111 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "spatial/SpatialHashGrid.h"
+#include <numeric>
+
+namespace modulith {
+
+    SpatialHashGrid::SpatialHashGrid(float cellSize) {
+        Reset(cellSize);
+    }
+
+    void SpatialHashGrid::Reset(float cellSize) {
+        CoreAssert(cellSize > 0, "The cell size of a spatial hash grid must be positive, but is {0}", cellSize)
+        _cellSize = cellSize;
+        _inverseCellSize = 1.0f / cellSize;
+        Clear();
+    }
+
+    void SpatialHashGrid::Clear() {
+        _entries.clear();
+        _keys.clear();
+        _cells.clear();
+        _isBuilt = true;
+    }
+
+    void SpatialHashGrid::Insert(Entity entity, const float3& position) {
+        _entries.push_back({entity, position});
+        _keys.push_back(keyOf(cellOf(position)));
+        _isBuilt = false;
+    }
+
+    void SpatialHashGrid::Build() {
+        auto order = std::vector<uint32_t>(_entries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [this](uint32_t lhs, uint32_t rhs) { return _keys[lhs] < _keys[rhs]; });
+
+        auto sortedEntries = std::vector<Entry>();
+        auto sortedKeys = std::vector<uint64_t>();
+        sortedEntries.reserve(_entries.size());
+        sortedKeys.reserve(_keys.size());
+        for (auto index : order) {
+            sortedEntries.push_back(_entries[index]);
+            sortedKeys.push_back(_keys[index]);
+        }
+        _entries = std::move(sortedEntries);
+        _keys = std::move(sortedKeys);
+
+        // Entries of the same cell are adjacent now, so every cell only stores its range
+        _cells.clear();
+        for (uint32_t begin = 0; begin < _keys.size();) {
+            auto end = begin + 1;
+            while (end < _keys.size() && _keys[end] == _keys[begin])
+                ++end;
+            _cells.emplace(_keys[begin], CellRange{begin, end, cellOf(_entries[begin].Position)});
+            begin = end;
+        }
+
+        _isBuilt = true;
+    }
+
+    std::vector<Entity> SpatialHashGrid::FindNearest(const float3& center, size_t count, float maxRadius) const {
+        auto candidates = std::vector<std::pair<float, Entity>>();
+        if (count == 0)
+            return {};
+
+        // Grow the searched radius until it contains enough entities.
+        // All entities inside the radius are found, so the closest of them are the closest overall.
+        auto radius = std::min(_cellSize, maxRadius);
+        while (true) {
+            candidates.clear();
+            QueryRadius(
+                center, radius, [&candidates, &center](Entity entity, const float3& position) {
+                    auto offset = position - center;
+                    candidates.emplace_back(glm::dot(offset, offset), entity);
+                }
+            );
+            if (candidates.size() >= count || radius >= maxRadius || candidates.size() == _entries.size())
+                break;
+            radius = std::min(radius * 2.0f, maxRadius);
+        }
+
+        count = std::min(count, candidates.size());
+        std::partial_sort(
+            candidates.begin(), candidates.begin() + count, candidates.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.first < rhs.first;
+            }
+        );
+
+        auto nearest = std::vector<Entity>();
+        nearest.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            nearest.push_back(candidates[i].second);
+        return nearest;
+    }
+
+    int3 SpatialHashGrid::cellOf(const float3& position) const {
+        return int3(
+            (int) std::floor(position.x * _inverseCellSize),
+            (int) std::floor(position.y * _inverseCellSize),
+            (int) std::floor(position.z * _inverseCellSize)
+        );
+    }
+
+    uint64_t SpatialHashGrid::keyOf(const int3& cell) {
+        const uint64_t mask = (1u << 21u) - 1u;
+        return ((uint64_t) cell.x & mask) | (((uint64_t) cell.y & mask) << 21u) | (((uint64_t) cell.z & mask) << 42u);
+    }
+}
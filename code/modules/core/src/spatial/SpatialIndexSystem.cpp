@@ -0,0 +1,28 @@
+/**
+ * \brief
+ * \author Daniel Götz
+ */
+
+#include "spatial/SpatialIndexSystem.h"
+#include "spatial/SpatialContext.h"
+#include "ecs/ECSContext.h"
+#include "ecs/transform/TransformComponents.h"
+#include "Context.h"
+
+namespace modulith {
+
+    void SpatialIndexSystem::OnUpdate(float deltaTime) {
+        auto ecs = Context::GetInstance<ECSContext>()->GetEntityManager();
+        auto index = Context::GetInstance<SpatialContext>()->GetIndex();
+
+        index->Clear();
+        ecs->QueryActiveChunks(
+            Each<const GlobalTransformData, const SpatiallyIndexedTag>(),
+            [&index](const Entity* entities, const GlobalTransformData* transforms, const SpatiallyIndexedTag* _, size_t count) {
+                for (size_t i = 0; i < count; ++i)
+                    index->Insert(entities[i], transforms[i].Position());
+            }
+        );
+        index->Build();
+    }
+}
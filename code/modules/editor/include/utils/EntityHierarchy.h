@@ -24,11 +24,9 @@ namespace modulith::editor {
 
     protected:
         std::vector<Entity> expand(Entity item, HierarchyData data) override {
-            if (auto* withChildren = item.Get<WithChildrenData>(data.ECS)){
-                auto entities = std::set<Entity, SortEntitiesById>();
-                entities.insert(withChildren->Values.begin(), withChildren->Values.end());
-                return std::vector<Entity>(entities.begin(), entities.end());
-            }
+            // The children are already sorted by their id
+            if (auto* withChildren = item.Get<const WithChildrenData>(data.ECS))
+                return withChildren->Values;
             return std::vector<Entity>();
         }
 
@@ -189,6 +189,7 @@ namespace modulith::editor {
                                     if(auto deserialized = serializable.value()->TryDeserialize(serializedObjectAfterDraw.value())){
                                         asAny = *deserialized;
                                         componentInfo.CopyFromAnyToPointer(asAny, chunk->GetComponentPtr(entity, identifier));
+                                        chunk->MarkChanged(identifier, ecs->GetChangeVersion());
                                     }else{
                                         LogWarn("Could not deserialize back into {}", identifier.get().name())
                                     }
@@ -154,6 +154,7 @@ private:
     OverallGameState _currentOverallState{};
 
     modulith::shared<modulith::Shader> _enemyShader;
+    modulith::shared<modulith::Material> _enemyMaterial;
 
     modulith::shared<modulith::Mesh> _enemyMesh;
 };
\ No newline at end of file
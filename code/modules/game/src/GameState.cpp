@@ -12,6 +12,8 @@
 #include "ecs/StrategyCameraController.h"
 #include "RenderComponents.h"
 #include "renderer/RenderContext.h"
+#include <spatial/SpatialContext.h>
+#include <spatial/SpatialIndexSystem.h>
 
 using namespace modulith;
 using namespace modulith::renderer;
@@ -30,7 +32,8 @@ void GameState::OnInitialize() {
 
     auto renderCtx = ctx.Get<RenderContext>();
     _enemyShader = renderCtx->Shaders()->Load(Address() / "shaders" / "PhongShader.glsl");
-    _enemyMesh = ModelLoaderUtils::LoadSingleFromFile(Address() / "ghost" / "ghost.obj");
+    _enemyMaterial = std::make_shared<StandardMaterial>(_enemyShader, float4(1.0f), 0.6f, 32);
+    _enemyMesh = ModelLoaderUtils::LoadSingleFromFile(Address() / "ghost" / "ghost.obj", {3, VertexFormat::Compact});
 
 }
 
@@ -165,18 +168,29 @@ void GameState::OnUpdate(float deltaTime) {
         }
     }else if(_currentOverallState == OverallGameState::InGameInWave){
         int enemyCount = 0;
-        auto enemyPositions = std::vector<float3>();
-        ecs->QueryActive(Each<GlobalTransformData, EnemyTag>(), [&enemyCount, &enemyPositions](auto e, auto& transform, auto& _){
-            enemyPositions.push_back(transform.Position());
-            enemyCount += 1;
+        ecs->QueryActiveChunks(Each<const GlobalTransformData, const EnemyTag>(), [&enemyCount](auto* entities, auto* transforms, auto* _, size_t count){
+            enemyCount += (int) count;
         });
 
-        for(auto pos : enemyPositions){
-            auto distance = glm::distance(pos, float3(0,0,0));
+        const auto damageClocktower = [deltaTime, this](const float3& enemyPosition){
+            auto distance = glm::distance(enemyPosition, float3(0,0,0));
             if(distance < enemiesDamageClocktowerBelowRange){
                 _currentClocktowerHealth -= (distance  / enemiesDamageClocktowerBelowRange) * deltaTime * enemyDamageFactor;
             }
-        }
+        };
+
+        // Only the enemies near the clocktower are visited. The index is built from the global transforms in the TransformSystemsGroup,
+        // so it has the same positions a query would read. Enemies spawned since its last update are only contained after the next one
+        auto index = Context::GetInstance<SpatialContext>()->GetIndex();
+        index->QueryRadius(float3(0,0,0), enemiesDamageClocktowerBelowRange, [&ecs, &damageClocktower](Entity entity, const float3& position){
+            if(ecs->IsAlive(entity) && entity.Has<EnemyTag>(ecs))
+                damageClocktower(position);
+        });
+
+        // Enemies without a SpatiallyIndexedTag are not in the index
+        ecs->QueryActive(Each<const GlobalTransformData, const EnemyTag>(), None<SpatiallyIndexedTag>(), [&damageClocktower](auto e, auto& transform, auto& _){
+            damageClocktower(transform.Position());
+        });
 
         _remainingEnemies = enemyCount;
 
@@ -208,6 +222,7 @@ modulith::Entity GameState::spawnEnemy(
         PositionData(position + float3(0, 0, 0)),
         std::move(rotation),
         EnemyTag(),
+        SpatiallyIndexedTag(),
         ControlledByEffectsData{properties.LureSpeed, properties.FearSpeed},
         CharacterControllerData(radius, height - 2 * radius),
         PhysicsContactsData(),
@@ -219,7 +234,8 @@ modulith::Entity GameState::spawnEnemy(
 
     auto enemyModel = ecs->CreateEntityWith(
         NameData("Model"),
-        RenderMeshData(_enemyMesh, std::make_shared<StandardMaterial>(_enemyShader, float4(properties.Color, 1.0f), 0.6f, 32)),
+        // All enemies are instances of the same material, so they are drawn in a single batch
+        RenderMeshData(_enemyMesh, std::make_shared<MaterialInstance>(_enemyMaterial, float4(properties.Color, 1.0f))),
         WithParentData(enemy)
     );
 
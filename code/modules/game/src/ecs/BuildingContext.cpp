@@ -16,6 +16,8 @@
 #include "Raycast.h"
 #include "RenderUtils.h"
 #include "renderer/RenderContext.h"
+#include <spatial/SpatialContext.h>
+#include <spatial/SpatialIndexSystem.h>
 
 
 using namespace modulith;
@@ -112,8 +114,8 @@ void BuildingContext::OnInitialize() {
 
     createRangeIndicator(_lightBeam, lightBeamRadius);
 
-    _cachedLampPostModels = ModelLoaderUtils::LoadSceneFromFile(Address() / "lamp post" / "lamp post.obj");
-    _cachedLanternModels = ModelLoaderUtils::LoadSceneFromFile(Address() / "lantern" / "model.obj");
+    _cachedLampPostModels = ModelLoaderUtils::LoadSceneFromFile(Address() / "lamp post" / "lamp post.obj", {0, VertexFormat::Compact});
+    _cachedLanternModels = ModelLoaderUtils::LoadSceneFromFile(Address() / "lantern" / "model.obj", {0, VertexFormat::Compact});
 
     setTooltipBuildingSelection(_gameState);
 }
@@ -225,7 +227,7 @@ void BuildingContext::OnUpdate(float deltaTime) {
 
                 auto otherLampPostPositions = std::vector<float3>();
                 ecs->QueryActive(
-                    Each<LampPostData, GlobalTransformData>(),
+                    Each<const LampPostData, const GlobalTransformData>(),
                     [&otherLampPostPositions](auto e, auto& _, auto& transform) {
                         otherLampPostPositions.push_back(transform.Position());
                     }
@@ -285,22 +287,29 @@ void BuildingContext::OnUpdate(float deltaTime) {
     }
 
 
-    auto enemyPositions = std::vector<float3>();
+    // The index has the positions of the last update of the TransformSystemsGroup, like the GlobalTransformData
+    auto index = ctx.Get<SpatialContext>()->GetIndex();
 
+    // Enemies without a SpatiallyIndexedTag are not in the index
+    auto unindexedEnemyPositions = std::vector<float3>();
     ecs->QueryActive(
-        Each<GlobalTransformData, EnemyTag>(), [&enemyPositions](auto e, auto& transform, auto& _) {
-            enemyPositions.push_back(transform.Position());
+        Each<const GlobalTransformData, const EnemyTag>(), None<SpatiallyIndexedTag>(),
+        [&unindexedEnemyPositions](auto e, auto& transform, auto& _) {
+            unindexedEnemyPositions.push_back(transform.Position());
         }
     );
 
     ecs->QueryActive(
-        Each<LampPostData, GlobalTransformData>(),
-        [&ecs, &ctx, &enemyPositions, this](auto e, auto& lamp, auto& transform) {
-            const auto anyEnemyInRadius = [&enemyPositions, &transform](auto radius) {
-                for (auto& enemyPos : enemyPositions)
-                    if (glm::distance(enemyPos, transform.Position()) <= radius)
-                        return true;
-                return false;
+        Each<LampPostData, const GlobalTransformData>(),
+        [&ecs, &ctx, &index, &unindexedEnemyPositions, this](auto e, auto& lamp, auto& transform) {
+            const auto anyEnemyInRadius = [&ecs, &index, &unindexedEnemyPositions, lampPosition = transform.Position()](auto radius) {
+                auto found = false;
+                index->QueryRadius(lampPosition, radius, [&ecs, &found](Entity entity, const float3& _) {
+                    found = found || (ecs->IsAlive(entity) && entity.Has<EnemyTag>(ecs));
+                });
+                for (auto& enemyPosition : unindexedEnemyPositions)
+                    found = found || glm::distance(enemyPosition, lampPosition) <= radius;
+                return found;
             };
 
             if (lamp.WasActivated) {
@@ -325,7 +334,7 @@ void BuildingContext::OnUpdate(float deltaTime) {
     );
 
     ecs->QueryActive(
-        Each<LanternData, GlobalTransformData>(), [ecs, deltaTime](auto e, auto& lantern, auto& transform) {
+        Each<LanternData, const GlobalTransformData>(), [ecs, deltaTime](auto e, auto& lantern, auto& transform) {
             lantern.ExplodeIn -= deltaTime;
             if (lantern.ExplodeIn <= 0) {
                 ecs->Defer(
@@ -33,16 +33,16 @@ void CommandSystem::updateMoveTo(float deltaTime) {
     // position, strength, walk towards
     auto effects = std::vector<EffectDescription>();
 
-    ecs->QueryActive(Each<GlobalTransformData, LureEffectData>(), [&effects](auto e, auto& transform, auto& lure){
+    ecs->QueryActive(Each<const GlobalTransformData, const LureEffectData>(), [&effects](auto e, auto& transform, auto& lure){
         effects.emplace_back(transform.Position(), lure.Strength, true);
     });
 
-    ecs->QueryActive(Each<GlobalTransformData, FearEffectData>(), [&effects](auto e, auto& transform, auto& fear){
+    ecs->QueryActive(Each<const GlobalTransformData, const FearEffectData>(), [&effects](auto e, auto& transform, auto& fear){
         effects.emplace_back(transform.Position(), fear.Strength, false);
     });
 
     ecs->QueryActive(
-        Each<ControlledByEffectsData, GlobalTransformData>(),
+        Each<ControlledByEffectsData, const GlobalTransformData>(),
         Any<ControlledByEffectsData, MoveToData, LookAtData>(), None<>(),
         [&effects, &ecs](
             auto e, auto& data, auto& transform, auto* _, auto* moveTo, auto* lookAt
@@ -51,10 +51,11 @@ void CommandSystem::updateMoveTo(float deltaTime) {
                 if (moveTo != nullptr) e.template RemoveDeferred<MoveToData>(ecs);
                 if (lookAt != nullptr) e.template RemoveDeferred<LookAtData>(ecs);
             } else {
+                auto position = transform.Position();
                 auto strongestEffect = std::max_element(
-                    effects.begin(), effects.end(), [&transform](auto lhs, auto rhs) {
-                        const auto calculateLocalThreatOf = [&transform](auto effect) {
-                            auto distance = glm::distance(transform.Position(), effect.Position);
+                    effects.begin(), effects.end(), [position](const auto& lhs, const auto& rhs) {
+                        const auto calculateLocalThreatOf = [position](const auto& effect) {
+                            auto distance = glm::distance(position, effect.Position);
                             return effect.Strength / distance;
                         };
                         return calculateLocalThreatOf(lhs) < calculateLocalThreatOf(rhs);
@@ -62,8 +63,8 @@ void CommandSystem::updateMoveTo(float deltaTime) {
                 );
                 Assert(strongestEffect != effects.end(), "There must be an effect")
 
-                auto destination = strongestEffect->WalkTowards ? strongestEffect->Position : transform.Position() + (
-                    transform.Position() - strongestEffect->Position
+                auto destination = strongestEffect->WalkTowards ? strongestEffect->Position : position + (
+                    position - strongestEffect->Position
                 );
                 auto speed = strongestEffect->WalkTowards ? data.LuredSpeed : data.FearedSpeed;
 
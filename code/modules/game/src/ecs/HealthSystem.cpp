@@ -10,6 +10,8 @@
 #include "PhysicsComponents.h"
 #include "ecs/building/BuildingComponents.h"
 #include "GameState.h"
+#include <spatial/SpatialContext.h>
+#include <spatial/SpatialIndexSystem.h>
 
 using namespace modulith;
 using namespace modulith::physics;
@@ -43,22 +45,44 @@ void HealthSystem::OnUpdate(float deltaTime) {
 
     auto damageSourcePositionPairs = std::vector<std::tuple<float, float, float3>>();
 
-    ecs->QueryActive(Each<DamageNearbyEnemiesData, GlobalTransformData>(), [deltaTime, &damageSourcePositionPairs](auto e, auto& damageSource, auto& transform){
+    ecs->QueryActive(Each<const DamageNearbyEnemiesData, const GlobalTransformData>(), [deltaTime, &damageSourcePositionPairs](auto e, auto& damageSource, auto& transform){
         damageSourcePositionPairs.emplace_back(damageSource.Radius, damageSource.DamagePerSecond * deltaTime, transform.Position());
     });
 
-    ecs->QueryActive(Each<ExplodeData, GlobalTransformData>(), [ecs, &damageSourcePositionPairs](auto e, auto& explode, auto& transform){
+    ecs->QueryActive(Each<const ExplodeData, const GlobalTransformData>(), [ecs, &damageSourcePositionPairs](auto e, auto& explode, auto& transform){
         damageSourcePositionPairs.emplace_back(explode.Radius, explode.Damage, transform.Position());
         e.DestroyDeferred(ecs);
     });
 
-    ecs->QueryActive(Each<HealthData, GlobalTransformData, EnemyTag>(), [&damageSourcePositionPairs, deltaTime](auto e, auto& health, auto& transform, auto& _){
-       auto damageSum = 0.0f;
-       for(auto pair : damageSourcePositionPairs){
-           if(glm::distance(std::get<2>(pair), transform.Position()) <= std::get<0>(pair)){
-               damageSum += std::get<1>(pair);
-           }
-       }
-       health.Health -= damageSum;
+    if(damageSourcePositionPairs.empty())
+        return;
+
+    // Only the indexed entities within the radius of a damage source are visited, instead of every enemy.
+    // This system is in the LogicSystemsGroup, so the index was rebuilt from the global transforms of this frame
+    auto index = ctx.Get<SpatialContext>()->GetIndex();
+    for(const auto& [radius, damage, sourcePosition] : damageSourcePositionPairs){
+        index->QueryRadius(sourcePosition, radius, [&ecs, damage = damage](Entity entity, const float3& _){
+            if(!ecs->IsAlive(entity))
+                return;
+            auto [health, enemy] = ecs->GetComponents<HealthData, const EnemyTag>(entity);
+            if(health != nullptr && enemy != nullptr){
+                health->Health -= damage;
+            }
+        });
+    }
+
+    // Enemies without a SpatiallyIndexedTag are not in the index, so they are still tested against every damage source
+    ecs->QueryActiveChunks(Each<HealthData, const GlobalTransformData, const EnemyTag>(), None<SpatiallyIndexedTag>(), [&damageSourcePositionPairs](
+        const Entity* entities, HealthData* healths, const GlobalTransformData* transforms, const EnemyTag* _, size_t count
+    ){
+        for(const auto& [radius, damage, sourcePosition] : damageSourcePositionPairs){
+            auto radiusSquared = radius * radius;
+            for(size_t i = 0; i < count; ++i){
+                auto offset = transforms[i].Position() - sourcePosition;
+                if(glm::dot(offset, offset) <= radiusSquared){
+                    healths[i].Health -= damage;
+                }
+            }
+        }
     });
 }
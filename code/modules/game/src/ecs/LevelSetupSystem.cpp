@@ -27,8 +27,8 @@ void LevelSetupSystem::OnInitialize() {
 
     // Models
 
-    _gravestoneModels = ModelLoaderUtils::LoadSceneFromFile(Address() / "gravestone" / "gravestone.obj");
-    _deadTree = ModelLoaderUtils::LoadSceneFromFile(Address() / "dead tree" / "tree.obj");
+    _gravestoneModels = ModelLoaderUtils::LoadSceneFromFile(Address() / "gravestone" / "gravestone.obj", {2, VertexFormat::Compact});
+    _deadTree = ModelLoaderUtils::LoadSceneFromFile(Address() / "dead tree" / "tree.obj", {3, VertexFormat::Compact});
 
     // Clocktower
 
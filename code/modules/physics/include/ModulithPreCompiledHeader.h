@@ -49,6 +49,7 @@
 // Rendering
 #include <renderer/Mesh.h>
 #include <renderer/StandardMaterial.h>
+#include <renderer/MaterialInstance.h>
 #include <renderer/Material.h>
 #include <renderer/primitives/Shader.h>
 #include <renderer/primitives/Texture.h>
@@ -294,12 +294,20 @@ namespace modulith::physics{
 
     void PhysXSystem::updateTransforms(const ref<EntityManager>& ecs) {
 
+        // Dynamic bodies keep their inverse transform, so it does not need to be inverted every frame
+        ecs->QueryAll(
+            Each<const PxRigidDynamicData, const GlobalTransformData>(), None<InverseGlobalTransformData>(),
+            [ecs](auto entity, auto& pxRigidBody, auto& globalTransform) {
+                entity.AddDeferred(ecs, InverseGlobalTransformData(glm::affineInverse(globalTransform.Value)));
+            }
+        );
+
         ecs->QueryActive(
-            Each<PxRigidDynamicData, GlobalTransformData, LocalTransformData>(),
-            Any<PositionData, RotationData>(), None(),
+            Each<PxRigidDynamicData, const GlobalTransformData, const LocalTransformData>(),
+            Any<PositionData, RotationData, const InverseGlobalTransformData>(), None(),
             [](
                 auto entity, PxRigidDynamicData& pxRigidBody, auto& globalTransform, auto& localTransform,
-                auto* position, auto* rotation
+                auto* position, auto* rotation, auto* inverseGlobalTransform
             ) {
 
                 auto currTransform = pxRigidBody.GetRigidBody()->getGlobalPose();
@@ -310,8 +318,11 @@ namespace modulith::physics{
 
                 auto newWorldSpaceTransform =
                     glm::translate(glm::identity<float4x4>(), currGPosition) * glm::mat4_cast(currGRotation);
-                auto localToGlobal = globalTransform.Value * glm::inverse(localTransform.Value);
-                auto globalToLocal = glm::inverse(localToGlobal);
+                // The inverse of the parent's global transform: inverse(global * inverse(local)) = local * inverse(global)
+                // New bodies only get their cached inverse at the end of this frame
+                auto globalToLocal = localTransform.Value * (
+                    inverseGlobalTransform != nullptr ? inverseGlobalTransform->Value : glm::affineInverse(globalTransform.Value)
+                );
                 auto newLocalSpaceTransform = globalToLocal * newWorldSpaceTransform;
 
                 if (position != nullptr)
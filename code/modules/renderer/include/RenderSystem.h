@@ -8,6 +8,7 @@
 #include "RendererModule.h"
 #include "RenderComponents.h"
 #include "renderer/Renderer.h"
+#include "renderer/RenderCommandList.h"
 
 namespace modulith::renderer{
 
@@ -19,6 +20,11 @@ namespace modulith::renderer{
         uint32_t ActiveDirectionalLights = 0;
         uint32_t ActivePointLights = 0;
 
+        /**
+         * The amount of rendered objects that were not submitted, because they were outside of a camera's view
+         */
+        uint32_t CulledObjects = 0;
+
         Renderer::SceneStats CombinedSceneStats{};
     };
 
@@ -50,6 +56,9 @@ namespace modulith::renderer{
 
         std::optional<RenderStats> _lastRenderStats;
 
+        // One list per camera, kept between frames so their memory is reused
+        std::vector<modulith::RenderCommandList> _commandLists{};
+
         modulith::shared<modulith::Material> _fallbackMaterial;
     };
 
@@ -7,6 +7,8 @@
 #include <RenderSystem.h>
 #include <RenderComponents.h>
 #include "renderer/RenderContext.h"
+#include "spatial/Frustum.h"
+#include "renderer/RenderCommandList.h"
 
 namespace modulith::renderer {
 
@@ -28,10 +30,37 @@ namespace modulith::renderer {
 
         auto stats = RenderStats();
 
+        // Rendered objects keep their inverse transform, so the renderer does not need to invert it for every draw
+        ecs->QueryAll(
+            Each<const RenderMeshData, const GlobalTransformData>(), None<InverseGlobalTransformData>(),
+            [ecs](auto entity, auto& renderMesh, auto& transform) {
+                entity.AddDeferred(ecs, InverseGlobalTransformData(glm::affineInverse(transform.Value)));
+            }
+        );
+
+        // Rendered objects get the bounds of their mesh, which are transformed into world space with their transform
+        ecs->QueryAll(
+            Each<const RenderMeshData, const GlobalTransformData>(), None<LocalBoundsData>(),
+            [ecs](auto entity, auto& renderMesh, auto& transform) {
+                const auto& localBounds = renderMesh.Mesh->LocalBounds();
+                entity.AddDeferred(ecs, LocalBoundsData(localBounds));
+                entity.AddDeferred(ecs, WorldBoundsData(localBounds.TransformedBy(transform.Value)));
+            }
+        );
+
+        // The mesh of an object may be exchanged, so the bounds of chunks whose meshes were written to are refreshed
+        ecs->QueryAll(
+            Each<const RenderMeshData, const GlobalTransformData, LocalBoundsData, WorldBoundsData>(), Changed<RenderMeshData>(),
+            [](auto entity, auto& renderMesh, auto& transform, auto& localBounds, auto& worldBounds) {
+                localBounds.Value = renderMesh.Mesh->LocalBounds();
+                worldBounds.Value = localBounds.Value.TransformedBy(transform.Value);
+            }
+        );
+
         auto directionalLight = std::optional<Renderer::DirectionalLight>();
         ecs->QueryActive(
-            Each<DirectionalLightData, GlobalTransformData>(),
-            [&directionalLight, &stats](auto entity, DirectionalLightData& light, auto& transform) {
+            Each<const DirectionalLightData, const GlobalTransformData>(),
+            [&directionalLight, &stats](auto entity, const DirectionalLightData& light, auto& transform) {
                 directionalLight = Renderer::DirectionalLight(transform.Forward(), light.Color, light.AmbientFactor);
                 stats.ActiveDirectionalLights += 1;
             }
@@ -39,58 +68,101 @@ namespace modulith::renderer {
 
         auto pointLights = std::vector<Renderer::PointLight>();
         ecs->QueryActive(
-            Each<PointLightData, GlobalTransformData>(), [&pointLights, &stats](auto entity, PointLightData& light, auto& transform) {
+            Each<const PointLightData, const GlobalTransformData>(), [&pointLights, &stats](auto entity, const PointLightData& light, auto& transform) {
                 pointLights.emplace_back(transform.Position(), light.Color, light.Range);
                 stats.ActivePointLights += 1;
             }
         );
 
 
+        // The command lists of all cameras are built first, without calling the renderer API.
+        // Only afterwards they are executed, so building and drawing are independent of each other.
+        auto commandListCount = size_t(0);
         ecs->QueryActive(
-            Each<CameraData, GlobalTransformData>(),
-            [this, ecs, &ctx, &stats, &directionalLight, &pointLights, &renderCtx](
-                auto entity, CameraData& camera, GlobalTransformData& transform
+            Each<CameraData, const GlobalTransformData>(),
+            [this, ecs, &ctx, &stats, &directionalLight, &pointLights, &renderCtx, &commandListCount](
+                auto entity, CameraData& camera, const GlobalTransformData& transform
             ) {
                 auto renderSize = renderCtx->GetWindow()->GetSize();
                 camera.SetWidthAndHeight(renderSize);
 
                 stats.ActiveCameras += 1;
 
-                ctx.GetProfiler().BeginMeasurement("Rendering: Begin & Init Scene");
-                renderCtx->GetRenderer()->BeginScene(
-                    camera.ProjectionMatrix, glm::inverse(transform.UnscaledTransform()), transform.Position(),
-                    directionalLight, pointLights
-                );
+                ctx.GetProfiler().BeginMeasurement("Rendering: Begin Command List");
+                if(commandListCount == _commandLists.size())
+                    _commandLists.emplace_back();
+                auto& commandList = _commandLists[commandListCount++];
+
+                auto viewMatrix = glm::affineInverse(transform.UnscaledTransform());
+                commandList.Begin(camera.ProjectionMatrix, viewMatrix, transform.Position(), directionalLight, pointLights);
 
 
                 ctx.GetProfiler().EndMeasurement();
                 ctx.GetProfiler().BeginMeasurement("Rendering: Submit Rendered Objects");
 
-                ecs->QueryActive(
-                    Each<RenderMeshData, GlobalTransformData>(),
-                    [this, cameraPosition = transform.Position(), &ctx, &renderCtx](
-                        auto entity, RenderMeshData& renderMesh, GlobalTransformData& transform
+                const auto submit = [this, &commandList](
+                    const RenderMeshData& renderMesh, const GlobalTransformData& transform,
+                    const InverseGlobalTransformData* inverseTransform
+                ) {
+                    auto& material = renderMesh.Material != nullptr ? renderMesh.Material : _fallbackMaterial;
+
+                    // New objects only get their cached inverse at the end of this frame
+                    commandList.SubmitDeferred(
+                        material,
+                        renderMesh.Mesh,
+                        transform.Value,
+                        inverseTransform != nullptr ? inverseTransform->Value : glm::affineInverse(transform.Value)
+                    );
+                };
+
+                // Objects are culled chunk by chunk, testing the contiguous world bounds against the camera's frustum
+                auto frustum = Frustum(camera.ProjectionMatrix * viewMatrix);
+                auto visible = std::vector<uint8_t>();
+                ecs->QueryActiveChunks(
+                    Each<const RenderMeshData, const GlobalTransformData, const WorldBoundsData>(),
+                    Any<const InverseGlobalTransformData>(), None(),
+                    [&frustum, &visible, &stats, &submit](
+                        const Entity* entities, const RenderMeshData* renderMeshes, const GlobalTransformData* transforms,
+                        const WorldBoundsData* worldBounds, const InverseGlobalTransformData* inverseTransforms, size_t count
                     ) {
-                        auto& material = renderMesh.Material != nullptr ? renderMesh.Material : _fallbackMaterial;
+                        visible.resize(count);
+                        stats.CulledObjects += (uint32_t) (count - frustum.Cull(worldBounds, count, visible.data()));
+
+                        for (size_t i = 0; i < count; ++i) {
+                            if (visible[i] != 0)
+                                submit(renderMeshes[i], transforms[i], inverseTransforms != nullptr ? inverseTransforms + i : nullptr);
+                        }
+                    }
+                );
 
-                        renderCtx->GetRenderer()->SubmitDeferred(
-                            material,
-                            renderMesh.Mesh,
-                            transform.Value
-                        );
+                // New objects only get their bounds at the end of this frame, so they cannot be culled yet
+                ecs->QueryActive(
+                    Each<const RenderMeshData, const GlobalTransformData>(),
+                    Any<const InverseGlobalTransformData>(), None<WorldBoundsData>(),
+                    [&submit](
+                        auto entity, const RenderMeshData& renderMesh, const GlobalTransformData& transform,
+                        const InverseGlobalTransformData* inverseTransform
+                    ) {
+                        submit(renderMesh, transform, inverseTransform);
                     }
                 );
 
                 ctx.GetProfiler().EndMeasurement();
-                ctx.GetProfiler().BeginMeasurement("Rendering: End Scene");
+                ctx.GetProfiler().BeginMeasurement("Rendering: Finish Command List");
 
-                auto sceneStats = renderCtx->GetRenderer()->EndScene();
-                stats.CombinedSceneStats = stats.CombinedSceneStats.CombineWith(sceneStats);
+                commandList.Finish();
 
                 ctx.GetProfiler().EndMeasurement();
             }
         );
 
+        ctx.GetProfiler().BeginMeasurement("Rendering: Execute Command Lists");
+        for(size_t i = 0; i < commandListCount; ++i){
+            auto sceneStats = renderCtx->GetRenderer()->Execute(_commandLists[i]);
+            stats.CombinedSceneStats = stats.CombinedSceneStats.CombineWith(sceneStats);
+        }
+        ctx.GetProfiler().EndMeasurement();
+
         _lastRenderStats = stats;
     }
 
@@ -101,6 +173,7 @@ namespace modulith::renderer {
             ImGui::Text("Active Cameras: %i", _lastRenderStats->ActiveCameras);
             ImGui::Text("Active Directional Lights: %i", _lastRenderStats->ActiveDirectionalLights);
             ImGui::Text("Active Point Lights: %i", _lastRenderStats->ActivePointLights);
+            ImGui::Text("Culled Objects: %u", _lastRenderStats->CulledObjects);
             ImGui::Spacing();
             ImGui::Text("Immediate Draw Calls: %u", _lastRenderStats->CombinedSceneStats.ImmediateSubmits);
             ImGui::Text("Deferred Draw Calls: %u", _lastRenderStats->CombinedSceneStats.DeferredSubmits);
@@ -108,9 +181,17 @@ namespace modulith::renderer {
             ImGui::Text("Material Batches: %u", _lastRenderStats->CombinedSceneStats.MaterialBatches);
             ImGui::Text("Vertex Array Batches: %u", _lastRenderStats->CombinedSceneStats.VertexArrayBatches);
             ImGui::Text("Batched Draw Calls: %u", _lastRenderStats->CombinedSceneStats.BatchedDrawCalls);
+            ImGui::Text("Instanced Draw Calls: %u", _lastRenderStats->CombinedSceneStats.InstancedDrawCalls);
             ImGui::Spacing();
             ImGui::Text("Vertices: %llu", _lastRenderStats->CombinedSceneStats.Vertices);
             ImGui::Text("Triangles: %llu", _lastRenderStats->CombinedSceneStats.Triangles);
+            ImGui::Text("Lod Draws: %u", _lastRenderStats->CombinedSceneStats.LodDraws);
+            ImGui::Spacing();
+            const auto& state = _lastRenderStats->CombinedSceneStats.StateChanges;
+            ImGui::Text("Program Binds: %u (%u skipped)", state.ProgramBinds, state.SkippedProgramBinds);
+            ImGui::Text("Vertex Array Binds: %u (%u skipped)", state.VertexArrayBinds, state.SkippedVertexArrayBinds);
+            ImGui::Text("Texture Binds: %u (%u skipped)", state.TextureBinds, state.SkippedTextureBinds);
+            ImGui::Text("Uniform Uploads: %u (%u skipped)", state.UniformUploads, state.SkippedUniformUploads);
         }
 
         ImGui::End();
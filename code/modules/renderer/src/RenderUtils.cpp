@@ -16,7 +16,7 @@ namespace modulith::renderer {
 
         for(auto& model : models){
             auto child = ecs->CreateEntityWith(PositionData(), RenderMeshData(model.Mesh, model.Material), WithParentData(root));
-            withChildren->Values.push_back(child);
+            withChildren->Add(child);
         }
 
     }
@@ -22,7 +22,7 @@ void GunSystem::instantiateBullet(ref<EntityManager> ecs, Entity gun, float forc
                 RotationData(bulletRotation),
                 RigidbodyData(0.1f, -gunTransform->Forward() * force)
             );
-            TransformUtils::UpdateTransformOf(ecs, bullet);
+            TransformUtils::MarkTransformDirty(ecs, bullet);
         }
     );
 }
@@ -79,6 +79,8 @@ void GunSystem::OnUpdate(float deltaTime) {
                 }
             }
         );
+        // The transforms of all bullets shot this frame are updated at once
+        TransformUtils::UpdateDirtyTransforms(ecs);
     }
 
     // AIMING